@@ -6,7 +6,7 @@
 static const char BLANK_PAGE_DATA[PAGE_SIZE] = {0};
 
 BufferPoolManager::BufferPoolManager(size_t buffer_size, DiskManager *disk_mgr)
-    : pool_size_(buffer_size), disk_manager_(disk_mgr) {
+    : pool_size_(buffer_size), disk_manager_(disk_mgr), loading_(buffer_size, false) {
   pages_ = new Page[pool_size_];
   replacer_ = new LRUReplacer(pool_size_);
   for (size_t i = 0; i < pool_size_; ++i) {
@@ -24,58 +24,43 @@ BufferPoolManager::~BufferPoolManager() {
 }
 
 Page *BufferPoolManager::FetchPage(page_id_t page_id) {
+  std::unique_lock<std::mutex> lock(latch_);
   // 从页表中查找请求的页面
-  if (page_table_.count(page_id) > 0) {
-    auto frame_id = page_table_[page_id];
+  auto it = page_table_.find(page_id);
+  if (it != page_table_.end()) {
+    auto frame_id = it->second;
     pages_[frame_id].pin_count_++; // 增加固定计数
     replacer_->Pin(frame_id); // 在替换器中固定该页面
+    // 其他线程可能仍在读入该页面
+    WaitLoaded(lock, frame_id);
     return &pages_[frame_id];
-  } else {
-    frame_id_t frame_to_use;
-    // 优先使用空闲列表中的页帧
-    if (!free_list_.empty()) {
-      frame_to_use = free_list_.front();
-      free_list_.pop_front();
-    } else {
-      // 如果没有空闲页帧，从替换器中选择一个页帧
-      if (replacer_->Victim(&frame_to_use)) {
-        if (pages_[frame_to_use].IsDirty()) {
-          disk_manager_->WritePage(pages_[frame_to_use].page_id_, pages_[frame_to_use].data_);
-        }
-        page_table_.erase(pages_[frame_to_use].page_id_);
-      } else {
-        return nullptr; // 如果替换器中也没有可用页帧，则返回空
-      }
-    }
+  }
 
-    // 更新页表，并将页面数据从磁盘读取到内存
-    page_table_[page_id] = frame_to_use;
-    pages_[frame_to_use].ResetMemory();
-    pages_[frame_to_use].page_id_ = page_id;
-    pages_[frame_to_use].is_dirty_ = false;
-    pages_[frame_to_use].pin_count_ = 1;
-    disk_manager_->ReadPage(page_id, pages_[frame_to_use].data_);
-    replacer_->Pin(frame_to_use); // 将新加载的页面固定
-    return &pages_[frame_to_use];
+  frame_id_t frame_to_use;
+  if (!TakeFrame(&frame_to_use)) {
+    return nullptr; // 如果替换器中也没有可用页帧，则返回空
   }
+  // 更新页表并固定页帧，读盘时不持有 latch_，同一页面的其他请求等待读入完成
+  page_table_[page_id] = frame_to_use;
+  pages_[frame_to_use].ResetMemory();
+  pages_[frame_to_use].page_id_ = page_id;
+  pages_[frame_to_use].is_dirty_ = false;
+  pages_[frame_to_use].pin_count_ = 1;
+  replacer_->Pin(frame_to_use); // 将新加载的页面固定
+  loading_[frame_to_use] = true;
+  lock.unlock();
+  disk_manager_->ReadPage(page_id, pages_[frame_to_use].data_);
+  lock.lock();
+  loading_[frame_to_use] = false;
+  loaded_.notify_all();
+  return &pages_[frame_to_use];
 }
 
 Page *BufferPoolManager::NewPage(page_id_t &new_page_id) {
+  std::scoped_lock<std::mutex> lock(latch_);
   frame_id_t frame_to_use;
-  // 优先从空闲列表中分配页帧
-  if (!free_list_.empty()) {
-    frame_to_use = free_list_.front();
-    free_list_.pop_front();
-  } else {
-    // 如果没有空闲页帧，从替换器中选择一个页帧
-    if (replacer_->Victim(&frame_to_use)) {
-      if (pages_[frame_to_use].IsDirty()) {
-        disk_manager_->WritePage(pages_[frame_to_use].page_id_, pages_[frame_to_use].data_);
-      }
-      page_table_.erase(pages_[frame_to_use].page_id_);
-    } else {
-      return nullptr; // 如果没有可用页帧，返回空
-    }
+  if (!TakeFrame(&frame_to_use)) {
+    return nullptr; // 如果没有可用页帧，返回空
   }
 
   // 分配新页面并更新页表和元数据
@@ -90,13 +75,15 @@ Page *BufferPoolManager::NewPage(page_id_t &new_page_id) {
 }
 
 bool BufferPoolManager::DeletePage(page_id_t page_id) {
-  // 如果请求删除的页面不存在，直接返回 true
+  std::scoped_lock<std::mutex> lock(latch_);
+  // 如果请求删除的页面不在缓冲池中，直接在磁盘上释放
   if (page_table_.count(page_id) == 0) {
+    DeallocatePage(page_id);
     return true;
   }
 
   auto frame_id = page_table_[page_id];
-  // 如果页面的固定计数大于零，不能删除
+  // 如果页面的固定计数大于零，不能删除，正在读入的页面也是固定的
   if (pages_[frame_id].pin_count_ > 0) {
     return false;
   }
@@ -112,12 +99,14 @@ bool BufferPoolManager::DeletePage(page_id_t page_id) {
 }
 
 bool BufferPoolManager::UnpinPage(page_id_t page_id, bool is_dirty) {
+  std::scoped_lock<std::mutex> lock(latch_);
   // 检查页面是否在页表中
-  if (page_table_.count(page_id) == 0) {
+  auto it = page_table_.find(page_id);
+  if (it == page_table_.end()) {
     return false;
   }
 
-  auto frame_id = page_table_[page_id];
+  auto frame_id = it->second;
   pages_[frame_id].is_dirty_ = is_dirty || pages_[frame_id].is_dirty_;
   if (--pages_[frame_id].pin_count_ == 0) {
     replacer_->Unpin(frame_id); // 当页面不再固定时，解锁它
@@ -126,29 +115,69 @@ bool BufferPoolManager::UnpinPage(page_id_t page_id, bool is_dirty) {
 }
 
 bool BufferPoolManager::FlushPage(page_id_t page_id) {
+  std::unique_lock<std::mutex> lock(latch_);
   // 确保页面在页表中存在
-  if (page_table_.count(page_id) == 0) {
+  auto it = page_table_.find(page_id);
+  if (it == page_table_.end()) {
     return false;
   }
 
-  auto frame_id = page_table_[page_id];
-  // 将页面写回磁盘
-  disk_manager_->WritePage(page_id, pages_[frame_id].data_);
-  pages_[frame_id].is_dirty_ = false;
+  auto frame_id = it->second;
+  WaitLoaded(lock, frame_id);
+  // 等待期间页面可能被换出
+  if (pages_[frame_id].page_id_ != page_id) {
+    return false;
+  }
+  FlushFrame(frame_id);
   return true;
 }
 
 bool BufferPoolManager::FlushAllPages() {
+  std::unique_lock<std::mutex> lock(latch_);
   bool success = true;
-  // 将所有有效的页面写回磁盘
+  // 将所有有效的页面写回磁盘，已删除页面的页帧不在页表中
   for (size_t i = 0; i < pool_size_; ++i) {
+    WaitLoaded(lock, i);
     if (pages_[i].page_id_ != INVALID_PAGE_ID) {
-      success = success && FlushPage(pages_[i].page_id_);
+      auto it = page_table_.find(pages_[i].page_id_);
+      if (it != page_table_.end() && it->second == static_cast<frame_id_t>(i)) {
+        FlushFrame(i);
+      } else {
+        success = false;
+      }
     }
   }
   return success;
 }
 
+bool BufferPoolManager::TakeFrame(frame_id_t *frame_id) {
+  // 优先使用空闲列表中的页帧
+  if (!free_list_.empty()) {
+    *frame_id = free_list_.front();
+    free_list_.pop_front();
+    return true;
+  }
+  // 如果没有空闲页帧，从替换器中选择一个页帧，脏页在持有 latch_ 时写回，换出的页面不会被提前读回
+  if (!replacer_->Victim(frame_id)) {
+    return false;
+  }
+  if (pages_[*frame_id].IsDirty()) {
+    disk_manager_->WritePage(pages_[*frame_id].page_id_, pages_[*frame_id].data_);
+  }
+  page_table_.erase(pages_[*frame_id].page_id_);
+  return true;
+}
+
+void BufferPoolManager::WaitLoaded(std::unique_lock<std::mutex> &lock, frame_id_t frame_id) {
+  loaded_.wait(lock, [this, frame_id] { return !loading_[frame_id]; });
+}
+
+void BufferPoolManager::FlushFrame(frame_id_t frame_id) {
+  // 将页面写回磁盘
+  disk_manager_->WritePage(pages_[frame_id].page_id_, pages_[frame_id].data_);
+  pages_[frame_id].is_dirty_ = false;
+}
+
 page_id_t BufferPoolManager::AllocatePage() {
   return disk_manager_->AllocatePage(); // 从磁盘管理器分配新页面
 }
@@ -158,11 +187,13 @@ void BufferPoolManager::DeallocatePage(page_id_t page_id) {
 }
 
 bool BufferPoolManager::IsPageFree(page_id_t page_id) {
+  std::scoped_lock<std::mutex> lock(latch_);
   return disk_manager_->IsPageFree(page_id); // 检查页面是否是空闲的
 }
 
 // 调试用，检查所有页面是否都未被固定
 bool BufferPoolManager::CheckAllUnpinned() {
+  std::scoped_lock<std::mutex> lock(latch_);
   bool all_unpinned = true;
   for (size_t i = 0; i < pool_size_; ++i) {
     if (pages_[i].pin_count_ != 0) {
@@ -106,6 +106,8 @@ CatalogManager::CatalogManager(BufferPoolManager *buffer_pool_manager, LockManag
 
 // CatalogManager destructor, ensures metadata is flushed and cleans up resources
 CatalogManager::~CatalogManager() {
+  // pending frees and auto-vacuums still use the tables and indexes
+  reclaimer_.Drain();
   FlushCatalogMetaPage();
   delete catalog_meta_;
   for (const auto& table_pair : tables_) {
@@ -117,13 +119,22 @@ CatalogManager::~CatalogManager() {
 }
 
 // Create a new table in the catalog
-dberr_t CatalogManager::CreateTable(const std::string &table_name, TableSchema *schema, Txn *txn, TableInfo *&table_info) {
+dberr_t CatalogManager::CreateTable(const std::string &table_name, TableSchema *schema, Txn *txn,
+                                    TableInfo *&table_info, TableLayout layout) {
   if (table_names_.count(table_name)) return DB_TABLE_ALREADY_EXIST;
+  if (!TableHeap::SupportsLayout(schema, layout)) return DB_FAILED;
+  for (auto column : schema->GetColumns()) {
+    if (column->IsDictionary() && !Dictionary::CanEncode(column)) return DB_FAILED;
+  }
 
   table_info = TableInfo::Create();
   auto schema_copy = Schema::DeepCopySchema(schema);
-  TableHeap *table_heap = TableHeap::Create(buffer_pool_manager_, schema_copy, txn, log_manager_, lock_manager_);
-  TableMetadata *table_metadata = TableMetadata::Create(next_table_id_++, table_name, table_heap->GetFirstPageId(), schema_copy);
+  TableHeap *table_heap =
+      TableHeap::Create(buffer_pool_manager_, schema_copy, txn, log_manager_, lock_manager_, layout);
+  TableMetadata *table_metadata = TableMetadata::Create(next_table_id_++, table_name, table_heap->GetFirstPageId(),
+                                                        table_heap->GetFsmPageId(),
+                                                        table_heap->GetDictionaryPageId(),
+                                                        table_heap->GetZoneMapPageId(), schema_copy);
   table_info->Init(table_metadata, table_heap);
 
   table_names_[table_name] = next_table_id_ - 1;
@@ -142,6 +153,7 @@ dberr_t CatalogManager::CreateTable(const std::string &table_name, TableSchema *
 
 // Retrieve table information by table name
 dberr_t CatalogManager::GetTable(const std::string &table_name, TableInfo *&table_info) {
+  WaitForVacuum(table_name);
   if (!table_names_.count(table_name)) return DB_TABLE_NOT_EXIST;
   return GetTable(table_names_.at(table_name), table_info);
 }
@@ -158,6 +170,7 @@ dberr_t CatalogManager::GetTables(std::vector<TableInfo *> &tables) const {
 dberr_t CatalogManager::CreateIndex(const std::string &table_name, const std::string &index_name,
                                     const std::vector<std::string> &index_keys, Txn *txn, IndexInfo *&index_info,
                                     const std::string &index_type) {
+  WaitForVacuum(table_name);
   if (!table_names_.count(table_name)) return DB_TABLE_NOT_EXIST;
   if (index_names_[table_name].count(index_name)) return DB_INDEX_ALREADY_EXIST;
 
@@ -185,12 +198,15 @@ dberr_t CatalogManager::CreateIndex(const std::string &table_name, const std::st
 
   buffer_pool_manager_->UnpinPage(page_id, true);
 
-  for (auto it = tables_.at(table_names_.at(table_name))->GetTableHeap()->Begin(txn);
-       it != tables_.at(table_names_.at(table_name))->GetTableHeap()->End(); ++it) {
-    Row row = *it;
-    Row key_row;
-    row.GetKeyFromRow(tables_.at(table_names_.at(table_name))->GetSchema(), index_info->GetIndexKeySchema(), key_row);
-    index_info->GetIndex()->InsertEntry(key_row, row.GetRowId(), txn);
+  TableInfo *table_info = tables_.at(table_names_.at(table_name));
+  page_id_t cursor = table_info->GetTableHeap()->GetFirstPageId();
+  RowBatch batch;
+  while (table_info->GetTableHeap()->ScanBatch(cursor, batch, txn)) {
+    for (size_t i = 0; i < batch.Size(); i++) {
+      Row key_row;
+      batch[i].GetKeyFromRow(table_info->GetSchema(), index_info->GetIndexKeySchema(), key_row);
+      index_info->GetIndex()->InsertEntry(key_row, batch[i].GetRowId(), txn);
+    }
   }
 
   FlushCatalogMetaPage();
@@ -199,6 +215,7 @@ dberr_t CatalogManager::CreateIndex(const std::string &table_name, const std::st
 
 // Retrieve index information by table and index names
 dberr_t CatalogManager::GetIndex(const std::string &table_name, const std::string &index_name, IndexInfo *&index_info) const {
+  WaitForVacuum(table_name);
   if (!table_names_.count(table_name)) return DB_TABLE_NOT_EXIST;
   if (!index_names_.count(table_name) || !index_names_.at(table_name).count(index_name)) return DB_INDEX_NOT_FOUND;
 
@@ -210,6 +227,7 @@ dberr_t CatalogManager::GetIndex(const std::string &table_name, const std::strin
  * TODO: Student Implement
  */
 dberr_t CatalogManager::GetTableIndexes(const std::string &table_name, std::vector<IndexInfo *> &indexes) const {
+  WaitForVacuum(table_name);
   if(table_names_.find(table_name) == table_names_.end())
     return DB_TABLE_NOT_EXIST;
   if(index_names_.find(table_name) != index_names_.end())
@@ -224,9 +242,12 @@ dberr_t CatalogManager::GetTableIndexes(const std::string &table_name, std::vect
 dberr_t CatalogManager::DropTable(const string &table_name) {
   if(table_names_.find(table_name) == table_names_.end())
     return DB_TABLE_NOT_EXIST;
+  // pending frees of a truncate still use the indexes of the table
+  reclaimer_.Drain();
   table_id_t table_id = table_names_[table_name];
   if(!buffer_pool_manager_->DeletePage(tables_[table_id]->GetRootPageId())||!buffer_pool_manager_->DeletePage(catalog_meta_->table_meta_pages_[table_id]))
     return DB_FAILED;
+  TableStatistics::Free(buffer_pool_manager_, tables_[table_id]->GetTableMetadata()->GetStatisticsPageId());
   table_names_.erase(table_name);
   tables_.erase(table_id);
   catalog_meta_->table_meta_pages_.erase(table_id);
@@ -243,6 +264,107 @@ dberr_t CatalogManager::DropTable(const string &table_name) {
   return DB_SUCCESS;
 }
 
+dberr_t CatalogManager::VacuumTable(const std::string &table_name, Txn *txn) {
+  WaitForVacuum(table_name);
+  if (!table_names_.count(table_name)) return DB_TABLE_NOT_EXIST;
+  std::vector<IndexInfo *> indexes;
+  GetTableIndexes(table_name, indexes);
+  VacuumTable(tables_.at(table_names_.at(table_name)), indexes, txn);
+  return DB_SUCCESS;
+}
+
+void CatalogManager::VacuumTable(TableInfo *table_info, const std::vector<IndexInfo *> &indexes, Txn *txn) {
+  std::vector<std::pair<RowId, Row>> moved_rows;
+  table_info->GetTableHeap()->Vacuum(moved_rows, txn);
+  for (auto index_info : indexes) {
+    Row key_row;
+    for (auto &moved : moved_rows) {
+      moved.second.GetKeyFromRow(table_info->GetSchema(), index_info->GetIndexKeySchema(), key_row);
+      index_info->GetIndex()->RemoveEntry(key_row, moved.first, txn);
+      index_info->GetIndex()->InsertEntry(key_row, moved.second.GetRowId(), txn);
+    }
+  }
+}
+
+dberr_t CatalogManager::AnalyzeTable(const std::string &table_name, Txn *txn) {
+  WaitForVacuum(table_name);
+  if (!table_names_.count(table_name)) return DB_TABLE_NOT_EXIST;
+  table_id_t table_id = table_names_.at(table_name);
+  TableInfo *table_info = tables_.at(table_id);
+  auto statistics = TableStatistics::Collect(table_info->GetTableHeap(), table_info->GetSchema(), txn);
+  page_id_t statistics_page_id = statistics->Store(buffer_pool_manager_);
+  if (statistics_page_id == INVALID_PAGE_ID) {
+    delete statistics;
+    return DB_FAILED;
+  }
+  TableStatistics::Free(buffer_pool_manager_, table_info->GetTableMetadata()->GetStatisticsPageId());
+  table_info->SetStatistics(statistics, statistics_page_id);
+  page_id_t page_id = catalog_meta_->table_meta_pages_.at(table_id);
+  Page *metadata_page = buffer_pool_manager_->FetchPage(page_id);
+  table_info->GetTableMetadata()->SerializeTo(metadata_page->GetData());
+  buffer_pool_manager_->UnpinPage(page_id, true);
+  return DB_SUCCESS;
+}
+
+dberr_t CatalogManager::TruncateTable(const std::string &table_name, Txn *txn) {
+  WaitForVacuum(table_name);
+  if (!table_names_.count(table_name)) return DB_TABLE_NOT_EXIST;
+  table_id_t table_id = table_names_.at(table_name);
+  TableInfo *table_info = tables_.at(table_id);
+  TableHeap *table_heap = TableHeap::Create(buffer_pool_manager_, table_info->GetSchema(), txn, log_manager_,
+                                            lock_manager_, table_info->GetTableHeap()->GetLayout());
+  TableHeap *old_table_heap = table_info->SwapTableHeap(table_heap);
+  page_id_t statistics_page_id = table_info->GetTableMetadata()->GetStatisticsPageId();
+  table_info->SetStatistics(nullptr, INVALID_PAGE_ID);
+  page_id_t page_id = catalog_meta_->table_meta_pages_.at(table_id);
+  Page *metadata_page = buffer_pool_manager_->FetchPage(page_id);
+  table_info->GetTableMetadata()->SerializeTo(metadata_page->GetData());
+  buffer_pool_manager_->UnpinPage(page_id, true);
+  std::vector<IndexInfo *> indexes;
+  GetTableIndexes(table_name, indexes);
+  std::vector<std::pair<Index *, page_id_t>> detached;
+  for (auto index_info : indexes) {
+    detached.emplace_back(index_info->GetIndex(), index_info->GetIndex()->Detach());
+  }
+  BufferPoolManager *buffer_pool_manager = buffer_pool_manager_;
+  reclaimer_.Submit([=] {
+    old_table_heap->FreeTableHeap();
+    delete old_table_heap;
+    TableStatistics::Free(buffer_pool_manager, statistics_page_id);
+    for (auto &entry : detached) {
+      entry.first->FreeDetached(entry.second);
+    }
+  });
+  return DB_SUCCESS;
+}
+
+bool CatalogManager::ScheduleAutoVacuum(const std::string &table_name) {
+  TableInfo *table_info;
+  if (GetTable(table_name, table_info) != DB_SUCCESS) return false;
+  if (!table_info->GetTableHeap()->NeedsVacuum(auto_vacuum_threshold_)) return false;
+  // looked up here, the worker never reads the maps that later statements change
+  std::vector<IndexInfo *> indexes;
+  GetTableIndexes(table_name, indexes);
+  {
+    std::lock_guard<std::mutex> lock(vacuum_latch_);
+    vacuuming_.insert(table_name);
+  }
+  reclaimer_.Submit([this, table_name, table_info, indexes] {
+    VacuumTable(table_info, indexes, nullptr);
+    {
+      std::lock_guard<std::mutex> lock(vacuum_latch_);
+      vacuuming_.erase(table_name);
+    }
+    vacuumed_.notify_all();
+  });
+  return true;
+}
+
+void CatalogManager::WaitForVacuum(const std::string &table_name) const {
+  std::unique_lock<std::mutex> lock(vacuum_latch_);
+  vacuumed_.wait(lock, [this, &table_name] { return vacuuming_.count(table_name) == 0; });
+}
+
 /**
  * TODO: Student Implement
  */
@@ -253,6 +375,8 @@ dberr_t CatalogManager::DropIndex(const string &table_name, const string &index_
     return DB_INDEX_NOT_FOUND;
   if(index_names_.find(table_name)->second.find(index_name) == index_names_.find(table_name)->second.end())
     return DB_INDEX_NOT_FOUND;
+  // pending frees of a truncate still use the index
+  reclaimer_.Drain();
   index_id_t index_id = index_names_[table_name][index_name];
   if(!buffer_pool_manager_->DeletePage(catalog_meta_->index_meta_pages_[index_id]))
     return DB_FAILED;
@@ -285,8 +409,16 @@ dberr_t CatalogManager::LoadTable(const table_id_t table_id, const page_id_t pag
   TableInfo *table_info = TableInfo::Create();
   TableMetadata *table_meta_data;
   TableMetadata::DeserializeFrom(meta_data_page->GetData(), table_meta_data);
-  TableHeap *table_heap = TableHeap::Create(buffer_pool_manager_, table_meta_data->GetFirstPageId(), table_meta_data->GetSchema(), log_manager_, lock_manager_);
+  TableHeap *table_heap = TableHeap::Create(buffer_pool_manager_, table_meta_data->GetFirstPageId(),
+                                            table_meta_data->GetFsmPageId(), table_meta_data->GetSchema(),
+                                            log_manager_, lock_manager_, table_meta_data->GetDictionaryPageId(),
+                                            table_meta_data->GetZoneMapPageId());
   table_info->Init(table_meta_data, table_heap);
+  if (table_meta_data->GetStatisticsPageId() != INVALID_PAGE_ID) {
+    table_info->SetStatistics(TableStatistics::Load(buffer_pool_manager_, table_meta_data->GetStatisticsPageId(),
+                                                    table_meta_data->GetSchema()),
+                              table_meta_data->GetStatisticsPageId());
+  }
   table_names_[table_meta_data->GetTableName()] = table_id;
   tables_[table_id] = table_info;
   buffer_pool_manager_->UnpinPage(page_id, false);
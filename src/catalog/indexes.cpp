@@ -82,28 +82,23 @@ uint32_t IndexMetadata::DeserializeFrom(char *buf, IndexMetadata *&index_meta) {
 }
 
 Index *IndexInfo::CreateIndex(BufferPoolManager *buffer_pool_manager, const string &index_type) {
-  size_t max_size = 0;
-  uint32_t column_cnt = key_schema_->GetColumns().size();
-  size_t size_bitmap = (column_cnt % 8) ? column_cnt / 8 + 1 : column_cnt / 8;
-  // column_cnt + bitmap
-  max_size += 4 + sizeof(unsigned char) * size_bitmap;
-  for (auto col : key_schema_->GetColumns()) {
-    // length of char column
-    if(col->GetType() == TypeId::kTypeChar)
-      max_size += 4;
-    max_size += col->GetLength();
-  }
+  // the encoded keys have no header, a key fills its size class exactly, an integer key takes its own width
+  size_t max_size = KeyManager::GetEncodedSize(key_schema_);
 
   if (index_type == "bptree") {
-    if (max_size <= 8)
+    if (max_size <= 4)
+      max_size = 4;
+    else if (max_size <= 8)
+      max_size = 8;
+    else if (max_size <= 16)
       max_size = 16;
-    else if (max_size <= 24)
+    else if (max_size <= 32)
       max_size = 32;
-    else if (max_size <= 56)
+    else if (max_size <= 64)
       max_size = 64;
-    else if (max_size <= 120)
+    else if (max_size <= 128)
       max_size = 128;
-    else if (max_size <= 248)
+    else if (max_size <= 256)
       max_size = 256;
     else {
       LOG(ERROR) << "GenericKey size is too large";
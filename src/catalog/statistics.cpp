@@ -0,0 +1,271 @@
+#include "catalog/statistics.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <string_view>
+
+#include "page/statistics_page.h"
+#include "record/row_batch.h"
+
+namespace {
+
+/**
+ * HyperLogLog sketch estimating the number of distinct hashes added to it in 2^PRECISION one byte registers.
+ */
+class HyperLogLog {
+ public:
+  void Add(uint64_t hash) {
+    uint32_t idx = hash >> (64 - PRECISION);
+    uint64_t rest = hash << PRECISION;
+    auto rank = static_cast<uint8_t>(rest == 0 ? 64 - PRECISION + 1 : __builtin_clzll(rest) + 1);
+    registers_[idx] = std::max(registers_[idx], rank);
+  }
+
+  double Estimate() const {
+    double sum = 0;
+    uint32_t zeros = 0;
+    for (auto rank : registers_) {
+      sum += std::ldexp(1.0, -rank);
+      zeros += rank == 0;
+    }
+    double m = REGISTERS;
+    double estimate = 0.7213 / (1 + 1.079 / m) * m * m / sum;
+    // small cardinalities leave registers empty, linear counting is more accurate there
+    if (estimate <= 2.5 * m && zeros != 0) {
+      estimate = m * std::log(m / zeros);
+    }
+    return estimate;
+  }
+
+ private:
+  static constexpr uint32_t PRECISION = 10;
+  static constexpr uint32_t REGISTERS = 1 << PRECISION;
+  std::array<uint8_t, REGISTERS> registers_{};
+};
+
+uint64_t HashField(const Field *value) {
+  uint64_t hash;
+  if (value->GetTypeId() == TypeId::kTypeChar) {
+    hash = std::hash<std::string_view>()(std::string_view(value->GetData(), value->GetLength()));
+  } else {
+    char buf[sizeof(uint64_t)];
+    uint32_t len = value->SerializeTo(buf);
+    hash = std::hash<std::string_view>()(std::string_view(buf, len));
+  }
+  // the sketch reads the high bits, finish with the splitmix64 mixer so every bit depends on the whole value
+  hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+  return hash ^ (hash >> 31);
+}
+
+/**
+ * A sample holding almost only distinct values is taken from a column unique enough to grow with the table.
+ */
+constexpr double NEAR_UNIQUE_RATIO = 0.9;
+
+}  // namespace
+
+TableStatistics *TableStatistics::Collect(TableHeap *table_heap, const Schema *schema, Txn *txn) {
+  auto statistics = new TableStatistics();
+  statistics->row_count_ = table_heap->GetTupleCount();
+  statistics->page_count_ = table_heap->GetPageCount();
+  // rows of the sampled pages stay alive while the sorted values point into them
+  uint32_t sample_pages = std::min(statistics->page_count_, ANALYZE_SAMPLE_PAGES);
+  std::vector<RowBatch> batches(sample_pages);
+  for (uint32_t i = 0; i < sample_pages; i++) {
+    uint32_t index = static_cast<uint64_t>(i) * statistics->page_count_ / sample_pages;
+    table_heap->ScanPage(table_heap->GetPageId(index), batches[i], txn);
+    statistics->sampled_row_count_ += batches[i].Size();
+  }
+  statistics->columns_.resize(schema->GetColumnCount());
+  std::vector<const Field *> values;
+  values.reserve(statistics->sampled_row_count_);
+  for (uint32_t i = 0; i < schema->GetColumnCount(); i++) {
+    values.clear();
+    for (auto &batch : batches) {
+      for (size_t j = 0; j < batch.Size(); j++) {
+        values.push_back(batch[j].GetField(i));
+      }
+    }
+    CollectColumn(values, statistics->row_count_, statistics->columns_[i]);
+  }
+  return statistics;
+}
+
+void TableStatistics::CollectColumn(std::vector<const Field *> &values, uint64_t row_count, ColumnStatistics &column) {
+  if (values.empty()) {
+    return;
+  }
+  uint64_t sampled = values.size();
+  values.erase(std::remove_if(values.begin(), values.end(), [](const Field *value) { return value->IsNull(); }),
+               values.end());
+  uint64_t non_null = values.size();
+  column.null_fraction_ = static_cast<float>(sampled - non_null) / sampled;
+  if (values.empty()) {
+    return;
+  }
+  HyperLogLog sketch;
+  for (auto value : values) {
+    sketch.Add(HashField(value));
+  }
+  double distinct = std::min(sketch.Estimate(), static_cast<double>(non_null));
+  if (distinct >= NEAR_UNIQUE_RATIO * non_null) {
+    distinct *= static_cast<double>(row_count) / sampled;
+  }
+  column.distinct_count_ = std::max<uint64_t>(1, std::llround(distinct));
+  std::sort(values.begin(), values.end(),
+            [](const Field *a, const Field *b) { return a->CompareLessThan(*b) == CmpBool::kTrue; });
+  // bucket b ends at the value of rank b * n / buckets, so every bucket holds about the same number of values
+  uint32_t buckets = std::min<uint64_t>(HISTOGRAM_BUCKETS, non_null - 1);
+  column.bounds_.reserve(buckets + 1);
+  for (uint32_t b = 0; b <= buckets; b++) {
+    const Field *value = values[buckets == 0 ? 0 : b * (non_null - 1) / buckets];
+    if (value->GetTypeId() == TypeId::kTypeChar) {
+      column.bounds_.emplace_back(TypeId::kTypeChar, const_cast<char *>(value->GetData()),
+                                  std::min(value->GetLength(), HISTOGRAM_BOUND_LENGTH), true);
+    } else {
+      column.bounds_.emplace_back(*value);
+    }
+  }
+}
+
+page_id_t TableStatistics::Store(BufferPoolManager *buffer_pool_manager) const {
+  std::vector<char> buf(GetSerializedSize());
+  SerializeTo(buf.data());
+  page_id_t first_page_id = INVALID_PAGE_ID;
+  page_id_t last_page_id = INVALID_PAGE_ID;
+  StatisticsPage *last_page = nullptr;
+  uint32_t offset = 0;
+  while (offset < buf.size()) {
+    page_id_t page_id;
+    auto raw_page = buffer_pool_manager->NewPage(page_id);
+    if (raw_page == nullptr) {
+      if (last_page != nullptr) {
+        buffer_pool_manager->UnpinPage(last_page_id, true);
+      }
+      Free(buffer_pool_manager, first_page_id);
+      return INVALID_PAGE_ID;
+    }
+    auto page = reinterpret_cast<StatisticsPage *>(raw_page->GetData());
+    page->Init(page_id);
+    uint32_t size = std::min<uint32_t>(buf.size() - offset, StatisticsPage::CAPACITY);
+    memcpy(page->GetData(), buf.data() + offset, size);
+    page->SetSize(size);
+    offset += size;
+    if (last_page == nullptr) {
+      first_page_id = page_id;
+    } else {
+      last_page->SetNextPageId(page_id);
+      buffer_pool_manager->UnpinPage(last_page_id, true);
+    }
+    last_page = page;
+    last_page_id = page_id;
+  }
+  buffer_pool_manager->UnpinPage(last_page_id, true);
+  return first_page_id;
+}
+
+TableStatistics *TableStatistics::Load(BufferPoolManager *buffer_pool_manager, page_id_t first_page_id,
+                                       const Schema *schema) {
+  std::vector<char> buf;
+  for (page_id_t page_id = first_page_id; page_id != INVALID_PAGE_ID;) {
+    auto page = reinterpret_cast<StatisticsPage *>(buffer_pool_manager->FetchPage(page_id)->GetData());
+    buf.insert(buf.end(), page->GetData(), page->GetData() + page->GetSize());
+    page_id_t next_page_id = page->GetNextPageId();
+    buffer_pool_manager->UnpinPage(page_id, false);
+    page_id = next_page_id;
+  }
+  TableStatistics *statistics = nullptr;
+  DeserializeFrom(buf.data(), schema, statistics);
+  return statistics;
+}
+
+void TableStatistics::Free(BufferPoolManager *buffer_pool_manager, page_id_t first_page_id) {
+  for (page_id_t page_id = first_page_id; page_id != INVALID_PAGE_ID;) {
+    auto page = reinterpret_cast<StatisticsPage *>(buffer_pool_manager->FetchPage(page_id)->GetData());
+    page_id_t next_page_id = page->GetNextPageId();
+    buffer_pool_manager->UnpinPage(page_id, false);
+    buffer_pool_manager->DeletePage(page_id);
+    page_id = next_page_id;
+  }
+}
+
+uint32_t TableStatistics::SerializeTo(char *buf) const {
+  char *p = buf;
+  // magic num
+  MACH_WRITE_UINT32(buf, TABLE_STATISTICS_MAGIC_NUM);
+  buf += 4;
+  // table counts
+  MACH_WRITE_TO(uint64_t, buf, row_count_);
+  buf += 8;
+  MACH_WRITE_UINT32(buf, page_count_);
+  buf += 4;
+  MACH_WRITE_TO(uint64_t, buf, sampled_row_count_);
+  buf += 8;
+  // columns
+  MACH_WRITE_UINT32(buf, columns_.size());
+  buf += 4;
+  for (const auto &column : columns_) {
+    MACH_WRITE_TO(float, buf, column.null_fraction_);
+    buf += 4;
+    MACH_WRITE_TO(uint64_t, buf, column.distinct_count_);
+    buf += 8;
+    MACH_WRITE_UINT32(buf, column.bounds_.size());
+    buf += 4;
+    for (const auto &bound : column.bounds_) {
+      buf += bound.SerializeTo(buf);
+    }
+  }
+  ASSERT(buf - p == GetSerializedSize(), "Unexpected serialize size.");
+  return buf - p;
+}
+
+uint32_t TableStatistics::GetSerializedSize() const {
+  uint32_t size = 4 + 8 + 4 + 8 + 4;
+  for (const auto &column : columns_) {
+    size += 4 + 8 + 4;
+    for (const auto &bound : column.bounds_) {
+      size += bound.GetSerializedSize();
+    }
+  }
+  return size;
+}
+
+uint32_t TableStatistics::DeserializeFrom(char *buf, const Schema *schema, TableStatistics *&statistics) {
+  char *p = buf;
+  // magic num
+  uint32_t magic_num = MACH_READ_UINT32(buf);
+  buf += 4;
+  ASSERT(magic_num == TABLE_STATISTICS_MAGIC_NUM, "Failed to deserialize table statistics.");
+  statistics = new TableStatistics();
+  // table counts
+  statistics->row_count_ = MACH_READ_FROM(uint64_t, buf);
+  buf += 8;
+  statistics->page_count_ = MACH_READ_UINT32(buf);
+  buf += 4;
+  statistics->sampled_row_count_ = MACH_READ_FROM(uint64_t, buf);
+  buf += 8;
+  // columns
+  uint32_t column_count = MACH_READ_UINT32(buf);
+  buf += 4;
+  ASSERT(column_count == schema->GetColumnCount(), "Statistics do not match the table schema.");
+  statistics->columns_.resize(column_count);
+  for (uint32_t i = 0; i < column_count; i++) {
+    auto &column = statistics->columns_[i];
+    column.null_fraction_ = MACH_READ_FROM(float, buf);
+    buf += 4;
+    column.distinct_count_ = MACH_READ_FROM(uint64_t, buf);
+    buf += 8;
+    uint32_t bound_count = MACH_READ_UINT32(buf);
+    buf += 4;
+    column.bounds_.reserve(bound_count);
+    for (uint32_t j = 0; j < bound_count; j++) {
+      Field *bound = nullptr;
+      buf += Field::DeserializeFrom(buf, schema->GetColumn(i)->GetType(), &bound, false);
+      column.bounds_.emplace_back(*bound);
+      delete bound;
+    }
+  }
+  return buf - p;
+}
@@ -18,6 +18,18 @@ uint32_t TableMetadata::SerializeTo(char *buf) const {
   // table heap root page id
   MACH_WRITE_TO(page_id_t, buf, root_page_id_);
   buf += 4;
+  // free space map page id
+  MACH_WRITE_TO(page_id_t, buf, fsm_page_id_);
+  buf += 4;
+  // dictionary page id
+  MACH_WRITE_TO(page_id_t, buf, dictionary_page_id_);
+  buf += 4;
+  // zone map page id
+  MACH_WRITE_TO(page_id_t, buf, zone_map_page_id_);
+  buf += 4;
+  // statistics page id
+  MACH_WRITE_TO(page_id_t, buf, statistics_page_id_);
+  buf += 4;
   // table schema
   buf += schema_->SerializeTo(buf);
   ASSERT(buf - p == ofs, "Unexpected serialize size.");
@@ -28,7 +40,7 @@ uint32_t TableMetadata::SerializeTo(char *buf) const {
  * TODO: Student Implement
  */
 uint32_t TableMetadata::GetSerializedSize() const {
-  return 4 + 4 + MACH_STR_SERIALIZED_SIZE(table_name_) + 4 + schema_->GetSerializedSize();
+  return 4 + 4 + MACH_STR_SERIALIZED_SIZE(table_name_) + 4 + 4 + 4 + 4 + 4 + schema_->GetSerializedSize();
 }
 
 /**
@@ -55,11 +67,25 @@ uint32_t TableMetadata::DeserializeFrom(char *buf, TableMetadata *&table_meta) {
   // table heap root page id
   page_id_t root_page_id = MACH_READ_FROM(page_id_t, buf);
   buf += 4;
+  // free space map page id
+  page_id_t fsm_page_id = MACH_READ_FROM(page_id_t, buf);
+  buf += 4;
+  // dictionary page id
+  page_id_t dictionary_page_id = MACH_READ_FROM(page_id_t, buf);
+  buf += 4;
+  // zone map page id
+  page_id_t zone_map_page_id = MACH_READ_FROM(page_id_t, buf);
+  buf += 4;
+  // statistics page id
+  page_id_t statistics_page_id = MACH_READ_FROM(page_id_t, buf);
+  buf += 4;
   // table schema
   TableSchema *schema = nullptr;
   buf += TableSchema::DeserializeFrom(buf, schema);
   // allocate space for table metadata
-  table_meta = new TableMetadata(table_id, table_name, root_page_id, schema);
+  table_meta = new TableMetadata(table_id, table_name, root_page_id, fsm_page_id, dictionary_page_id,
+                                 zone_map_page_id, schema);
+  table_meta->statistics_page_id_ = statistics_page_id;
   return buf - p;
 }
 
@@ -69,10 +95,20 @@ uint32_t TableMetadata::DeserializeFrom(char *buf, TableMetadata *&table_meta) {
  * @param heap Memory heap passed by TableInfo
  */
 TableMetadata *TableMetadata::Create(table_id_t table_id, std::string table_name, page_id_t root_page_id,
+                                     page_id_t fsm_page_id, page_id_t dictionary_page_id, page_id_t zone_map_page_id,
                                      TableSchema *schema) {
   // allocate space for table metadata
-  return new TableMetadata(table_id, table_name, root_page_id, schema);
+  return new TableMetadata(table_id, table_name, root_page_id, fsm_page_id, dictionary_page_id, zone_map_page_id,
+                           schema);
 }
 
-TableMetadata::TableMetadata(table_id_t table_id, std::string table_name, page_id_t root_page_id, TableSchema *schema)
-    : table_id_(table_id), table_name_(table_name), root_page_id_(root_page_id), schema_(schema) {}
+TableMetadata::TableMetadata(table_id_t table_id, std::string table_name, page_id_t root_page_id,
+                             page_id_t fsm_page_id, page_id_t dictionary_page_id, page_id_t zone_map_page_id,
+                             TableSchema *schema)
+    : table_id_(table_id),
+      table_name_(table_name),
+      root_page_id_(root_page_id),
+      fsm_page_id_(fsm_page_id),
+      dictionary_page_id_(dictionary_page_id),
+      zone_map_page_id_(zone_map_page_id),
+      schema_(schema) {}
@@ -0,0 +1,40 @@
+#include "common/arena.h"
+
+#include <cstdint>
+#include <cstring>
+
+void *Arena::Allocate(size_t size, size_t align) {
+  if (size > block_size_ / 4) {
+    large_blocks_.push_back(std::make_unique<char[]>(size));
+    allocated_ += size;
+    return large_blocks_.back().get();
+  }
+  size_t padding = (align - reinterpret_cast<uintptr_t>(cursor_) % align) % align;
+  if (cursor_ == nullptr || static_cast<size_t>(block_end_ - cursor_) < padding + size) {
+    blocks_.push_back(std::make_unique<char[]>(block_size_));
+    cursor_ = blocks_.back().get();
+    block_end_ = cursor_ + block_size_;
+    // new[] of char aligns a block for any fundamental type
+    padding = 0;
+  }
+  char *data = cursor_ + padding;
+  cursor_ = data + size;
+  allocated_ += padding + size;
+  return data;
+}
+
+char *Arena::CopyBytes(const char *data, size_t len) {
+  auto copy = static_cast<char *>(Allocate(len, 1));
+  memcpy(copy, data, len);
+  return copy;
+}
+
+void Arena::Reset() {
+  large_blocks_.clear();
+  if (!blocks_.empty()) {
+    blocks_.resize(1);
+    cursor_ = blocks_.front().get();
+    block_end_ = cursor_ + block_size_;
+  }
+  allocated_ = 0;
+}
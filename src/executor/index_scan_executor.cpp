@@ -10,8 +10,9 @@ IndexScanExecutor::IndexScanExecutor(ExecuteContext *exec_ctx, const IndexScanPl
 
 void IndexScanExecutor::Init() {
   exec_ctx_->GetCatalog()->GetTable(plan_->GetTableName(), table_info_);
-  auto first_row = table_info_->GetTableHeap()->Begin(nullptr);
   result_ = IndexScan(plan_->GetPredicate());
+  view_ = std::make_unique<RowView>(table_info_->GetSchema(), table_info_->GetTableHeap()->GetOverflowStore(),
+                                    table_info_->GetTableHeap()->GetDictionary());
   is_schema_same_ = SchemaEqual(table_info_->GetSchema(), plan_->OutputSchema());
 }
 
@@ -32,18 +33,6 @@ bool IndexScanExecutor::SchemaEqual(const Schema *table_schema, const Schema *ou
   return true;
 }
 
-void IndexScanExecutor::TupleTransfer(const Schema *table_schema, const Schema *output_schema, const Row *row,
-                                      Row *output_row) {
-  const auto &output_columns = output_schema->GetColumns();
-  std::vector<Field> dest_row;
-  dest_row.reserve(output_columns.size());
-  for (const auto column : output_columns) {
-    auto idx = column->GetTableInd();
-    dest_row.emplace_back(*row->GetField(idx));
-  }
-  *output_row = Row(dest_row);
-}
-
 vector<RowId> IndexScanExecutor::IndexScan(AbstractExpressionRef predicate) {
   switch (predicate->GetType()) {
     case ExpressionType::LogicExpression: {
@@ -80,26 +69,37 @@ vector<RowId> IndexScanExecutor::IndexScan(AbstractExpressionRef predicate) {
 
 bool IndexScanExecutor::Next(Row *row, RowId *rid) {
   auto predicate = plan_->GetPredicate();
-  auto table_schema = table_info_->GetSchema();
+  auto bpm = exec_ctx_->GetBufferPoolManager();
+  auto table_heap = table_info_->GetTableHeap();
   while (cursor_ < result_.size()) {
-    auto p_row = new Row(result_[cursor_]);
-    table_info_->GetTableHeap()->GetTuple(p_row, nullptr);
-    if (plan_->need_filter_) {
-      if (!predicate->Evaluate(p_row).CompareEquals(Field(kTypeInt, 1))) {
-        cursor_++;
-        delete p_row;
-        continue;
+    RowId cur_rid = result_[cursor_++];
+    auto page = reinterpret_cast<TablePage *>(bpm->FetchPage(cur_rid.GetPageId()));
+    if (page == nullptr) {
+      continue;
+    }
+    page->RLatch();
+    bool emit = page->IsTupleVisible(cur_rid.GetSlotNum());
+    TablePage *tuple_page = page;
+    if (emit) {
+      uint32_t slot_num = cur_rid.GetSlotNum();
+      tuple_page = table_heap->FetchTuplePage(page, slot_num);
+      view_->Reset(tuple_page, slot_num, cur_rid);
+      emit = !plan_->need_filter_ || predicate->Evaluate(*view_).CompareEquals(Field(kTypeInt, 1));
+    }
+    if (emit) {
+      *rid = cur_rid;
+      if (!is_schema_same_) {
+        view_->Materialize(plan_->OutputSchema(), row);
+      } else {
+        view_->Materialize(row);
       }
     }
-    *rid = result_[cursor_];
-    if (!is_schema_same_) {
-      TupleTransfer(table_schema, plan_->OutputSchema(), p_row, row);
-    } else {
-      *row = *p_row;
+    table_heap->ReleaseTuplePage(page, tuple_page);
+    page->RUnlatch();
+    bpm->UnpinPage(cur_rid.GetPageId(), false);
+    if (emit) {
+      return true;
     }
-    delete p_row;
-    cursor_++;
-    return true;
   }
   return false;
 }
@@ -4,6 +4,9 @@
 
 #include "executor/executors/insert_executor.h"
 
+#include <string>
+#include <unordered_set>
+
 InsertExecutor::InsertExecutor(ExecuteContext *exec_ctx, const InsertPlanNode *plan,
                                std::unique_ptr<AbstractExecutor> &&child_executor)
   : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {
@@ -17,28 +20,83 @@ void InsertExecutor::Init() {
 }
 
 bool InsertExecutor::Next([[maybe_unused]] Row *row, RowId *rid) {
+  if (!is_inserted_) {
+    InsertBatch();
+    is_inserted_ = true;
+  }
+  if (cursor_ < inserted_rids_.size()) {
+    *rid = inserted_rids_[cursor_++];
+    return true;
+  }
+  return false;
+}
+
+/**
+ * Encode a key row into bytes, used to detect duplicate keys inside one batch.
+ */
+static std::string KeyToString(Row &key_row) {
+  std::string bytes;
+  char buf[PAGE_SIZE];
+  for (const auto &field : key_row.GetFields()) {
+    bytes.push_back(field.IsNull() ? 0 : 1);
+    bytes.append(buf, field.SerializeTo(buf));
+  }
+  return bytes;
+}
+
+void InsertExecutor::InsertBatch() {
+  std::vector<Row> rows;
+  std::vector<std::unordered_set<std::string>> batch_keys(index_info_.size());
   Row insert_row;
   RowId insert_rid;
-  if (child_executor_->Next(&insert_row, &insert_rid)) {
-    for (auto info: index_info_) {
+  while (child_executor_->Next(&insert_row, &insert_rid)) {
+    uint32_t column_idx;
+    if (!insert_row.FitsSchema(schema_, column_idx)) {
+      std::cout << "value too long for column '" << schema_->GetColumn(column_idx)->GetName() << "'" << std::endl;
+      break;
+    }
+    // the index keys of a column which is not nullable have no room for a null
+    if (!insert_row.FitsNullability(schema_, column_idx)) {
+      std::cout << "column '" << schema_->GetColumn(column_idx)->GetName() << "' cannot be null" << std::endl;
+      break;
+    }
+    bool duplicated = false;
+    for (size_t i = 0; i < index_info_.size() && !duplicated; i++) {
       Row key_row;
-      insert_row.GetKeyFromRow(table_info_->GetSchema(), info->GetIndexKeySchema(), key_row);
-      std::vector<RowId> result;
-      if (!key_row.GetFields().empty() &&
-          info->GetIndex()->ScanKey(key_row, result, exec_ctx_->GetTransaction()) == DB_SUCCESS) {
-        std::cout << "key already exists" << std::endl;
-        return false;
+      insert_row.GetKeyFromRow(schema_, index_info_[i]->GetIndexKeySchema(), key_row);
+      if (key_row.GetFieldCount() == 0) {
+        continue;
       }
+      std::vector<RowId> result;
+      // the tree is only descended if its key filter cannot rule the key out
+      Index *index = index_info_[i]->GetIndex();
+      duplicated = batch_keys[i].count(KeyToString(key_row)) != 0 ||
+                   (index->MayContain(key_row) &&
+                    index->ScanKey(key_row, result, exec_ctx_->GetTransaction()) == DB_SUCCESS);
     }
-    if (table_info_->GetTableHeap()->InsertTuple(insert_row, exec_ctx_->GetTransaction())) {
+    if (duplicated) {
+      std::cout << "key already exists" << std::endl;
+      break;
+    }
+    for (size_t i = 0; i < index_info_.size(); i++) {
       Row key_row;
-      for (auto info: index_info_) {
-        // 更新索引
-        insert_row.GetKeyFromRow(schema_, info->GetIndexKeySchema(), key_row);
-        info->GetIndex()->InsertEntry(key_row, insert_row.GetRowId(), exec_ctx_->GetTransaction());
-      }
-      return true;
+      insert_row.GetKeyFromRow(schema_, index_info_[i]->GetIndexKeySchema(), key_row);
+      batch_keys[i].insert(KeyToString(key_row));
     }
+    // the child rebuilds the row on its next call, hand this one over
+    rows.push_back(std::move(insert_row));
+  }
+  auto rids = table_info_->GetTableHeap()->InsertTuples(rows, exec_ctx_->GetTransaction());
+  for (size_t i = 0; i < rows.size(); i++) {
+    if (rids[i] == INVALID_ROWID) {
+      continue;
+    }
+    Row key_row;
+    for (auto info : index_info_) {
+      // 更新索引
+      rows[i].GetKeyFromRow(schema_, info->GetIndexKeySchema(), key_row);
+      info->GetIndex()->InsertEntry(key_row, rids[i], exec_ctx_->GetTransaction());
+    }
+    inserted_rids_.push_back(rids[i]);
   }
-  return false;
 }
@@ -3,13 +3,24 @@
 //
 #include "executor/executors/seq_scan_executor.h"
 
+#include <algorithm>
+
+#include "planner/expressions/comparison_expression.h"
+#include "planner/expressions/logic_expression.h"
+
 SeqScanExecutor::SeqScanExecutor(ExecuteContext *exec_ctx, const SeqScanPlanNode *plan)
   : AbstractExecutor(exec_ctx),
     plan_(plan),
-    iterator_(nullptr, nullptr, RowId(INVALID_PAGE_ID, 0)),
     is_schema_same_(false) {
 }
 
+SeqScanExecutor::~SeqScanExecutor() {
+  StopWorkers();
+  if (page_ != nullptr) {
+    exec_ctx_->GetBufferPoolManager()->UnpinPage(page_->GetTablePageId(), false);
+  }
+}
+
 bool SeqScanExecutor::SchemaEqual(const Schema *table_schema, const Schema *output_schema) {
   auto table_columns = table_schema->GetColumns();
   auto output_columns = output_schema->GetColumns();
@@ -27,47 +38,182 @@ bool SeqScanExecutor::SchemaEqual(const Schema *table_schema, const Schema *outp
   return true;
 }
 
-void SeqScanExecutor::TupleTransfer(const Schema *table_schema, const Schema *output_schema, const Row *row,
-                                    Row *output_row) {
-  const auto &output_columns = output_schema->GetColumns();
-  std::vector<Field> dest_row;
-  dest_row.reserve(output_columns.size());
-  for (const auto column: output_columns) {
-    auto idx = column->GetTableInd();
-    dest_row.emplace_back(*row->GetField(idx));
-  }
-  *output_row = Row(dest_row);
-}
-
 void SeqScanExecutor::Init() {
-  auto tmp0 = exec_ctx_->GetCatalog();
-  auto tmp4 = plan_->GetTableName();
   exec_ctx_->GetCatalog()->GetTable(plan_->GetTableName(), table_info_);
-  auto first_row = table_info_->GetTableHeap()->Begin(nullptr);
-  iterator_ = (table_info_->GetTableHeap()->Begin(exec_ctx_->GetTransaction()));
   schema_ = plan_->OutputSchema();
   is_schema_same_ = SchemaEqual(table_info_->GetSchema(), schema_);
+  uint32_t page_count = table_info_->GetTableHeap()->GetPageCount();
+  morsel_count_ = (page_count + SCAN_MORSEL_PAGES - 1) / SCAN_MORSEL_PAGES;
+  if (plan_->GetParallelism() > 1 && morsel_count_ > 1) {
+    StartWorkers(std::min(plan_->GetParallelism(), morsel_count_));
+    return;
+  }
+  page_index_ = 0;
+  page_ = FetchNextPage();
+  rid_ = INVALID_ROWID;
+  view_ = std::make_unique<RowView>(table_info_->GetSchema(), table_info_->GetTableHeap()->GetOverflowStore(),
+                                    table_info_->GetTableHeap()->GetDictionary());
 }
 
 bool SeqScanExecutor::Next(Row *row, RowId *rid) {
+  if (queue_ != nullptr) {
+    return NextParallel(row, rid);
+  }
   auto predicate = plan_->GetPredicate();
-  auto table_schema = table_info_->GetSchema();
-  while (iterator_ != table_info_->GetTableHeap()->End()) {
-    auto p_row = &(*iterator_);
-    if (predicate != nullptr) {
-      if (!predicate->Evaluate(p_row).CompareEquals(Field(kTypeInt, 1))) {
-        iterator_++;
-        continue;
+  auto bpm = exec_ctx_->GetBufferPoolManager();
+  auto table_heap = table_info_->GetTableHeap();
+  while (page_ != nullptr) {
+    bool found = rid_.GetPageId() == INVALID_PAGE_ID ? page_->GetFirstTupleRid(&rid_)
+                                                     : page_->GetNextTupleRid(rid_, &rid_);
+    if (!found) {
+      bpm->UnpinPage(page_->GetTablePageId(), false);
+      page_ = FetchNextPage();
+      continue;
+    }
+    page_->RLatch();
+    uint32_t slot_num = rid_.GetSlotNum();
+    TablePage *tuple_page = table_heap->FetchTuplePage(page_, slot_num);
+    view_->Reset(tuple_page, slot_num, rid_);
+    bool emit = predicate == nullptr || predicate->Evaluate(*view_).CompareEquals(Field(kTypeInt, 1));
+    if (emit) {
+      *rid = rid_;
+      if (!is_schema_same_) {
+        view_->Materialize(schema_, row);
+      } else {
+        view_->Materialize(row);
       }
     }
-    *rid = iterator_->GetRowId();
-    if (!is_schema_same_) {
-      TupleTransfer(table_schema, schema_, p_row, row);
-    } else {
-      *row = *p_row;
+    table_heap->ReleaseTuplePage(page_, tuple_page);
+    page_->RUnlatch();
+    if (emit) {
+      return true;
     }
-    iterator_++;
-    return true;
   }
   return false;
 }
+
+TablePage *SeqScanExecutor::FetchNextPage() {
+  auto table_heap = table_info_->GetTableHeap();
+  while (page_index_ < table_heap->GetPageCount()) {
+    uint32_t index = page_index_++;
+    if (PageMayMatch(plan_->GetPredicate(), index)) {
+      return reinterpret_cast<TablePage *>(exec_ctx_->GetBufferPoolManager()->FetchPage(table_heap->GetPageId(index)));
+    }
+  }
+  return nullptr;
+}
+
+bool SeqScanExecutor::PageMayMatch(const AbstractExpressionRef &predicate, uint32_t index) const {
+  if (predicate == nullptr) {
+    return true;
+  }
+  if (predicate->GetType() == ExpressionType::LogicExpression) {
+    bool left = PageMayMatch(predicate->GetChildAt(0), index);
+    if (static_cast<const LogicExpression *>(predicate.get())->logic_type_ == LogicType::And) {
+      return left && PageMayMatch(predicate->GetChildAt(1), index);
+    }
+    return left || PageMayMatch(predicate->GetChildAt(1), index);
+  }
+  if (predicate->GetType() != ExpressionType::ComparisonExpression) {
+    return true;
+  }
+  std::string comp = static_cast<ComparisonExpression *>(predicate.get())->GetComparisonType();
+  uint32_t column = predicate->GetChildAt(0)->GetType() == ExpressionType::ColumnExpression ? 0 : 1;
+  if (predicate->GetChildAt(column)->GetType() != ExpressionType::ColumnExpression ||
+      predicate->GetChildAt(1 - column)->GetType() != ExpressionType::ConstantExpression) {
+    return true;
+  }
+  // a constant on the left compares the other way round, = and <> read the same both ways
+  if (column == 1 && comp != "=" && comp != "<>") {
+    comp = comp[0] == '<' ? ">" + comp.substr(1) : comp[0] == '>' ? "<" + comp.substr(1) : comp;
+  }
+  uint32_t col_idx = static_cast<const ColumnValueExpression *>(predicate->GetChildAt(column).get())->GetColIdx();
+  const Field &value = static_cast<const ConstantValueExpression *>(predicate->GetChildAt(1 - column).get())->val_;
+  return table_info_->GetTableHeap()->GetZoneMap().MayMatch(index, col_idx, comp, value);
+}
+
+void SeqScanExecutor::StartWorkers(uint32_t thread_count) {
+  next_morsel_ = 0;
+  active_workers_ = thread_count;
+  // two pages in flight per worker keep the workers busy while the consumer catches up
+  queue_ = std::make_unique<BoundedQueue<Chunk>>(2 * thread_count);
+  for (uint32_t i = 0; i < thread_count; i++) {
+    workers_.emplace_back([this] {
+      ScanMorsels();
+      if (--active_workers_ == 0) {
+        queue_->Close();
+      }
+    });
+  }
+}
+
+void SeqScanExecutor::ScanMorsels() {
+  auto bpm = exec_ctx_->GetBufferPoolManager();
+  auto table_heap = table_info_->GetTableHeap();
+  auto predicate = plan_->GetPredicate();
+  RowView view(table_info_->GetSchema(), table_heap->GetOverflowStore(), table_heap->GetDictionary());
+  for (uint32_t morsel = next_morsel_++; morsel < morsel_count_; morsel = next_morsel_++) {
+    uint32_t end = std::min((morsel + 1) * SCAN_MORSEL_PAGES, table_heap->GetPageCount());
+    for (uint32_t i = morsel * SCAN_MORSEL_PAGES; i < end; i++) {
+      if (!PageMayMatch(predicate, i)) {
+        continue;
+      }
+      page_id_t page_id = table_heap->GetPageId(i);
+      auto page = reinterpret_cast<TablePage *>(bpm->FetchPage(page_id));
+      if (page == nullptr) {
+        continue;
+      }
+      Chunk chunk;
+      page->RLatch();
+      // sized up front, growing the chunk would deep copy its rows
+      chunk.reserve(page->GetLiveTupleCount());
+      RowId cur_rid;
+      for (bool found = page->GetFirstTupleRid(&cur_rid); found; found = page->GetNextTupleRid(cur_rid, &cur_rid)) {
+        uint32_t slot_num = cur_rid.GetSlotNum();
+        TablePage *tuple_page = table_heap->FetchTuplePage(page, slot_num);
+        view.Reset(tuple_page, slot_num, cur_rid);
+        if (predicate == nullptr || predicate->Evaluate(view).CompareEquals(Field(kTypeInt, 1))) {
+          chunk.emplace_back(cur_rid);
+          if (!is_schema_same_) {
+            view.Materialize(schema_, &chunk.back());
+          } else {
+            view.Materialize(&chunk.back());
+          }
+          chunk.back().SetRowId(cur_rid);
+        }
+        table_heap->ReleaseTuplePage(page, tuple_page);
+      }
+      page->RUnlatch();
+      bpm->UnpinPage(page_id, false);
+      if (!chunk.empty() && !queue_->Push(std::move(chunk))) {
+        return;
+      }
+    }
+  }
+}
+
+void SeqScanExecutor::StopWorkers() {
+  if (queue_ == nullptr) {
+    return;
+  }
+  queue_->Close();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+}
+
+bool SeqScanExecutor::NextParallel(Row *row, RowId *rid) {
+  while (chunk_pos_ == chunk_.size()) {
+    chunk_.clear();
+    chunk_pos_ = 0;
+    if (!queue_->Pop(&chunk_)) {
+      return false;
+    }
+  }
+  // hand the fields over instead of copying them
+  Row &next = chunk_[chunk_pos_++];
+  *rid = next.GetRowId();
+  *row = std::move(next);
+  return true;
+}
@@ -4,6 +4,8 @@
 
 #include "executor/executors/update_executor.h"
 
+#include <algorithm>
+
 UpdateExecutor::UpdateExecutor(ExecuteContext *exec_ctx, const UpdatePlanNode *plan,
                                std::unique_ptr<AbstractExecutor> &&child_executor)
     : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
@@ -13,6 +15,15 @@ void UpdateExecutor::Init() {
   exec_ctx_->GetCatalog()->GetTable(plan_->GetTableName(), table_info_);
   exec_ctx_->GetCatalog()->GetTableIndexes(table_info_->GetTableName(), index_info_);
   txn_ = exec_ctx_->GetTransaction();
+  const auto &update_attrs = plan_->GetUpdateAttr();
+  updated_indexes_.clear();
+  for (auto info : index_info_) {
+    const auto &key_map = info->GetKeyMapping();
+    if (std::any_of(key_map.begin(), key_map.end(),
+                    [&update_attrs](uint32_t column) { return update_attrs.count(column) > 0; })) {
+      updated_indexes_.push_back(info);
+    }
+  }
 }
 
 bool UpdateExecutor::Next([[maybe_unused]] Row *row, RowId *rid) {
@@ -20,11 +31,22 @@ bool UpdateExecutor::Next([[maybe_unused]] Row *row, RowId *rid) {
   RowId src_rid;
   if (child_executor_->Next(&src_row, &src_rid)) {
     Row dest_row = GenerateUpdatedTuple(src_row);
-    for (auto info: index_info_) {
+    uint32_t column_idx;
+    if (!dest_row.FitsSchema(table_info_->GetSchema(), column_idx)) {
+      std::cout << "value too long for column '" << table_info_->GetSchema()->GetColumn(column_idx)->GetName() << "'"
+                << std::endl;
+      return false;
+    }
+    if (!dest_row.FitsNullability(table_info_->GetSchema(), column_idx)) {
+      std::cout << "column '" << table_info_->GetSchema()->GetColumn(column_idx)->GetName() << "' cannot be null"
+                << std::endl;
+      return false;
+    }
+    for (auto info : updated_indexes_) {
       Row key_row;
       dest_row.GetKeyFromRow(table_info_->GetSchema(), info->GetIndexKeySchema(), key_row);
       std::vector<RowId> result;
-      if (!key_row.GetFields().empty() &&
+      if (key_row.GetFieldCount() != 0 && info->GetIndex()->MayContain(key_row) &&
           info->GetIndex()->ScanKey(key_row, result, exec_ctx_->GetTransaction()) == DB_SUCCESS &&
           find(result.begin(), result.end(), src_rid) == result.end()) {
         std::cout << "key already exists" << std::endl;
@@ -36,7 +58,7 @@ bool UpdateExecutor::Next([[maybe_unused]] Row *row, RowId *rid) {
     }
     Row src_key_row;
     Row dest_key_row;
-    for (auto info : index_info_) {  // 更新索引
+    for (auto info : updated_indexes_) {  // 更新索引
       src_row.GetKeyFromRow(table_info_->GetSchema(), info->GetIndexKeySchema(), src_key_row);
       dest_row.GetKeyFromRow(table_info_->GetSchema(), info->GetIndexKeySchema(), dest_key_row);
       info->GetIndex()->RemoveEntry(src_key_row, src_rid, txn_);
@@ -51,14 +73,16 @@ Row UpdateExecutor::GenerateUpdatedTuple(const Row &src_row) {
   const auto update_attrs = plan_->GetUpdateAttr();
   Schema *schema = table_info_->GetSchema();
   uint32_t col_count = schema->GetColumnCount();
-  std::vector<Field> values;
+  Row dest_row;
   for (uint32_t idx = 0; idx < col_count; idx++) {
-    if (update_attrs.find(idx) == update_attrs.cend()) {
-      values.emplace_back(*src_row.GetField(idx));
+    auto attr = update_attrs.find(idx);
+    if (attr == update_attrs.cend()) {
+      dest_row.AppendField(*src_row.GetField(idx));
     } else {
-      auto expr = update_attrs.at(idx);
-      values.emplace_back(expr->Evaluate(&src_row));
+      // an evaluated column may only refer to the chars of src_row, it is copied
+      const Field value = attr->second->Evaluate(&src_row);
+      dest_row.AppendField(value);
     }
   }
-  return Row{values};
+  return dest_row;
 }
\ No newline at end of file
@@ -1,9 +1,11 @@
 #ifndef MINISQL_BUFFER_POOL_MANAGER_H
 #define MINISQL_BUFFER_POOL_MANAGER_H
 
+#include <condition_variable>
 #include <list>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 
 
 #include "buffer/lru_replacer.h"
@@ -48,6 +50,19 @@ class BufferPoolManager {
 
   frame_id_t TryToFindFreePage();
 
+  /**
+   * Take a frame from the free list, or evict an unpinned page and write it back if dirty. Requires latch_.
+   * @return false if every frame is pinned
+   */
+  bool TakeFrame(frame_id_t *frame_id);
+
+  /**
+   * Wait until the page of the frame is read in, releasing latch_ meanwhile.
+   */
+  void WaitLoaded(std::unique_lock<std::mutex> &lock, frame_id_t frame_id);
+
+  void FlushFrame(frame_id_t frame_id);
+
  private:
   size_t pool_size_; // number of pages in buffer pool
   Page *pages_; // array of pages
@@ -55,7 +70,9 @@ class BufferPoolManager {
   unordered_map<page_id_t, frame_id_t> page_table_; // to keep track of pages
   Replacer *replacer_; // to find an unpinned page for replacement
   list<frame_id_t> free_list_; // to find a free page for replacement
-  recursive_mutex latch_; // to protect shared data structure
+  vector<bool> loading_; // frames whose page is being read in outside of latch_
+  mutex latch_; // to protect shared data structure, not held while a page is read in
+  condition_variable loaded_; // signaled when a frame finishes loading
 };
 
 #endif  // MINISQL_BUFFER_POOL_MANAGER_H
@@ -1,13 +1,17 @@
 #ifndef MINISQL_CATALOG_H
 #define MINISQL_CATALOG_H
 
+#include <condition_variable>
 #include <map>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "buffer/buffer_pool_manager.h"
 #include "catalog/indexes.h"
 #include "catalog/table.h"
+#include "common/background_worker.h"
 #include "common/config.h"
 #include "common/dberr.h"
 #include "concurrency/lock_manager.h"
@@ -76,7 +80,11 @@ class CatalogManager {
 
   ~CatalogManager();
 
-  dberr_t CreateTable(const std::string &table_name, TableSchema *schema, Txn *txn, TableInfo *&table_info);
+  /**
+   * @return DB_FAILED if the schema cannot be stored in the requested layout
+   */
+  dberr_t CreateTable(const std::string &table_name, TableSchema *schema, Txn *txn, TableInfo *&table_info,
+                      TableLayout layout = TableLayout::kRow);
 
   dberr_t GetTable(const std::string &table_name, TableInfo *&table_info);
 
@@ -94,6 +102,40 @@ class CatalogManager {
 
   dberr_t DropIndex(const std::string &table_name, const std::string &index_name);
 
+  /**
+   * Vacuum the table heap and repoint the index entries of every tuple it moved.
+   */
+  dberr_t VacuumTable(const std::string &table_name, Txn *txn);
+
+  /**
+   * Gather the statistics of a table and persist them in place of the previous ones.
+   * @return DB_FAILED if the statistics cannot be stored
+   */
+  dberr_t AnalyzeTable(const std::string &table_name, Txn *txn);
+
+  /**
+   * Empty a table by pointing it at a new heap and emptying its indexes in place. The pages of the old heap, of
+   * the old index entries and of the statistics are freed in the background.
+   */
+  dberr_t TruncateTable(const std::string &table_name, Txn *txn);
+
+  /**
+   * Set the dead tuples per heap page from which a delete schedules an auto-vacuum, 0 disables it.
+   */
+  inline void SetAutoVacuumThreshold(uint32_t threshold) { auto_vacuum_threshold_ = threshold; }
+
+  /**
+   * Queue a vacuum of the table on the background worker if enough deletes piled up in it. Looking the table up by
+   * its name waits for the vacuum, other tables stay usable meanwhile.
+   * @return true if a vacuum was queued
+   */
+  bool ScheduleAutoVacuum(const std::string &table_name);
+
+  /**
+   * Wait until no auto-vacuum of the table is queued or running.
+   */
+  void WaitForVacuum(const std::string &table_name) const;
+
  private:
   dberr_t DropTable(table_id_t table_id);
 
@@ -105,6 +147,8 @@ class CatalogManager {
 
   dberr_t GetTable(const table_id_t table_id, TableInfo *&table_info);
 
+  void VacuumTable(TableInfo *table_info, const std::vector<IndexInfo *> &indexes, Txn *txn);
+
  private:
   [[maybe_unused]] BufferPoolManager *buffer_pool_manager_;
   [[maybe_unused]] LockManager *lock_manager_;
@@ -118,6 +162,13 @@ class CatalogManager {
   // map for indexes: table_name->index_name->indexes
   std::unordered_map<std::string, std::unordered_map<std::string, index_id_t>> index_names_;
   std::unordered_map<index_id_t, IndexInfo *> indexes_;
+  uint32_t auto_vacuum_threshold_{AUTO_VACUUM_THRESHOLD};
+  // tables with an auto-vacuum queued or running
+  std::unordered_set<std::string> vacuuming_;
+  mutable std::mutex vacuum_latch_;
+  mutable std::condition_variable vacuumed_;
+  // frees the pages left behind by truncate and runs the auto-vacuums
+  BackgroundWorker reclaimer_;
 };
 
 #endif  // MINISQL_CATALOG_H
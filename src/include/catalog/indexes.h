@@ -78,6 +78,11 @@ class IndexInfo {
 
   IndexSchema *GetIndexKeySchema() { return key_schema_; }
 
+  /**
+   * @return the table column of each key column
+   */
+  inline const std::vector<uint32_t> &GetKeyMapping() const { return meta_data_->GetKeyMapping(); }
+
  private:
   explicit IndexInfo() : meta_data_{nullptr}, index_{nullptr}, key_schema_{nullptr} {}
 
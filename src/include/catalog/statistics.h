@@ -0,0 +1,110 @@
+#ifndef MINISQL_STATISTICS_H
+#define MINISQL_STATISTICS_H
+
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "record/field.h"
+#include "record/schema.h"
+#include "storage/table_heap.h"
+
+/**
+ * Statistics of a column, estimated from the rows sampled by analyze.
+ */
+class ColumnStatistics {
+  friend class TableStatistics;
+
+ public:
+  inline float GetNullFraction() const { return null_fraction_; }
+
+  /**
+   * @return the estimated number of distinct non-null values of the column over the whole table
+   */
+  inline uint64_t GetDistinctCount() const { return distinct_count_; }
+
+  /**
+   * @return the smallest sampled value, nullptr if every sampled value is null
+   */
+  inline const Field *GetMin() const { return bounds_.empty() ? nullptr : &bounds_.front(); }
+
+  /**
+   * @return the largest sampled value, nullptr if every sampled value is null
+   */
+  inline const Field *GetMax() const { return bounds_.empty() ? nullptr : &bounds_.back(); }
+
+  /**
+   * @return the bounds of the equi-depth histogram in ascending order, from the minimum to the maximum. Each bucket
+   * between two consecutive bounds holds about the same number of sampled non-null values. A char bound is cut to
+   * its first HISTOGRAM_BOUND_LENGTH bytes.
+   */
+  inline const std::vector<Field> &GetHistogramBounds() const { return bounds_; }
+
+ private:
+  float null_fraction_{0};
+  uint64_t distinct_count_{0};
+  std::vector<Field> bounds_;
+};
+
+/**
+ * Statistics of a table gathered by analyze. The row and page counts are exact, the column statistics are taken
+ * from at most ANALYZE_SAMPLE_PAGES heap pages spread evenly over the page directory.
+ */
+class TableStatistics {
+ public:
+  /**
+   * Gather the statistics of a table.
+   */
+  static TableStatistics *Collect(TableHeap *table_heap, const Schema *schema, Txn *txn);
+
+  /**
+   * Write the statistics to a new chain of statistics pages.
+   * @return the id of the first page of the chain, INVALID_PAGE_ID if the buffer pool is out of pages
+   */
+  page_id_t Store(BufferPoolManager *buffer_pool_manager) const;
+
+  /**
+   * Read the statistics back from the chain of statistics pages starting at first_page_id.
+   */
+  static TableStatistics *Load(BufferPoolManager *buffer_pool_manager, page_id_t first_page_id, const Schema *schema);
+
+  /**
+   * Return the chain of statistics pages starting at first_page_id to the disk manager.
+   */
+  static void Free(BufferPoolManager *buffer_pool_manager, page_id_t first_page_id);
+
+  uint32_t SerializeTo(char *buf) const;
+
+  uint32_t GetSerializedSize() const;
+
+  static uint32_t DeserializeFrom(char *buf, const Schema *schema, TableStatistics *&statistics);
+
+  inline uint64_t GetRowCount() const { return row_count_; }
+
+  inline uint32_t GetPageCount() const { return page_count_; }
+
+  /**
+   * @return the number of rows the column statistics were estimated from
+   */
+  inline uint64_t GetSampledRowCount() const { return sampled_row_count_; }
+
+  inline uint32_t GetColumnCount() const { return columns_.size(); }
+
+  inline const ColumnStatistics &GetColumn(uint32_t idx) const { return columns_[idx]; }
+
+ private:
+  TableStatistics() = default;
+
+  /**
+   * Fill the statistics of a column from its sampled values, nulls included. The values are reordered.
+   */
+  static void CollectColumn(std::vector<const Field *> &values, uint64_t row_count, ColumnStatistics &column);
+
+ private:
+  static constexpr uint32_t TABLE_STATISTICS_MAGIC_NUM = 520741;
+  uint64_t row_count_{0};
+  uint32_t page_count_{0};
+  uint64_t sampled_row_count_{0};
+  std::vector<ColumnStatistics> columns_;
+};
+
+#endif  // MINISQL_STATISTICS_H
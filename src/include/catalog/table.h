@@ -3,6 +3,7 @@
 
 #include <memory>
 
+#include "catalog/statistics.h"
 #include "glog/logging.h"
 #include "record/schema.h"
 #include "storage/table_heap.h"
@@ -23,6 +24,7 @@ class TableMetadata {
    * will create new table schema and owned by mem heap
    */
   static TableMetadata *Create(table_id_t table_id, std::string table_name, page_id_t root_page_id,
+                               page_id_t fsm_page_id, page_id_t dictionary_page_id, page_id_t zone_map_page_id,
                                TableSchema *schema);
 
   inline table_id_t GetTableId() const { return table_id_; }
@@ -31,18 +33,31 @@ class TableMetadata {
 
   inline uint32_t GetFirstPageId() const { return root_page_id_; }
 
+  inline page_id_t GetFsmPageId() const { return fsm_page_id_; }
+
+  inline page_id_t GetDictionaryPageId() const { return dictionary_page_id_; }
+
+  inline page_id_t GetZoneMapPageId() const { return zone_map_page_id_; }
+
+  inline page_id_t GetStatisticsPageId() const { return statistics_page_id_; }
+
   inline Schema *GetSchema() const { return schema_; }
 
  private:
   TableMetadata() = delete;
 
-  TableMetadata(table_id_t table_id, std::string table_name, page_id_t root_page_id, TableSchema *schema);
+  TableMetadata(table_id_t table_id, std::string table_name, page_id_t root_page_id, page_id_t fsm_page_id,
+                page_id_t dictionary_page_id, page_id_t zone_map_page_id, TableSchema *schema);
 
  private:
   static constexpr uint32_t TABLE_METADATA_MAGIC_NUM = 344528;
   table_id_t table_id_;
   std::string table_name_;
   page_id_t root_page_id_;
+  page_id_t fsm_page_id_;
+  page_id_t dictionary_page_id_;  // INVALID_PAGE_ID if no column is dictionary encoded
+  page_id_t zone_map_page_id_;    // INVALID_PAGE_ID if no column is zoned
+  page_id_t statistics_page_id_{INVALID_PAGE_ID};  // INVALID_PAGE_ID until the table is analyzed
   Schema *schema_;
 };
 
@@ -56,6 +71,7 @@ class TableInfo {
   ~TableInfo() {
     delete table_meta_;
     delete table_heap_;
+    delete statistics_;
   }
 
   void Init(TableMetadata *table_meta, TableHeap *table_heap) {
@@ -73,12 +89,42 @@ class TableInfo {
 
   inline page_id_t GetRootPageId() const { return table_meta_->root_page_id_; }
 
+  inline TableMetadata *GetTableMetadata() const { return table_meta_; }
+
+  /**
+   * Point the table at another heap of the same schema, recording its pages in the metadata.
+   * @return the previous heap, which the caller now owns
+   */
+  TableHeap *SwapTableHeap(TableHeap *table_heap) {
+    std::swap(table_heap_, table_heap);
+    table_meta_->root_page_id_ = table_heap_->GetFirstPageId();
+    table_meta_->fsm_page_id_ = table_heap_->GetFsmPageId();
+    table_meta_->dictionary_page_id_ = table_heap_->GetDictionaryPageId();
+    table_meta_->zone_map_page_id_ = table_heap_->GetZoneMapPageId();
+    return table_heap;
+  }
+
+  /**
+   * @return the statistics gathered by the last analyze of the table, nullptr if it was never analyzed
+   */
+  inline const TableStatistics *GetStatistics() const { return statistics_; }
+
+  /**
+   * Replace the statistics of the table, which are owned by the table info, and record their first page.
+   */
+  void SetStatistics(TableStatistics *statistics, page_id_t page_id) {
+    delete statistics_;
+    statistics_ = statistics;
+    table_meta_->statistics_page_id_ = page_id;
+  }
+
  private:
   explicit TableInfo(){};
 
  private:
   TableMetadata *table_meta_;
   TableHeap *table_heap_;
+  TableStatistics *statistics_{nullptr};
 };
 
 #endif  // MINISQL_TABLE_H
@@ -0,0 +1,62 @@
+#ifndef MINISQL_ARENA_H
+#define MINISQL_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "common/config.h"
+#include "common/macros.h"
+
+/**
+ * Bump allocator handing out memory from blocks of ARENA_BLOCK_SIZE bytes. Nothing is freed one by one: the
+ * memory is released in bulk by Reset or when the arena is destroyed, and the destructors of the objects built in
+ * it are not run unless the owner runs them. A request larger than a quarter block gets a block of its own, so
+ * big values do not waste the rest of a shared block. Not thread safe.
+ */
+class Arena {
+ public:
+  explicit Arena(size_t block_size = ARENA_BLOCK_SIZE) : block_size_(block_size) {}
+
+  DISALLOW_COPY_AND_MOVE(Arena);
+
+  /**
+   * @return size bytes aligned to align, valid until the arena is reset
+   */
+  void *Allocate(size_t size, size_t align = alignof(std::max_align_t));
+
+  /**
+   * Construct an object in the arena.
+   */
+  template <typename T, typename... Args>
+  T *New(Args &&...args) {
+    return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+  }
+
+  /**
+   * @return a copy of len bytes in the arena
+   */
+  char *CopyBytes(const char *data, size_t len);
+
+  /**
+   * Release every allocation at once, the first block is kept for reuse.
+   */
+  void Reset();
+
+  /**
+   * @return the number of bytes handed out since the last reset, alignment padding included
+   */
+  inline size_t GetAllocatedBytes() const { return allocated_; }
+
+ private:
+  size_t block_size_;
+  std::vector<std::unique_ptr<char[]>> blocks_;        // blocks of block_size_ bytes, the last one is current
+  std::vector<std::unique_ptr<char[]>> large_blocks_;  // blocks of a single large request
+  char *cursor_{nullptr};     // next free byte of the current block
+  char *block_end_{nullptr};  // end of the current block
+  size_t allocated_{0};
+};
+
+#endif  // MINISQL_ARENA_H
@@ -0,0 +1,67 @@
+#ifndef MINISQL_BACKGROUND_WORKER_H
+#define MINISQL_BACKGROUND_WORKER_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "common/bounded_queue.h"
+#include "common/macros.h"
+
+/**
+ * Thread running submitted tasks one after the other, in the order of submission. Destroying the worker runs the
+ * tasks still queued before joining the thread.
+ */
+class BackgroundWorker {
+ public:
+  explicit BackgroundWorker(size_t capacity = 64) : tasks_(capacity), thread_([this] { Run(); }) {}
+
+  ~BackgroundWorker() {
+    tasks_.Close();
+    thread_.join();
+  }
+
+  DISALLOW_COPY(BackgroundWorker);
+
+  /**
+   * Queue a task, waiting for room if capacity tasks are already queued.
+   */
+  void Submit(std::function<void()> task) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      pending_++;
+    }
+    tasks_.Push(std::move(task));
+  }
+
+  /**
+   * Wait until every task submitted so far has run.
+   */
+  void Drain() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return pending_ == 0; });
+  }
+
+ private:
+  void Run() {
+    std::function<void()> task;
+    while (tasks_.Pop(&task)) {
+      task();
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (--pending_ == 0) {
+        idle_.notify_all();
+      }
+    }
+  }
+
+ private:
+  BoundedQueue<std::function<void()>> tasks_;
+  std::mutex mutex_;
+  std::condition_variable idle_;
+  size_t pending_{0};
+  // started last, once the members it uses are constructed
+  std::thread thread_;
+};
+
+#endif  // MINISQL_BACKGROUND_WORKER_H
@@ -0,0 +1,71 @@
+#ifndef MINISQL_BOUNDED_QUEUE_H
+#define MINISQL_BOUNDED_QUEUE_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+#include "common/macros.h"
+
+/**
+ * Blocking multi-producer queue of bounded capacity. Producers wait while the queue is full and the consumer
+ * waits while it is empty, closing the queue wakes both sides up.
+ */
+template <typename T>
+class BoundedQueue {
+ public:
+  explicit BoundedQueue(size_t capacity) : capacity_(capacity) {}
+
+  DISALLOW_COPY(BoundedQueue);
+
+  /**
+   * Append an item, waiting for room.
+   * @return false if the queue was closed, the item is dropped
+   */
+  bool Push(T &&item) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_full_.wait(lock, [this] { return closed_ || items_.size() < capacity_; });
+    if (closed_) {
+      return false;
+    }
+    items_.push_back(std::move(item));
+    not_empty_.notify_one();
+    return true;
+  }
+
+  /**
+   * Take the oldest item, waiting for one to arrive.
+   * @return false once the queue is closed and drained
+   */
+  bool Pop(T *item) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_empty_.wait(lock, [this] { return closed_ || !items_.empty(); });
+    if (items_.empty()) {
+      return false;
+    }
+    *item = std::move(items_.front());
+    items_.pop_front();
+    not_full_.notify_one();
+    return true;
+  }
+
+  /**
+   * Refuse further pushes, the items already queued can still be popped.
+   */
+  void Close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    not_full_.notify_all();
+    not_empty_.notify_all();
+  }
+
+ private:
+  size_t capacity_;
+  bool closed_{false};
+  std::deque<T> items_;
+  std::mutex mutex_;
+  std::condition_variable not_full_;
+  std::condition_variable not_empty_;
+};
+
+#endif  // MINISQL_BOUNDED_QUEUE_H
@@ -16,8 +16,28 @@ static constexpr int INDEX_ROOTS_PAGE_ID = 1;   // logical page id of the index
 static constexpr int PAGE_SIZE = 4096;                  // size of a data page in byte
 static constexpr int DEFAULT_BUFFER_POOL_SIZE = 20480;  // default size of buffer pool
 
+static constexpr uint32_t AUTO_VACUUM_THRESHOLD = 0;  // default dead tuples per heap page that trigger a vacuum, 0 disables
+
+static constexpr uint32_t SCAN_MORSEL_PAGES = 32;                          // heap pages claimed by a scan worker at once
+static constexpr uint32_t PARALLEL_SCAN_MIN_PAGES = 4 * SCAN_MORSEL_PAGES;  // smaller tables are scanned serially
+static constexpr uint32_t PARALLEL_SCAN_MAX_THREADS = 8;                   // worker threads of a parallel scan
+
+static constexpr uint32_t ANALYZE_SAMPLE_PAGES = 64;    // heap pages read by analyze, spread over larger tables
+static constexpr uint32_t HISTOGRAM_BUCKETS = 16;       // buckets of the equi-depth histogram of a column
+static constexpr uint32_t HISTOGRAM_BOUND_LENGTH = 32;  // char histogram bounds keep a prefix of this length
+
+static constexpr bool ENABLE_INDEX_KEY_FILTER = true;        // probe a filter of the keys before descending an index
+static constexpr uint32_t INDEX_FILTER_COUNTERS_PER_KEY = 10;  // counters of the key filter per key it is sized for
+static constexpr uint32_t INDEX_FILTER_PROBES = 5;             // counters set by each key
+static constexpr uint32_t INDEX_FILTER_MIN_KEYS = 1024;        // smallest number of keys a filter is sized for
+
+static constexpr size_t ARENA_BLOCK_SIZE = 64 * 1024;  // bytes of a block of the allocator of a query
+
 static constexpr uint32_t FIELD_NULL_LEN = UINT32_MAX;
-static constexpr uint32_t VARCHAR_MAX_LEN = PAGE_SIZE / 2;  // max length of varchar
+static constexpr uint32_t FIELD_INLINE_LEN = 16;  // longest char value copied inside its field rather than allocated
+static constexpr uint32_t ROW_INLINE_FIELDS = 8;  // fields a row holds without allocating
+static constexpr uint32_t VARCHAR_MAX_LEN = 64 * PAGE_SIZE;  // max length of varchar
+static constexpr uint32_t OVERFLOW_THRESHOLD = PAGE_SIZE / 8;  // longer char values are stored in overflow pages
 
 // static std::string DB_META_FILE = "minisql.meta.db";
 
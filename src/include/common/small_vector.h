@@ -0,0 +1,164 @@
+#ifndef MINISQL_SMALL_VECTOR_H
+#define MINISQL_SMALL_VECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+/**
+ * Vector holding up to N elements in place and moving to the heap beyond that, so the common small sizes cost no
+ * allocation. Growing or moving the vector moves the elements and invalidates pointers to them, except for the move
+ * of a vector already on the heap which hands its buffer over.
+ */
+template <typename T, size_t N>
+class SmallVector {
+ public:
+  SmallVector() = default;
+
+  SmallVector(const SmallVector &other) {
+    reserve(other.size_);
+    for (const auto &item : other) {
+      emplace_back(item);
+    }
+  }
+
+  SmallVector(SmallVector &&other) noexcept { MoveFrom(other); }
+
+  SmallVector &operator=(const SmallVector &other) {
+    if (this != &other) {
+      clear();
+      reserve(other.size_);
+      for (const auto &item : other) {
+        emplace_back(item);
+      }
+    }
+    return *this;
+  }
+
+  SmallVector &operator=(SmallVector &&other) noexcept {
+    if (this != &other) {
+      clear();
+      Release();
+      MoveFrom(other);
+    }
+    return *this;
+  }
+
+  ~SmallVector() {
+    clear();
+    Release();
+  }
+
+  template <typename... Args>
+  T &emplace_back(Args &&...args) {
+    if (size_ < capacity_) {
+      new (data_ + size_) T(std::forward<Args>(args)...);
+    } else {
+      // build the new element first, args may refer to an element about to be moved
+      size_t capacity = std::max<size_t>(2 * capacity_, 1);
+      T *data = Allocate(capacity);
+      new (data + size_) T(std::forward<Args>(args)...);
+      Relocate(data, capacity);
+    }
+    return data_[size_++];
+  }
+
+  void push_back(T &&item) { emplace_back(std::move(item)); }
+
+  void pop_back() { data_[--size_].~T(); }
+
+  void clear() {
+    for (size_t i = 0; i < size_; i++) {
+      data_[i].~T();
+    }
+    size_ = 0;
+  }
+
+  void reserve(size_t capacity) {
+    if (capacity > capacity_) {
+      Relocate(Allocate(capacity), capacity);
+    }
+  }
+
+  inline size_t size() const { return size_; }
+
+  inline bool empty() const { return size_ == 0; }
+
+  inline size_t capacity() const { return capacity_; }
+
+  /**
+   * @return true if the elements are stored in place
+   */
+  inline bool IsInline() const { return data_ == Inline(); }
+
+  inline T &operator[](size_t idx) { return data_[idx]; }
+
+  inline const T &operator[](size_t idx) const { return data_[idx]; }
+
+  inline T &back() { return data_[size_ - 1]; }
+
+  inline T *begin() { return data_; }
+
+  inline T *end() { return data_ + size_; }
+
+  inline const T *begin() const { return data_; }
+
+  inline const T *end() const { return data_ + size_; }
+
+ private:
+  inline T *Inline() { return reinterpret_cast<T *>(inline_); }
+
+  inline const T *Inline() const { return reinterpret_cast<const T *>(inline_); }
+
+  static T *Allocate(size_t capacity) { return static_cast<T *>(::operator new(capacity * sizeof(T))); }
+
+  /**
+   * Move the elements to data and free the old heap buffer.
+   */
+  void Relocate(T *data, size_t capacity) {
+    for (size_t i = 0; i < size_; i++) {
+      new (data + i) T(std::move(data_[i]));
+      data_[i].~T();
+    }
+    Release();
+    data_ = data;
+    capacity_ = capacity;
+  }
+
+  /**
+   * Free the heap buffer of an empty vector, which goes back to its inline storage.
+   */
+  void Release() {
+    if (!IsInline()) {
+      ::operator delete(data_);
+      data_ = Inline();
+      capacity_ = N;
+    }
+  }
+
+  void MoveFrom(SmallVector &other) {
+    if (other.IsInline()) {
+      for (size_t i = 0; i < other.size_; i++) {
+        new (data_ + i) T(std::move(other.data_[i]));
+      }
+      size_ = other.size_;
+      other.clear();
+    } else {
+      data_ = other.data_;
+      size_ = other.size_;
+      capacity_ = other.capacity_;
+      other.data_ = other.Inline();
+      other.size_ = 0;
+      other.capacity_ = N;
+    }
+  }
+
+ private:
+  alignas(T) char inline_[N * sizeof(T)];
+  T *data_{Inline()};
+  size_t size_{0};
+  size_t capacity_{N};
+};
+
+#endif  // MINISQL_SMALL_VECTOR_H
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "executor/execute_context.h"
@@ -7,6 +8,7 @@
 #include "executor/plans/index_scan_plan.h"
 #include "planner/expressions/column_value_expression.h"
 #include "planner/expressions/comparison_expression.h"
+#include "record/row_view.h"
 
 /**
  * The IndexScanExecutor executor can over a table.
@@ -36,8 +38,6 @@ class IndexScanExecutor : public AbstractExecutor {
 
   bool SchemaEqual(const Schema *table_schema, const Schema *output_schema);
 
-  void TupleTransfer(const Schema *table_schema, const Schema *output_schema, const Row *row, Row *output_row);
-
  private:
   vector<RowId> IndexScan(AbstractExpressionRef predicate);
 
@@ -46,5 +46,7 @@ class IndexScanExecutor : public AbstractExecutor {
   TableInfo *table_info_{};
   vector<RowId> result_;
   size_t cursor_ = 0;
+  /** Filters the fetched tuples in place before they are materialized */
+  std::unique_ptr<RowView> view_;
   bool is_schema_same_;
 };
\ No newline at end of file
@@ -5,6 +5,8 @@
 #ifndef MINISQL_INSERT_EXECUTOR_H
 #define MINISQL_INSERT_EXECUTOR_H
 
+#include <vector>
+
 #include "executor/execute_context.h"
 #include "executor/executors/abstract_executor.h"
 #include "executor/plans/insert_plan.h"
@@ -12,7 +14,8 @@
 /**
  * InsertExecutor executes an insert on a table.
  *
- * Inserted values are always pulled from a child executor.
+ * Inserted values are always pulled from a child executor. All child rows are drained on the first call to
+ * Next() and stored through TableHeap::InsertTuples, the inserted rids are then yielded one at a time.
  */
 class InsertExecutor : public AbstractExecutor {
  public:
@@ -42,12 +45,21 @@ class InsertExecutor : public AbstractExecutor {
   const Schema *GetOutputSchema() const override { return plan_->OutputSchema(); }
 
  private:
+  /**
+   * Pull all rows from the child, stopping at the first one whose key already exists,
+   * then insert the accepted rows as one batch and maintain the indexes.
+   */
+  void InsertBatch();
+
   /** The insert plan node to be executed*/
   const InsertPlanNode *plan_;
   std::unique_ptr<AbstractExecutor> child_executor_;
   TableInfo *table_info_{};
   const Schema *schema_{};
   std::vector<IndexInfo *> index_info_;
+  std::vector<RowId> inserted_rids_;
+  size_t cursor_{0};
+  bool is_inserted_{false};
 };
 
 #endif  // MINISQL_INSERT_EXECUTOR_H
@@ -5,14 +5,26 @@
 #ifndef MINISQL_SEQ_SCAN_EXECUTOR_H
 #define MINISQL_SEQ_SCAN_EXECUTOR_H
 
+#include <atomic>
+#include <memory>
+#include <thread>
 #include <vector>
 
+#include "common/bounded_queue.h"
 #include "executor/execute_context.h"
 #include "executor/executors/abstract_executor.h"
 #include "executor/plans/seq_scan_plan.h"
+#include "record/row_view.h"
 
 /**
- * The SeqScanExecutor executor executes a sequential table scan.
+ * The SeqScanExecutor executor executes a sequential table scan. Tuples are filtered in place through a RowView
+ * while their page stays pinned, and only the ones passing the predicate are materialized.
+ *
+ * Pages whose zones cannot satisfy the predicate are skipped without being fetched, see ZoneMap.
+ *
+ * When the plan asks for more than one thread, the heap pages are split into morsels of SCAN_MORSEL_PAGES pages.
+ * Worker threads claim morsels from a shared counter, filter them locally and hand the rows of each page to Next
+ * through a bounded queue.
  */
 class SeqScanExecutor : public AbstractExecutor {
  public:
@@ -23,6 +35,8 @@ class SeqScanExecutor : public AbstractExecutor {
    */
   SeqScanExecutor(ExecuteContext *exec_ctx, const SeqScanPlanNode *plan);
 
+  ~SeqScanExecutor() override;
+
   /** Initialize the sequential scan */
   void Init() override;
 
@@ -39,15 +53,49 @@ class SeqScanExecutor : public AbstractExecutor {
 
   bool SchemaEqual(const Schema *table_schema, const Schema *output_schema);
 
-  void TupleTransfer(const Schema *table_schema, const Schema *output_schema, const Row *row, Row *output_row);
-
  private:
+  /** Rows produced from one page by a worker */
+  using Chunk = std::vector<Row>;
+
+  /**
+   * @return false if no tuple of the heap page at position index of the page directory can satisfy the predicate,
+   * judged from the zone of the page. Only comparisons of a column with a constant, combined by and / or, prune.
+   */
+  bool PageMayMatch(const AbstractExpressionRef &predicate, uint32_t index) const;
+
+  /** Pin the next page of the serial scan which may match the predicate, nullptr past the last page */
+  TablePage *FetchNextPage();
+
+  /** Start the workers of a parallel scan */
+  void StartWorkers(uint32_t thread_count);
+
+  /** Body of a worker, scans morsels until they run out or the scan is abandoned */
+  void ScanMorsels();
+
+  /** Abandon the parallel scan and wait for the workers to exit */
+  void StopWorkers();
+
+  bool NextParallel(Row *row, RowId *rid);
+
   /** The sequential scan plan node to be executed */
   const SeqScanPlanNode *plan_;
   TableInfo *table_info_{};
-  TableIterator iterator_;
+  /** The page being scanned, pinned until the scan moves past it */
+  TablePage *page_{nullptr};
+  /** Position of the following page of the serial scan in the page directory */
+  uint32_t page_index_{0};
+  RowId rid_{INVALID_ROWID};
+  std::unique_ptr<RowView> view_;
   const Schema *schema_{};
   bool is_schema_same_;
+  /** Parallel scan state, unused by a serial scan */
+  uint32_t morsel_count_{0};
+  std::atomic<uint32_t> next_morsel_{0};
+  std::atomic<uint32_t> active_workers_{0};
+  std::vector<std::thread> workers_;
+  std::unique_ptr<BoundedQueue<Chunk>> queue_;
+  Chunk chunk_;
+  size_t chunk_pos_{0};
 };
 
 #endif  // MINISQL_SEQ_SCAN_EXECUTOR_H
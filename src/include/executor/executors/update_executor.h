@@ -57,6 +57,8 @@ class UpdateExecutor : public AbstractExecutor {
   TableInfo *table_info_;
   Txn *txn_;
   std::vector<IndexInfo *> index_info_;
+  /** The indexes with a key column assigned by the update, the others keep their entries as the rid is unchanged */
+  std::vector<IndexInfo *> updated_indexes_;
   /** The child executor to obtain value from */
   std::unique_ptr<AbstractExecutor> child_executor_;
 };
@@ -29,11 +29,17 @@ class SeqScanPlanNode : public AbstractPlanNode {
 
   AbstractExpressionRef GetPredicate() const { return filter_predicate_; }
 
+  /** @return The number of worker threads scanning the table, 1 for a serial scan */
+  uint32_t GetParallelism() const { return parallelism_; }
+
   /** The table name */
   std::string table_name_;
 
   /** The predicate to filter in SeqScan.*/
   AbstractExpressionRef filter_predicate_;
+
+  /** The number of worker threads, rows come out of order when it is above 1. */
+  uint32_t parallelism_{1};
 };
 
 #endif  // MINISQL_SEQ_SCAN_PLAN_H
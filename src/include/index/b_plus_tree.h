@@ -35,8 +35,8 @@ class BPlusTree {
   // Insert a key-value pair into this B+ tree.
   bool Insert(GenericKey *key, const RowId &value, Txn *transaction = nullptr);
 
-  // Remove a key and its value from this B+ tree.
-  void Remove(const GenericKey *key, Txn *transaction = nullptr);
+  // Remove a key and its value from this B+ tree, return false if the key is not in the tree.
+  bool Remove(const GenericKey *key, Txn *transaction = nullptr);
 
   // return the value associated with a given key
   bool GetValue(const GenericKey *key, std::vector<RowId> &result, Txn *transaction = nullptr);
@@ -47,15 +47,39 @@ class BPlusTree {
 
   IndexIterator End();
 
+  // Visit every key of this B+ tree in order, walking the leaf pages.
+  template <typename Visitor>
+  void ForEachKey(Visitor &&visit) {
+    if (IsEmpty()) {
+      return;
+    }
+    Page *page = FindLeafPage(nullptr, root_page_id_, true);
+    while (true) {
+      auto leaf = reinterpret_cast<LeafPage *>(page->GetData());
+      for (int i = 0; i < leaf->GetSize(); i++) {
+        visit(leaf->KeyAt(i));
+      }
+      page_id_t next_page_id = leaf->GetNextPageId();
+      buffer_pool_manager_->UnpinPage(leaf->GetPageId(), false);
+      if (next_page_id == INVALID_PAGE_ID) {
+        break;
+      }
+      page = buffer_pool_manager_->FetchPage(next_page_id);
+    }
+  }
+
   // expose for test purpose
   Page *FindLeafPage(const GenericKey *key, page_id_t page_id = INVALID_PAGE_ID, bool leftMost = false);
 
   // used to check whether all pages are unpinned
   bool Check();
 
-  // destroy the b plus tree
+  // destroy the b plus tree, or the detached subtree rooted at current_page_id
   void Destroy(page_id_t current_page_id = INVALID_PAGE_ID);
 
+  // empty the b plus tree without freeing its pages, return the old root for Destroy
+  page_id_t Detach();
+
   void PrintTree(std::ofstream &out, Schema *schema) {
     if (IsEmpty()) {
       return;
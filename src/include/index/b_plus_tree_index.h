@@ -4,6 +4,7 @@
 #include "index/b_plus_tree.h"
 #include "index/generic_key.h"
 #include "index/index.h"
+#include "index/key_filter.h"
 
 class BPlusTreeIndex : public Index {
  public:
@@ -15,19 +16,33 @@ class BPlusTreeIndex : public Index {
 
   dberr_t ScanKey(const Row &key, std::vector<RowId> &result, Txn *txn, string compare_operator = "=") override;
 
+  bool MayContain(const Row &key) override;
+
   dberr_t Destroy() override;
 
+  page_id_t Detach() override;
+
+  void FreeDetached(page_id_t page_id) override;
+
   IndexIterator GetBeginIterator();
 
   IndexIterator GetBeginIterator(GenericKey *key);
 
   IndexIterator GetEndIterator();
 
+ protected:
+  /**
+   * Size the key filter for twice the keys of the tree and fill it from the leaves.
+   */
+  void RebuildFilter();
+
  protected:
   // comparator for key
   KeyManager processor_;
   // container
   BPlusTree container_;
+  // keys of the tree, if ENABLE_INDEX_KEY_FILTER
+  KeyFilter filter_;
 };
 
 #endif  // MINISQL_B_PLUS_TREE_INDEX_H
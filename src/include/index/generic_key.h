@@ -1,9 +1,13 @@
 #ifndef MINISQL_GENERIC_KEY_H
 #define MINISQL_GENERIC_KEY_H
 
+#include <algorithm>
+#include <cstdint>
 #include <cstring>
+#include <vector>
 
 #include "record/field.h"
+#include "record/field_kernels.h"
 #include "record/row.h"
 
 class GenericKey {
@@ -11,64 +15,307 @@ class GenericKey {
   char data[0];
 };
 
+/**
+ * Keys are stored in a memcomparable encoding, so comparing two keys is a memcmp of their bytes. Each column is a
+ * marker byte, 0 for a null which sorts before every value and 1 for a value, followed by a fixed size image of the
+ * value: a big-endian int with its sign bit flipped, a big-endian float with its sign bit flipped for a positive and
+ * every bit flipped for a negative, or chars zero padded to the column length and followed by their big-endian
+ * length. The bytes of a null are zero, so all nulls are equal.
+ *
+ * A key of a single int column, such as most primary keys, is rather held as a native integer: 4 bytes for a column
+ * which is not nullable, 8 bytes with a null as the smallest value otherwise. The pages then hold many more keys, and
+ * comparing keys or searching a page compares integers in registers.
+ */
 class KeyManager {
  public: /**/
+  enum class KeyKind { kBytes, kInt32, kInt64 };
+
   [[nodiscard]] inline GenericKey *InitKey() const {
     return (GenericKey *)malloc(key_size_);  // remember delete
   }
 
-  inline void SerializeFromKey(GenericKey *key_buf, const Row &key, Schema *schema) const {
-    // initialize to 0
-    [[maybe_unused]] uint32_t size = key.GetSerializedSize(schema);
-    ASSERT(key.GetFieldCount() == schema->GetColumnCount(), "field nums not match.");
-    ASSERT(size <= (uint32_t)key_size_, "Index key size exceed max key size.");
+  inline void SerializeFromKey(GenericKey *key_buf, const Row &key, [[maybe_unused]] Schema *schema) const {
+    ASSERT(key.GetFieldCount() == columns_.size(), "field nums not match.");
+    ASSERT(encoded_size_ <= (uint32_t)key_size_, "Index key size exceed max key size.");
     memset(key_buf->data, 0, key_size_);
-    key.SerializeTo(key_buf->data, schema);
+    char *buf = key_buf->data;
+    if (kind_ != KeyKind::kBytes) {
+      const Field *field = key.GetField(0);
+      ASSERT(kind_ == KeyKind::kInt64 || !field->IsNull(), "Null key of a column which is not nullable.");
+      if (kind_ == KeyKind::kInt32) {
+        StoreInt(FieldKernel<TypeId::kTypeInt>::Get(*field), buf);
+      } else {
+        StoreInt(field->IsNull() ? INT64_MIN : static_cast<int64_t>(FieldKernel<TypeId::kTypeInt>::Get(*field)), buf);
+      }
+      return;
+    }
+    for (uint32_t i = 0; i < columns_.size(); i++) {
+      const Field *field = key.GetField(i);
+      if (!field->IsNull()) {
+        buf[0] = 1;
+        EncodeField(*field, columns_[i], buf + 1);
+      }
+      buf += EncodedSize(columns_[i]);
+    }
   }
 
-  inline void DeserializeToKey(const GenericKey *key_buf, Row &key, Schema *schema) const {
-    [[maybe_unused]] uint32_t ofs = key.DeserializeFrom(const_cast<char *>(key_buf->data), schema);
-    ASSERT(ofs <= (uint32_t)key_size_, "Index key size exceed max key size.");
+  inline void DeserializeToKey(const GenericKey *key_buf, Row &key, [[maybe_unused]] Schema *schema) const {
+    ASSERT(key.GetFields().empty(), "Non empty field in row.");
+    const char *buf = key_buf->data;
+    if (kind_ == KeyKind::kInt32) {
+      key.AppendField(Field(TypeId::kTypeInt, LoadInt<int32_t>(buf)));
+      return;
+    } else if (kind_ == KeyKind::kInt64) {
+      auto value = LoadInt<int64_t>(buf);
+      if (value == INT64_MIN) {
+        key.AppendField(Field(TypeId::kTypeInt));
+      } else {
+        key.AppendField(Field(TypeId::kTypeInt, static_cast<int32_t>(value)));
+      }
+      return;
+    }
+    for (const auto &column : columns_) {
+      if (buf[0] == 0) {
+        key.AppendField(Field(column.type_));
+      } else {
+        DecodeField(buf + 1, column, key);
+      }
+      buf += EncodedSize(column);
+    }
   }
 
   // compare
   [[nodiscard]] inline int CompareKeys(const GenericKey *lhs, const GenericKey *rhs) const {
-    //    ASSERT(malloc_usable_size((void *)&lhs) == malloc_usable_size((void *)&rhs), "key size not match.");
-    uint32_t column_count = key_schema_->GetColumnCount();
-    Row lhs_key(INVALID_ROWID);
-    Row rhs_key(INVALID_ROWID);
-    DeserializeToKey(lhs, lhs_key, key_schema_);
-    DeserializeToKey(rhs, rhs_key, key_schema_);
-
-    for (uint32_t i = 0; i < column_count; i++) {
-      Field *lhs_value = lhs_key.GetField(i);
-      Field *rhs_value = rhs_key.GetField(i);
-
-      if (lhs_value->CompareLessThan(*rhs_value) == CmpBool::kTrue) {
-        return -1;
-      }
+    switch (kind_) {
+      case KeyKind::kInt32:
+        return CompareInts(LoadInt<int32_t>(lhs->data), LoadInt<int32_t>(rhs->data));
+      case KeyKind::kInt64:
+        return CompareInts(LoadInt<int64_t>(lhs->data), LoadInt<int64_t>(rhs->data));
+      default:
+        return memcmp(lhs->data, rhs->data, encoded_size_);
+    }
+  }
+
+  /**
+   * Search count sorted keys laid out every stride bytes from keys, as the keys of a page.
+   * @return the index of the first key not less than key
+   */
+  inline int LowerBound(const char *keys, int stride, int count, const GenericKey *key) const {
+    return Bound<false>(keys, stride, count, key);
+  }
+
+  /**
+   * @return the index of the first key greater than key
+   */
+  inline int UpperBound(const char *keys, int stride, int count, const GenericKey *key) const {
+    return Bound<true>(keys, stride, count, key);
+  }
 
-      if (lhs_value->CompareGreaterThan(*rhs_value) == CmpBool::kTrue) {
-        return 1;
+  /**
+   * @return true if a column of the key is null
+   */
+  [[nodiscard]] inline bool HasNull(const GenericKey *key) const {
+    switch (kind_) {
+      case KeyKind::kInt32:
+        return false;
+      case KeyKind::kInt64:
+        return LoadInt<int64_t>(key->data) == INT64_MIN;
+      default:
+        break;
+    }
+    const char *buf = key->data;
+    for (const auto &column : columns_) {
+      if (buf[0] == 0) {
+        return true;
       }
+      buf += EncodedSize(column);
     }
-    // equals
-    return 0;
+    return false;
   }
 
   inline int GetKeySize() const { return key_size_; }
 
-  KeyManager(const KeyManager &other) {
-    this->key_schema_ = other.key_schema_;
-    this->key_size_ = other.key_size_;
+  inline KeyKind GetKeyKind() const { return kind_; }
+
+  static KeyKind GetKeyKind(const Schema *key_schema) {
+    if (key_schema->GetColumnCount() != 1 || key_schema->GetColumn(0)->GetType() != TypeId::kTypeInt) {
+      return KeyKind::kBytes;
+    }
+    return key_schema->GetColumn(0)->IsNullable() ? KeyKind::kInt64 : KeyKind::kInt32;
+  }
+
+  /**
+   * @return the size of the encoded keys of the schema
+   */
+  static uint32_t GetEncodedSize(const Schema *key_schema) {
+    switch (GetKeyKind(key_schema)) {
+      case KeyKind::kInt32:
+        return sizeof(int32_t);
+      case KeyKind::kInt64:
+        return sizeof(int64_t);
+      default:
+        break;
+    }
+    uint32_t size = 0;
+    for (auto column : key_schema->GetColumns()) {
+      size += EncodedSize({column->GetType(), column->GetLength()});
+    }
+    return size;
   }
 
+  KeyManager(const KeyManager &other) = default;
+
   // constructor
-  KeyManager(Schema *key_schema, size_t key_size) : key_size_(key_size), key_schema_(key_schema) {}
+  KeyManager(Schema *key_schema, size_t key_size) : key_size_(key_size), key_schema_(key_schema) {
+    for (auto column : key_schema->GetColumns()) {
+      columns_.push_back({column->GetType(), column->GetLength()});
+    }
+    kind_ = GetKeyKind(key_schema);
+    encoded_size_ = GetEncodedSize(key_schema);
+  }
+
+ private:
+  struct KeyColumn {
+    TypeId type_;
+    uint32_t length_;  // maximum length of the chars
+  };
+
+  static constexpr uint32_t SIGN_BIT = 0x80000000u;
+
+  template <typename T>
+  static inline T LoadInt(const char *buf) {
+    T value;
+    memcpy(&value, buf, sizeof(T));
+    return value;
+  }
+
+  template <typename T>
+  static inline void StoreInt(T value, char *buf) {
+    memcpy(buf, &value, sizeof(T));
+  }
+
+  template <typename T>
+  static inline int CompareInts(T lhs, T rhs) {
+    return (lhs > rhs) - (lhs < rhs);
+  }
+
+  /**
+   * Branch-free binary search, each step only selects the next base by a conditional move.
+   * @param before Whether a key comes before the searched position
+   */
+  template <typename Before>
+  static inline int Search(const char *keys, int stride, int count, Before before) {
+    if (count == 0) {
+      return 0;
+    }
+    int base = 0;
+    while (count > 1) {
+      int half = count / 2;
+      base = before(keys + (base + half) * stride) ? base + half : base;
+      count -= half;
+    }
+    return base + before(keys + base * stride);
+  }
+
+  template <bool upper>
+  inline int Bound(const char *keys, int stride, int count, const GenericKey *key) const {
+    switch (kind_) {
+      case KeyKind::kInt32:
+        return IntBound<int32_t, upper>(keys, stride, count, LoadInt<int32_t>(key->data));
+      case KeyKind::kInt64:
+        return IntBound<int64_t, upper>(keys, stride, count, LoadInt<int64_t>(key->data));
+      default:
+        return Search(keys, stride, count, [this, key](const char *other) {
+          int cmp = memcmp(other, key->data, encoded_size_);
+          return upper ? cmp <= 0 : cmp < 0;
+        });
+    }
+  }
+
+  template <typename T, bool upper>
+  static inline int IntBound(const char *keys, int stride, int count, T value) {
+    return Search(keys, stride, count, [value](const char *other) {
+      return upper ? LoadInt<T>(other) <= value : LoadInt<T>(other) < value;
+    });
+  }
+
+  static inline uint32_t EncodedSize(const KeyColumn &column) {
+    return 1 + (column.type_ == TypeId::kTypeChar ? column.length_ + sizeof(uint16_t) : sizeof(uint32_t));
+  }
+
+  static inline void WriteBigEndian(uint32_t value, char *buf, uint32_t size) {
+    for (uint32_t i = 0; i < size; i++) {
+      buf[i] = static_cast<char>(value >> (8 * (size - 1 - i)));
+    }
+  }
+
+  static inline uint32_t ReadBigEndian(const char *buf, uint32_t size) {
+    uint32_t value = 0;
+    for (uint32_t i = 0; i < size; i++) {
+      value = (value << 8) | static_cast<uint8_t>(buf[i]);
+    }
+    return value;
+  }
+
+  static inline void EncodeField(const Field &field, const KeyColumn &column, char *buf) {
+    switch (column.type_) {
+      case TypeId::kTypeInt:
+        WriteBigEndian(static_cast<uint32_t>(FieldKernel<TypeId::kTypeInt>::Get(field)) ^ SIGN_BIT, buf, 4);
+        break;
+      case TypeId::kTypeFloat: {
+        // -0.0 equals 0.0
+        float value = FieldKernel<TypeId::kTypeFloat>::Get(field);
+        uint32_t bits = 0;
+        if (value != 0) {
+          memcpy(&bits, &value, sizeof(float));
+        }
+        WriteBigEndian((bits & SIGN_BIT) ? ~bits : bits | SIGN_BIT, buf, 4);
+        break;
+      }
+      case TypeId::kTypeChar: {
+        ASSERT(column.length_ <= UINT16_MAX, "Index key column too long.");
+        // the executors reject longer chars, anything else is cut to the column rather than overrun the key
+        uint32_t len = std::min(FieldKernel<TypeId::kTypeChar>::GetLength(field), column.length_);
+        memcpy(buf, FieldKernel<TypeId::kTypeChar>::GetData(field), len);
+        WriteBigEndian(len, buf + column.length_, sizeof(uint16_t));
+        break;
+      }
+      default:
+        ASSERT(false, "Unsupported key type.");
+    }
+  }
+
+  static inline void DecodeField(const char *buf, const KeyColumn &column, Row &key) {
+    switch (column.type_) {
+      case TypeId::kTypeInt:
+        key.AppendField(Field(TypeId::kTypeInt, static_cast<int32_t>(ReadBigEndian(buf, 4) ^ SIGN_BIT)));
+        break;
+      case TypeId::kTypeFloat: {
+        uint32_t bits = ReadBigEndian(buf, 4);
+        bits = (bits & SIGN_BIT) ? bits ^ SIGN_BIT : ~bits;
+        float value;
+        memcpy(&value, &bits, sizeof(float));
+        key.AppendField(Field(TypeId::kTypeFloat, value));
+        break;
+      }
+      case TypeId::kTypeChar: {
+        uint32_t len = ReadBigEndian(buf + column.length_, sizeof(uint16_t));
+        // appended as a copy, buf is usually a page
+        const Field value(TypeId::kTypeChar, const_cast<char *>(buf), len, false);
+        key.AppendField(value);
+        break;
+      }
+      default:
+        ASSERT(false, "Unsupported key type.");
+    }
+  }
 
  private:
   int key_size_;
   Schema *key_schema_;
+  std::vector<KeyColumn> columns_;
+  KeyKind kind_{KeyKind::kBytes};
+  uint32_t encoded_size_{0};
 };
 
 #endif  // MINISQL_GENERIC_KEY_H
@@ -19,8 +19,25 @@ class Index {
 
   virtual dberr_t ScanKey(const Row &key, std::vector<RowId> &result, Txn *txn, string compare_operator = "=") = 0;
 
+  /**
+   * @return false if the index definitely holds no entry of the key, an index without a filter of its keys may
+   * always hold it
+   */
+  virtual bool MayContain(const Row &) { return true; }
+
   virtual dberr_t Destroy() = 0;
 
+  /**
+   * Empty the index at once, its old entries stay on disk until FreeDetached is called with the returned page.
+   * @return INVALID_PAGE_ID if the index held no entry
+   */
+  virtual page_id_t Detach() = 0;
+
+  /**
+   * Free the entries detached by Detach, which may run alongside other use of the index.
+   */
+  virtual void FreeDetached(page_id_t page_id) = 0;
+
  protected:
   index_id_t index_id_;
   IndexSchema *key_schema_;
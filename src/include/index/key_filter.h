@@ -0,0 +1,50 @@
+#ifndef MINISQL_KEY_FILTER_H
+#define MINISQL_KEY_FILTER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "record/row.h"
+
+/**
+ * Counting bloom filter over the keys of an index, kept in memory only. It answers whether a key may be in the
+ * index without descending the tree: a miss is definite, a hit has to be checked against the tree. Each key sets
+ * INDEX_FILTER_PROBES one byte counters, which removing the key decrements again. A counter which saturates is never
+ * decremented, so the filter may only grow less selective, never report a present key as absent.
+ */
+class KeyFilter {
+ public:
+  /**
+   * Empty the filter and size it for capacity keys.
+   */
+  void Reset(uint32_t capacity);
+
+  /**
+   * Hash the fields of a key, consistently with their equality.
+   * @return false for a key with a null field, which the filter does not track
+   */
+  static bool Hash(const Row &key, uint64_t &hash);
+
+  void Add(uint64_t hash);
+
+  /**
+   * Forget a hash, which must have been added before.
+   */
+  void Remove(uint64_t hash);
+
+  /**
+   * @return false if no key of the hash was added, or all were removed
+   */
+  bool MayContain(uint64_t hash) const;
+
+  inline uint32_t GetKeyCount() const { return key_count_; }
+
+  inline uint32_t GetCapacity() const { return capacity_; }
+
+ private:
+  std::vector<uint8_t> counters_;
+  uint32_t capacity_{0};
+  uint32_t key_count_{0};
+};
+
+#endif  // MINISQL_KEY_FILTER_H
@@ -0,0 +1,80 @@
+#ifndef MINISQL_DICTIONARY_PAGE_H
+#define MINISQL_DICTIONARY_PAGE_H
+
+#include <cstdint>
+#include <cstring>
+
+#include "common/config.h"
+#include "common/macros.h"
+
+/**
+ * Dictionary page. The distinct values of the dictionary encoded columns of a table are appended to a chain of
+ * these pages in the order they were assigned their codes, so the code of a value is its position among the
+ * entries of its column.
+ *
+ * Format (size in byte):
+ *  ------------------------------------------------------------------------------------------
+ * | PageId (4) | NextPageId (4) | DataSize (4) | Column_1 (4) | Length_1 (4) | Bytes_1 | ... |
+ *  ------------------------------------------------------------------------------------------
+ */
+class DictionaryPage {
+ public:
+  void Init(page_id_t page_id) {
+    page_id_ = page_id;
+    next_page_id_ = INVALID_PAGE_ID;
+    size_ = 0;
+  }
+
+  inline page_id_t GetPageId() const { return page_id_; }
+
+  inline page_id_t GetNextPageId() const { return next_page_id_; }
+
+  inline void SetNextPageId(page_id_t next_page_id) { next_page_id_ = next_page_id; }
+
+  /**
+   * @return the number of bytes taken by the entries
+   */
+  inline uint32_t GetSize() const { return size_; }
+
+  /**
+   * Append the value of a column.
+   * @return false if the page is full
+   */
+  bool Append(uint32_t column, const char *data, uint32_t len) {
+    if (size_ + SIZE_ENTRY_HEADER + len > CAPACITY) {
+      return false;
+    }
+    MACH_WRITE_UINT32(data_ + size_, column);
+    MACH_WRITE_UINT32(data_ + size_ + sizeof(uint32_t), len);
+    memcpy(data_ + size_ + SIZE_ENTRY_HEADER, data, len);
+    size_ += SIZE_ENTRY_HEADER + len;
+    return true;
+  }
+
+  /**
+   * Read the entry at offset.
+   * @return the offset of the following entry, GetSize() past the last one
+   */
+  uint32_t GetEntry(uint32_t offset, uint32_t &column, const char *&data, uint32_t &len) const {
+    column = MACH_READ_UINT32(data_ + offset);
+    len = MACH_READ_UINT32(data_ + offset + sizeof(uint32_t));
+    data = data_ + offset + SIZE_ENTRY_HEADER;
+    return offset + SIZE_ENTRY_HEADER + len;
+  }
+
+ public:
+  static constexpr uint32_t SIZE_ENTRY_HEADER = 2 * sizeof(uint32_t);
+  static constexpr uint32_t CAPACITY = PAGE_SIZE - 2 * sizeof(page_id_t) - sizeof(uint32_t);
+
+ private:
+  page_id_t page_id_;
+  page_id_t next_page_id_;
+  uint32_t size_;
+  char data_[CAPACITY];
+};
+
+static_assert(sizeof(DictionaryPage) == PAGE_SIZE, "Dictionary page size mismatch.");
+static_assert(DictionaryPage::SIZE_ENTRY_HEADER + OVERFLOW_THRESHOLD <= DictionaryPage::CAPACITY,
+              "An encoded value must fit in a dictionary page.");
+
+#endif  // MINISQL_DICTIONARY_PAGE_H
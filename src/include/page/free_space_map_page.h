@@ -0,0 +1,88 @@
+#ifndef MINISQL_FREE_SPACE_MAP_PAGE_H
+#define MINISQL_FREE_SPACE_MAP_PAGE_H
+
+#include <cstdint>
+
+#include "common/config.h"
+
+/**
+ * Free space map page. Every table heap owns a chain of these pages, which doubles as its page directory: it lists
+ * each heap page in chain order together with a one-byte bucket of the space still available for a new tuple
+ * (free bytes / BUCKET_SIZE, rounded down) and the number of visible tuples in the page. A page found through
+ * the map is guaranteed to fit the requested tuple, and the Nth heap page is entry N % MAX_ENTRY_COUNT of the
+ * (N / MAX_ENTRY_COUNT)th map page.
+ *
+ * Format (size in byte):
+ *  ----------------------------------------------------------------------------------
+ * | PageId (4) | NextPageId (4) | EntryCount (4) | HeapPageId_1 (4) | ... |
+ *  ----------------------------------------------------------------------------------
+ * | TupleCount_1 (2) | ... | Bucket_1 (1) | ... |
+ *  ----------------------------------------------------------------------------------
+ */
+class FreeSpaceMapPage {
+ public:
+  void Init(page_id_t page_id) {
+    page_id_ = page_id;
+    next_page_id_ = INVALID_PAGE_ID;
+    count_ = 0;
+  }
+
+  inline page_id_t GetPageId() const { return page_id_; }
+
+  inline page_id_t GetNextPageId() const { return next_page_id_; }
+
+  inline void SetNextPageId(page_id_t next_page_id) { next_page_id_ = next_page_id; }
+
+  inline uint32_t GetEntryCount() const { return count_; }
+
+  inline bool IsFull() const { return count_ == MAX_ENTRY_COUNT; }
+
+  inline page_id_t GetHeapPageId(uint32_t index) const { return heap_page_ids_[index]; }
+
+  /**
+   * @return a lower bound of the free bytes recorded for the entry
+   */
+  inline uint32_t GetFreeSpace(uint32_t index) const { return buckets_[index] * BUCKET_SIZE; }
+
+  /**
+   * @return the number of visible tuples recorded for the entry
+   */
+  inline uint32_t GetTupleCount(uint32_t index) const { return tuple_counts_[index]; }
+
+  /**
+   * Append a heap page to the map.
+   * @return false if the page is full
+   */
+  bool Append(page_id_t heap_page_id, uint32_t free_space, uint32_t tuple_count);
+
+  /**
+   * Record the free space and tuple count of an entry.
+   * @return true if the stored entry changed, i.e. the page needs to be written back
+   */
+  bool Update(uint32_t index, uint32_t free_space, uint32_t tuple_count);
+
+  /**
+   * Find the first entry at or after start which can hold a tuple of the given size.
+   * @return the entry index, or -1 if there is none
+   */
+  int FindFreeEntry(uint32_t tuple_size, uint32_t start = 0) const;
+
+  static inline uint8_t ToBucket(uint32_t free_space) { return static_cast<uint8_t>(free_space / BUCKET_SIZE); }
+
+ public:
+  static constexpr uint32_t BUCKET_SIZE = PAGE_SIZE / 256;
+  static constexpr uint32_t MAX_ENTRY_COUNT =
+      (PAGE_SIZE - 3 * sizeof(uint32_t)) / (sizeof(page_id_t) + sizeof(uint16_t) + sizeof(uint8_t));
+
+ private:
+  page_id_t page_id_;
+  page_id_t next_page_id_;
+  uint32_t count_;
+  page_id_t heap_page_ids_[MAX_ENTRY_COUNT];
+  uint16_t tuple_counts_[MAX_ENTRY_COUNT];
+  uint8_t buckets_[MAX_ENTRY_COUNT];
+};
+
+static_assert(sizeof(FreeSpaceMapPage) <= PAGE_SIZE, "Free space map page overflows.");
+
+#endif  // MINISQL_FREE_SPACE_MAP_PAGE_H
@@ -0,0 +1,48 @@
+#ifndef MINISQL_OVERFLOW_PAGE_H
+#define MINISQL_OVERFLOW_PAGE_H
+
+#include <cstdint>
+
+#include "common/config.h"
+
+/**
+ * Overflow page. A char value too long to be kept inline in its tuple is split over a chain of these pages.
+ *
+ * Format (size in byte):
+ *  ------------------------------------------------------------
+ * | PageId (4) | NextPageId (4) | DataSize (4) | Data ... |
+ *  ------------------------------------------------------------
+ */
+class OverflowPage {
+ public:
+  void Init(page_id_t page_id) {
+    page_id_ = page_id;
+    next_page_id_ = INVALID_PAGE_ID;
+    size_ = 0;
+  }
+
+  inline page_id_t GetPageId() const { return page_id_; }
+
+  inline page_id_t GetNextPageId() const { return next_page_id_; }
+
+  inline void SetNextPageId(page_id_t next_page_id) { next_page_id_ = next_page_id; }
+
+  inline uint32_t GetSize() const { return size_; }
+
+  inline void SetSize(uint32_t size) { size_ = size; }
+
+  inline char *GetBytes() { return data_; }
+
+ public:
+  static constexpr uint32_t CAPACITY = PAGE_SIZE - 2 * sizeof(page_id_t) - sizeof(uint32_t);
+
+ private:
+  page_id_t page_id_;
+  page_id_t next_page_id_;
+  uint32_t size_;
+  char data_[CAPACITY];
+};
+
+static_assert(sizeof(OverflowPage) == PAGE_SIZE, "Overflow page size mismatch.");
+
+#endif  // MINISQL_OVERFLOW_PAGE_H
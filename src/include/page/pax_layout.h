@@ -0,0 +1,68 @@
+#ifndef MINISQL_PAX_LAYOUT_H
+#define MINISQL_PAX_LAYOUT_H
+
+#include <cstdint>
+#include <vector>
+
+#include "record/schema.h"
+
+/**
+ * Placement of the minipages of a table page in the PAX layout. Each column owns a null bitmap of capacity bits
+ * followed by capacity values of a fixed width, a value is kept the way it is serialized in a row with chars
+ * padded to the declared length. The values of a column are thus read at a fixed stride without touching the
+ * other columns. Every minipage starts on an 8 byte boundary.
+ *  ---------------------------------------------------------------------------
+ * | Header | Nulls_1 | Values_1 | Nulls_2 | Values_2 | ... | Nulls_N | Values_N |
+ *  ---------------------------------------------------------------------------
+ */
+class PaxLayout {
+ public:
+  /**
+   * @param begin Offset in the page of the first minipage
+   */
+  PaxLayout(const Schema *schema, uint32_t capacity, uint32_t begin);
+
+  /**
+   * @return the number of rows of the schema fitting in the page after begin, at most max_capacity; 0 if some
+   * column cannot be stored at a fixed width
+   */
+  static uint32_t GetMaxCapacity(const Schema *schema, uint32_t begin, uint32_t max_capacity);
+
+  /**
+   * @return the width of a value of the column, 0 if the column cannot be stored at a fixed width
+   */
+  static uint32_t GetValueSize(const Column *column);
+
+  inline uint32_t GetCapacity() const { return capacity_; }
+
+  inline bool IsNull(const char *page_data, uint32_t column, uint32_t slot) const {
+    return (page_data[null_offsets_[column] + slot / 8] & (1 << (slot % 8))) != 0;
+  }
+
+  inline void SetNull(char *page_data, uint32_t column, uint32_t slot, bool is_null) const {
+    char &byte = page_data[null_offsets_[column] + slot / 8];
+    byte = static_cast<char>(is_null ? byte | (1 << (slot % 8)) : byte & ~(1 << (slot % 8)));
+  }
+
+  /**
+   * @return the offset in the page of the value of column for the row in slot
+   */
+  inline uint32_t GetValueOffset(uint32_t column, uint32_t slot) const {
+    return value_offsets_[column] + slot * value_sizes_[column];
+  }
+
+ private:
+  /**
+   * Lay out the minipages for capacity rows, recording their offsets in layout unless it is nullptr.
+   * @return the offset past the last minipage, 0 if some column cannot be stored at a fixed width
+   */
+  static uint32_t Place(const Schema *schema, uint32_t capacity, uint32_t begin, PaxLayout *layout);
+
+ private:
+  uint32_t capacity_;
+  std::vector<uint32_t> null_offsets_;
+  std::vector<uint32_t> value_offsets_;
+  std::vector<uint32_t> value_sizes_;
+};
+
+#endif  // MINISQL_PAX_LAYOUT_H
@@ -0,0 +1,52 @@
+#ifndef MINISQL_STATISTICS_PAGE_H
+#define MINISQL_STATISTICS_PAGE_H
+
+#include <cstdint>
+
+#include "common/config.h"
+
+/**
+ * Statistics page. The statistics gathered by analyze for a table are serialized and split over a chain of these
+ * pages, the first of which is recorded in the metadata of the table.
+ *
+ * Format (size in byte):
+ *  -----------------------------------------------------------
+ * | PageId (4) | NextPageId (4) | DataSize (4) | Bytes ...    |
+ *  -----------------------------------------------------------
+ */
+class StatisticsPage {
+ public:
+  void Init(page_id_t page_id) {
+    page_id_ = page_id;
+    next_page_id_ = INVALID_PAGE_ID;
+    size_ = 0;
+  }
+
+  inline page_id_t GetPageId() const { return page_id_; }
+
+  inline page_id_t GetNextPageId() const { return next_page_id_; }
+
+  inline void SetNextPageId(page_id_t next_page_id) { next_page_id_ = next_page_id; }
+
+  /**
+   * @return the number of bytes of the serialized statistics held by this page
+   */
+  inline uint32_t GetSize() const { return size_; }
+
+  inline void SetSize(uint32_t size) { size_ = size; }
+
+  inline char *GetData() { return data_; }
+
+ public:
+  static constexpr uint32_t CAPACITY = PAGE_SIZE - 2 * sizeof(page_id_t) - sizeof(uint32_t);
+
+ private:
+  page_id_t page_id_;
+  page_id_t next_page_id_;
+  uint32_t size_;
+  char data_[CAPACITY];
+};
+
+static_assert(sizeof(StatisticsPage) == PAGE_SIZE, "Statistics page size mismatch.");
+
+#endif  // MINISQL_STATISTICS_PAGE_H
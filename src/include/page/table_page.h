@@ -12,9 +12,24 @@
  *  ----------------------------------------------------------------------------
  *  | PageId (4)| LSN (4)| PrevPageId (4)| NextPageId (4)| FreeSpacePointer(4) |
  *  ----------------------------------------------------------------------------
- *  ----------------------------------------------------------------
- *  | TupleCount (4) | Tuple_1 offset (4) | Tuple_1 size (4) | ... |
- *  ----------------------------------------------------------------
+ *  ---------------------------------------------------------------------------------
+ *  | TupleCount (4) | FreeSlotBitmap (40) | LiveSlotBitmap (40) | PaxCapacity (4) |
+ *  ---------------------------------------------------------------------------------
+ *  ------------------------------------------------
+ *  | Tuple_1 offset (4) | Tuple_1 size (4) | ... |
+ *  ------------------------------------------------
+ *
+ *  A set bit in FreeSlotBitmap marks an empty slot that can be reused by an insert, a set bit in
+ *  LiveSlotBitmap marks a slot holding a visible (not deleted) tuple. Both are scanned a word at a time.
+ *
+ *  A tuple that outgrew its page is relocated to another page and its slot keeps a forwarding stub holding the
+ *  RowId of the relocated tuple, so the RowId of the tuple never changes. The stub is visible in place of the tuple,
+ *  while the relocated tuple is neither free nor live and is only reached through its stub. A stub always points at
+ *  the tuple itself, never at another stub.
+ *
+ *  A page with a non zero PaxCapacity stores its tuples column by column instead (see PaxLayout): the slot array
+ *  and free space pointer are unused, a slot is a row number in the minipages and a slot that is neither free nor
+ *  live holds a tuple marked deleted.
  **/
 
 #include <cstring>
@@ -24,12 +39,16 @@
 #include "concurrency/lock_manager.h"
 #include "concurrency/txn.h"
 #include "page/page.h"
+#include "page/pax_layout.h"
 #include "record/row.h"
 #include "recovery/log_manager.h"
 
 class TablePage : public Page {
  public:
-  void Init(page_id_t page_id, page_id_t prev_id, LogManager *log_mgr, Txn *txn);
+  /**
+   * @param pax_capacity 0 to store tuples row by row, otherwise the number of rows of the PAX minipages
+   */
+  void Init(page_id_t page_id, page_id_t prev_id, LogManager *log_mgr, Txn *txn, uint32_t pax_capacity = 0);
 
   page_id_t GetTablePageId() { return *reinterpret_cast<page_id_t *>(GetData()); }
 
@@ -45,8 +64,33 @@ class TablePage : public Page {
     memcpy(GetData() + OFFSET_NEXT_PAGE_ID, &next_page_id, sizeof(page_id_t));
   }
 
+  /**
+   * @return the number of rows of a PAX page, 0 for a page storing tuples row by row
+   */
+  uint32_t GetPaxCapacity() { return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_PAX_CAPACITY); }
+
+  bool IsPax() { return GetPaxCapacity() != 0; }
+
+  /**
+   * @return the minipages of this PAX page for the given schema
+   */
+  PaxLayout GetPaxLayout(const Schema *schema) { return PaxLayout(schema, GetPaxCapacity(), SIZE_TABLE_PAGE_HEADER); }
+
+  /**
+   * @return the number of rows of the schema a PAX page holds, 0 if the schema cannot be stored column by column
+   */
+  static uint32_t GetMaxPaxCapacity(const Schema *schema) {
+    return PaxLayout::GetMaxCapacity(schema, SIZE_TABLE_PAGE_HEADER, MAX_SLOT_COUNT);
+  }
+
   bool InsertTuple(Row &row, Schema *schema, Txn *txn, LockManager *lock_manager, LogManager *log_manager);
 
+  /**
+   * Insert a row whose serialized size has already been computed by the caller.
+   */
+  bool InsertTuple(Row &row, uint32_t serialized_size, Schema *schema, Txn *txn, LockManager *lock_manager,
+                   LogManager *log_manager);
+
   bool MarkDelete(const RowId &rid, Txn *txn, LockManager *lock_manager, LogManager *log_manager);
 
   bool UpdateTuple(Row &new_row, Row *old_row, Schema *schema, Txn *txn, LockManager *lock_manager,
@@ -58,10 +102,122 @@ class TablePage : public Page {
 
   bool GetTuple(Row *row, Schema *schema, Txn *txn, LockManager *lock_manager);
 
+  /**
+   * Insert a tuple relocated from the slot of a forwarding stub, the tuple is stored but not visible.
+   */
+  bool InsertRelocatedTuple(Row &row, Schema *schema);
+
+  /**
+   * Replace the tuple or forwarding stub in a visible slot with a forwarding stub to target.
+   * @param[out] old_row The replaced tuple, left untouched when a stub is replaced
+   * @return false if the stub does not fit
+   */
+  bool SetForward(uint32_t slot_num, const RowId &target, Row *old_row, Schema *schema);
+
+  /**
+   * Store the tuple back in the visible slot of its forwarding stub.
+   * @return false if the tuple does not fit
+   */
+  bool ClearForward(uint32_t slot_num, Row &row, Schema *schema);
+
+  /**
+   * @return true if the slot holds a forwarding stub, visible or marked deleted
+   */
+  bool IsForwarded(uint32_t slot_num) {
+    return !IsPax() && slot_num < GetTupleCount() && (GetTupleSize(slot_num) & FORWARD_MASK) != 0;
+  }
+
+  /**
+   * @return the RowId of the tuple a forwarding stub points at
+   */
+  RowId GetForwardRid(uint32_t slot_num) {
+    ASSERT(IsForwarded(slot_num), "Slot holds no forwarding stub.");
+    const char *stub = GetData() + GetTupleOffsetAtSlot(slot_num);
+    return RowId(MACH_READ_FROM(page_id_t, stub), MACH_READ_UINT32(stub + sizeof(page_id_t)));
+  }
+
+  /**
+   * @return true if some slot holds a forwarding stub or a relocated tuple
+   */
+  bool HasForwarding();
+
+  /**
+   * Read the tuple in slot_num of a PAX page, the layout being computed once by the caller for a whole page.
+   */
+  void ReadPaxTuple(const PaxLayout &layout, uint32_t slot_num, Row *row, Schema *schema);
+
+  /**
+   * @param include_deleted true to also return a tuple marked deleted but not yet applied
+   * @return the serialized tuple in the slot, nullptr if the slot holds no visible tuple, holds a forwarding stub or
+   * the page is PAX. A relocated tuple is returned.
+   */
+  char *GetTupleData(uint32_t slot_num, bool include_deleted = false) {
+    if (IsPax() || slot_num >= GetTupleCount() || GetTupleSize(slot_num) == 0 ||
+        (!include_deleted && IsDeleted(GetTupleSize(slot_num))) || IsForwarded(slot_num)) {
+      return nullptr;
+    }
+    return GetData() + GetTupleOffsetAtSlot(slot_num);
+  }
+
+  /**
+   * @return true if the slot holds a visible tuple, in either layout
+   */
+  bool IsTupleVisible(uint32_t slot_num) {
+    return slot_num < GetTupleCount() && TestSlotBit(GetLiveSlotBitmap(), slot_num);
+  }
+
+  /**
+   * @return the number of slots in the slot array, including empty ones
+   */
+  uint32_t GetSlotCount() { return GetTupleCount(); }
+
   bool GetFirstTupleRid(RowId *first_rid);
 
   bool GetNextTupleRid(const RowId &cur_rid, RowId *next_rid);
 
+  /**
+   * Apply every pending delete and pack the remaining tuples against the end of the page in one pass,
+   * trailing empty slots are dropped from the slot array.
+   * @return the number of deletes applied
+   */
+  uint32_t Compact(Txn *txn, LogManager *log_manager);
+
+  /**
+   * @return the number of visible tuples in this page
+   */
+  uint32_t GetLiveTupleCount();
+
+  /**
+   * @return the bytes taken by tuple data, including tuples marked deleted; 0 for a PAX page
+   */
+  uint32_t GetTupleDataSize() { return PAGE_SIZE - GetFreeSpacePointer(); }
+
+  /**
+   * @return true if tuple_count tuples of data_size bytes in total are guaranteed to fit into new slots
+   */
+  bool HasRoomFor(uint32_t tuple_count, uint32_t data_size) {
+    if (IsPax()) {
+      return GetPaxFreeSlotCount() >= tuple_count;
+    }
+    return GetTupleCount() + tuple_count <= MAX_SLOT_COUNT &&
+           GetFreeSpaceRemaining() >= data_size + SIZE_TUPLE * tuple_count;
+  }
+
+  /**
+   * @return the size of the largest tuple that can still be inserted into this page
+   */
+  uint32_t GetMaxInsertSize() {
+    if (IsPax()) {
+      // every row of the schema fits into a free slot
+      return GetPaxFreeSlotCount() > 0 ? SIZE_MAX_ROW : 0;
+    }
+    uint32_t remaining = GetFreeSpaceRemaining();
+    if (FindNextSetBit(GetFreeSlotBitmap(), 0, GetTupleCount()) < GetTupleCount()) {
+      return remaining;
+    }
+    return remaining > SIZE_TUPLE && GetTupleCount() < MAX_SLOT_COUNT ? remaining - SIZE_TUPLE : 0;
+  }
+
  private:
   uint32_t GetFreeSpacePointer() { return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_FREE_SPACE); }
 
@@ -93,23 +249,87 @@ class TablePage : public Page {
     memcpy(GetData() + OFFSET_TUPLE_SIZE + SIZE_TUPLE * slot_num, &size, sizeof(uint32_t));
   }
 
+  uint64_t *GetFreeSlotBitmap() { return reinterpret_cast<uint64_t *>(GetData() + OFFSET_FREE_SLOT_BITMAP); }
+
+  uint64_t *GetLiveSlotBitmap() { return reinterpret_cast<uint64_t *>(GetData() + OFFSET_LIVE_SLOT_BITMAP); }
+
+  static void SetSlotBit(uint64_t *bitmap, uint32_t slot_num) { bitmap[slot_num / 64] |= 1ULL << (slot_num % 64); }
+
+  static bool TestSlotBit(const uint64_t *bitmap, uint32_t slot_num) {
+    return (bitmap[slot_num / 64] & (1ULL << (slot_num % 64))) != 0;
+  }
+
+  static void ClearSlotBit(uint64_t *bitmap, uint32_t slot_num) {
+    bitmap[slot_num / 64] &= ~(1ULL << (slot_num % 64));
+  }
+
+  /**
+   * @return the first set bit at or after from and before limit, or limit if there is none
+   */
+  static uint32_t FindNextSetBit(const uint64_t *bitmap, uint32_t from, uint32_t limit);
+
+  uint32_t GetPaxFreeSlotCount();
+
+  bool InsertPaxTuple(Row &row, Schema *schema);
+
+  bool MarkPaxDelete(uint32_t slot_num);
+
+  bool UpdatePaxTuple(Row &new_row, Row *old_row, Schema *schema);
+
+  void ApplyPaxDelete(uint32_t slot_num);
+
+  void RollbackPaxDelete(uint32_t slot_num);
+
+  uint32_t CompactPax();
+
+  /**
+   * Resize the tuple in a slot, shifting the tuples stored below it. The flags of the slot are kept.
+   * @return the new bytes of the tuple, to be overwritten by the caller; nullptr if there is not enough space
+   */
+  char *ResizeTuple(uint32_t slot_num, uint32_t new_size);
+
+  /**
+   * Copy the values of the row into the minipages at slot_num.
+   * @return false if a char value is longer than its column
+   */
+  bool WritePaxTuple(const PaxLayout &layout, uint32_t slot_num, Row &row, Schema *schema);
+
+
   static bool IsDeleted(uint32_t tuple_size) { return static_cast<bool>(tuple_size & DELETE_MASK) || tuple_size == 0; }
 
+  /**
+   * @return the number of bytes of a tuple, without the flags of its slot
+   */
+  static uint32_t GetBytes(uint32_t tuple_size) { return static_cast<uint32_t>(tuple_size & SIZE_MASK); }
+
   static uint32_t SetDeletedFlag(uint32_t tuple_size) { return static_cast<uint32_t>(tuple_size | DELETE_MASK); }
 
   static uint32_t UnsetDeletedFlag(uint32_t tuple_size) { return static_cast<uint32_t>(tuple_size & (~DELETE_MASK)); }
 
+ public:
+  /** Slots tracked by the slot bitmaps, enough for tuples down to 5 bytes. */
+  static constexpr uint32_t MAX_SLOT_COUNT = 320;
+
  private:
   static_assert(sizeof(page_id_t) == 4);
+  static_assert(MAX_SLOT_COUNT % 64 == 0);
   static constexpr uint64_t DELETE_MASK = (1U << (8 * sizeof(uint32_t) - 1));
-  static constexpr size_t SIZE_TABLE_PAGE_HEADER = 24;
+  static constexpr uint64_t FORWARD_MASK = DELETE_MASK >> 1;   // the slot holds a forwarding stub
+  static constexpr uint64_t RELOCATED_MASK = DELETE_MASK >> 2;  // the slot holds a tuple reached through a stub
+  static constexpr uint64_t SIZE_MASK = RELOCATED_MASK - 1;
+  static constexpr uint32_t SIZE_FORWARD_STUB = sizeof(page_id_t) + sizeof(uint32_t);
+  static constexpr size_t SIZE_SLOT_BITMAP = MAX_SLOT_COUNT / 8;
+  static constexpr size_t SIZE_TABLE_PAGE_HEADER = 24 + 2 * SIZE_SLOT_BITMAP + 4;
   static constexpr size_t SIZE_TUPLE = 8;
   static constexpr size_t OFFSET_PREV_PAGE_ID = 8;
   static constexpr size_t OFFSET_NEXT_PAGE_ID = 12;
   static constexpr size_t OFFSET_FREE_SPACE = 16;
   static constexpr size_t OFFSET_TUPLE_COUNT = 20;
-  static constexpr size_t OFFSET_TUPLE_OFFSET = 24;
-  static constexpr size_t OFFSET_TUPLE_SIZE = 28;
+  static constexpr size_t OFFSET_FREE_SLOT_BITMAP = 24;
+  static constexpr size_t OFFSET_LIVE_SLOT_BITMAP = OFFSET_FREE_SLOT_BITMAP + SIZE_SLOT_BITMAP;
+  static constexpr size_t OFFSET_PAX_CAPACITY = OFFSET_LIVE_SLOT_BITMAP + SIZE_SLOT_BITMAP;
+  static constexpr size_t OFFSET_TUPLE_OFFSET = SIZE_TABLE_PAGE_HEADER;
+  static constexpr size_t OFFSET_TUPLE_SIZE = SIZE_TABLE_PAGE_HEADER + 4;
 
  public:
   static constexpr size_t SIZE_MAX_ROW = PAGE_SIZE - SIZE_TABLE_PAGE_HEADER - SIZE_TUPLE;
@@ -0,0 +1,54 @@
+#ifndef MINISQL_ZONE_MAP_PAGE_H
+#define MINISQL_ZONE_MAP_PAGE_H
+
+#include <cstdint>
+
+#include "common/config.h"
+
+/**
+ * Zone map page. The zones of a table heap are stored in a chain of these pages in the order of the page
+ * directory, a zone being the minimum and maximum of each zoned column over one heap page. Zones have the same
+ * size throughout the chain, so the Nth zone is zone N % capacity of the (N / capacity)th page.
+ *
+ * Format (size in byte):
+ *  -----------------------------------------------------------------------------------------------
+ * | PageId (4) | NextPageId (4) | ZoneCount (4) | Min_1_1 (4) | Max_1_1 (4) | Min_1_2 (4) | ... |
+ *  -----------------------------------------------------------------------------------------------
+ */
+class ZoneMapPage {
+ public:
+  void Init(page_id_t page_id) {
+    page_id_ = page_id;
+    next_page_id_ = INVALID_PAGE_ID;
+    count_ = 0;
+  }
+
+  inline page_id_t GetPageId() const { return page_id_; }
+
+  inline page_id_t GetNextPageId() const { return next_page_id_; }
+
+  inline void SetNextPageId(page_id_t next_page_id) { next_page_id_ = next_page_id; }
+
+  inline uint32_t GetZoneCount() const { return count_; }
+
+  inline void SetZoneCount(uint32_t count) { count_ = count; }
+
+  /**
+   * @param zone_words Number of 4 byte words taken by a zone
+   * @return the words of the zone at index
+   */
+  inline uint32_t *GetZone(uint32_t index, uint32_t zone_words) { return words_ + index * zone_words; }
+
+ public:
+  static constexpr uint32_t CAPACITY_WORDS = (PAGE_SIZE - 2 * sizeof(page_id_t) - sizeof(uint32_t)) / 4;
+
+ private:
+  page_id_t page_id_;
+  page_id_t next_page_id_;
+  uint32_t count_;
+  uint32_t words_[CAPACITY_WORDS];
+};
+
+static_assert(sizeof(ZoneMapPage) == PAGE_SIZE, "Zone map page size mismatch.");
+
+#endif  // MINISQL_ZONE_MAP_PAGE_H
@@ -25,16 +25,28 @@ class ColumnValueExpression : public AbstractExpression {
   ColumnValueExpression(uint32_t row_idx, uint32_t col_idx, TypeId ret_type)
       : AbstractExpression({}, ret_type, ExpressionType::ColumnExpression), row_idx_{row_idx}, col_idx_{col_idx} {}
 
-  Field Evaluate(const Row *row) const override { return Field(*row->GetField(col_idx_)); }
+  Field Evaluate(const Row *row) const override { return Reference(*row->GetField(col_idx_)); }
+
+  Field Evaluate(const RowView &row) const override { return row.GetField(col_idx_); }
 
   Field EvaluateJoin(const Row *left_row, const Row *right_row) const override {
-    return row_idx_ == 0 ? Field(*left_row->GetField(col_idx_)) : Field(*right_row->GetField(col_idx_));
+    return Reference(*(row_idx_ == 0 ? left_row : right_row)->GetField(col_idx_));
   }
 
   uint32_t GetRowIdx() const { return row_idx_; }
   uint32_t GetColIdx() const { return col_idx_; }
 
  private:
+  /**
+   * @return the value of a field without copying its char data, valid as long as the row evaluated
+   */
+  static Field Reference(const Field &field) {
+    if (field.GetTypeId() != TypeId::kTypeChar || field.IsNull()) {
+      return Field(field);
+    }
+    return Field(TypeId::kTypeChar, const_cast<char *>(field.GetData()), field.GetLength(), false);
+  }
+
   /** Row index 0 = left side of join, row index 1 = right side of join */
   uint32_t row_idx_;
   /** Column index refers to the index within the schema of the row, e.g. schema {A,B,C} has indexes {0,1,2} */
@@ -8,6 +8,9 @@
 #include <utility>
 
 #include "abstract_expression.h"
+#include "column_value_expression.h"
+#include "constant_value_expression.h"
+#include "record/field_kernels.h"
 #include "record/schema.h"
 
 /**
@@ -18,7 +21,15 @@ class ComparisonExpression : public AbstractExpression {
   /** Creates a new comparison expression representing (left comp_type right). */
   ComparisonExpression(AbstractExpressionRef left, AbstractExpressionRef right, string comp_type)
       : AbstractExpression({std::move(left), std::move(right)}, TypeId::kTypeInt, ExpressionType::ComparisonExpression),
-        comp_type_{std::move(comp_type)} {}
+        comp_type_{std::move(comp_type)},
+        op_{ParseCmpOp(comp_type_)} {
+    // operands of one known type are compared by a kernel of that type, selected once here
+    TypeId type = GetChildAt(0)->GetReturnType();
+    if (type == GetChildAt(1)->GetReturnType()) {
+      kernel_ = GetCompareKernel(type, op_);
+      kernel_type_ = type;
+    }
+  }
 
   /** e.g. evaluate the result of id = 1 */
   Field Evaluate(const Row *row) const override {
@@ -27,6 +38,16 @@ class ComparisonExpression : public AbstractExpression {
     return Field(kTypeInt, PerformComparison(lhs, rhs));
   }
 
+  Field Evaluate(const RowView &row) const override {
+    CmpBool result;
+    if (EvaluateEncoded(row, result)) {
+      return Field(kTypeInt, result);
+    }
+    Field lhs = GetChildAt(0)->Evaluate(row);
+    Field rhs = GetChildAt(1)->Evaluate(row);
+    return Field(kTypeInt, PerformComparison(lhs, rhs));
+  }
+
   Field EvaluateJoin(const Row *left_row, const Row *right_row) const override {
     Field lhs = GetChildAt(0)->EvaluateJoin(left_row, right_row);
     Field rhs = GetChildAt(1)->EvaluateJoin(left_row, right_row);
@@ -35,29 +56,45 @@ class ComparisonExpression : public AbstractExpression {
 
   std::string GetComparisonType() { return comp_type_; }
 
+  inline CmpOp GetCmpOp() const { return op_; }
+
  private:
+  /**
+   * Decide the equality of a dictionary encoded column with a char constant on codes, without decoding the column.
+   * @return false if the comparison is not of that form
+   */
+  bool EvaluateEncoded(const RowView &row, CmpBool &result) const {
+    if (op_ != CmpOp::kEqual && op_ != CmpOp::kNotEqual) {
+      return false;
+    }
+    uint32_t column = GetChildAt(0)->GetType() == ExpressionType::ColumnExpression ? 0 : 1;
+    if (GetChildAt(column)->GetType() != ExpressionType::ColumnExpression ||
+        GetChildAt(1 - column)->GetType() != ExpressionType::ConstantExpression) {
+      return false;
+    }
+    uint32_t col_idx = static_cast<const ColumnValueExpression *>(GetChildAt(column).get())->GetColIdx();
+    const Field &value = static_cast<const ConstantValueExpression *>(GetChildAt(1 - column).get())->val_;
+    if (!row.IsEncoded(col_idx) || value.GetTypeId() != kTypeChar) {
+      return false;
+    }
+    result = row.CompareEncoded(col_idx, value);
+    if (op_ == CmpOp::kNotEqual && result != CmpBool::kNull) {
+      result = result == CmpBool::kTrue ? CmpBool::kFalse : CmpBool::kTrue;
+    }
+    return true;
+  }
+
   CmpBool PerformComparison(const Field &lhs, const Field &rhs) const {
-    if (comp_type_ == "=")
-      return lhs.CompareEquals(rhs);
-    else if (comp_type_ == "<>")
-      return lhs.CompareNotEquals(rhs);
-    else if (comp_type_ == "<")
-      return lhs.CompareLessThan(rhs);
-    else if (comp_type_ == "<=")
-      return lhs.CompareLessThanEquals(rhs);
-    else if (comp_type_ == ">")
-      return lhs.CompareGreaterThan(rhs);
-    else if (comp_type_ == ">=")
-      return lhs.CompareGreaterThanEquals(rhs);
-    else if (comp_type_ == "is")
-      return GetCmpBool(lhs.IsNull());
-    else if (comp_type_ == "not")
-      return GetCmpBool(!lhs.IsNull());
-    else
-      throw std::logic_error("Unsupported comparison type");
+    if (kernel_ != nullptr && lhs.GetTypeId() == kernel_type_ && rhs.GetTypeId() == kernel_type_) {
+      return kernel_(lhs, rhs);
+    }
+    return CompareFields(lhs, rhs, op_);
   }
 
   std::string comp_type_;
+  CmpOp op_;
+  FieldCompareFn kernel_{nullptr};  // nullptr for operands of differing types or a null test
+  TypeId kernel_type_{TypeId::kTypeInvalid};
 };
 
 #endif  // MINISQL_COMPARISON_EXPRESSION_H
@@ -16,9 +16,17 @@ class ConstantValueExpression : public AbstractExpression {
   explicit ConstantValueExpression(const Field &val)
       : AbstractExpression({}, val.GetTypeId(), ExpressionType::ConstantExpression), val_(val) {}
 
-  Field Evaluate(const Row *row) const override { return Field(val_); }
+  Field Evaluate(const Row *) const override { return Field(val_); }
 
-  Field EvaluateJoin(const Row *left_row, const Row *right_row) const override { return Field(val_); }
+  /** Char constants are handed out without copying their data. */
+  Field Evaluate(const RowView &) const override {
+    if (val_.GetTypeId() == kTypeChar && !val_.IsNull()) {
+      return Field(kTypeChar, const_cast<char *>(val_.GetData()), val_.GetLength(), false);
+    }
+    return Field(val_);
+  }
+
+  Field EvaluateJoin(const Row *, const Row *) const override { return Field(val_); }
 
   const Field val_;
 };
@@ -28,6 +28,13 @@ class Column {
 
   bool IsUnique() const { return unique_; }
 
+  /**
+   * Declare the char column dictionary encoded, its values are then stored in tuples as codes (see Dictionary).
+   */
+  void SetDictionary(bool dictionary) { dictionary_ = dictionary; }
+
+  bool IsDictionary() const { return dictionary_; }
+
   TypeId GetType() const { return type_; }
 
   uint32_t SerializeTo(char *buf) const;
@@ -45,6 +52,7 @@ class Column {
   uint32_t table_ind_{0};  // column position in table
   bool nullable_{false};   // whether the column can be null
   bool unique_{false};     // whether the column is unique
+  bool dictionary_{false}; // whether the values are dictionary encoded
 };
 
 #endif  // MINISQL_COLUMN_H
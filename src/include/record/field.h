@@ -9,6 +9,9 @@
 #include "record/type_id.h"
 #include "record/types.h"
 
+template <TypeId type>
+struct FieldKernel;
+
 class Field {
   friend class Type;
 
@@ -18,6 +21,9 @@ class Field {
 
   friend class TypeFloat;
 
+  template <TypeId type>
+  friend struct FieldKernel;
+
  public:
   explicit Field(const TypeId type) : type_id_(type), len_(FIELD_NULL_LEN), is_null_(true) {}
 
@@ -50,7 +56,12 @@ class Field {
       value_.chars_ = nullptr;
       manage_data_ = false;
     } else {
-      if (manage_data) {
+      if (manage_data && len <= FIELD_INLINE_LEN) {
+        // short strings are copied inside the field
+        memcpy(value_.inline_, data, len);
+        is_inline_ = true;
+        manage_data_ = false;
+      } else if (manage_data) {
         ASSERT(len < VARCHAR_MAX_LEN, "Field length exceeds max varchar length");
         value_.chars_ = new char[len];
         memcpy(value_.chars_, data, len);
@@ -67,6 +78,8 @@ class Field {
     len_ = other.len_;
     is_null_ = other.is_null_;
     manage_data_ = other.manage_data_;
+    is_overflow_ = other.is_overflow_;
+    is_inline_ = other.is_inline_;
     if (type_id_ == TypeId::kTypeChar && !is_null_ && manage_data_) {
       value_.chars_ = new char[len_];
       memcpy(value_.chars_, other.value_.chars_, len_);
@@ -75,14 +88,39 @@ class Field {
     }
   }
 
+  // move constructor, other is left a null field
+  Field(Field &&other) noexcept
+      : value_(other.value_),
+        type_id_(other.type_id_),
+        len_(other.len_),
+        is_null_(other.is_null_),
+        manage_data_(other.manage_data_),
+        is_overflow_(other.is_overflow_),
+        is_inline_(other.is_inline_) {
+    other.Release();
+  }
+
   // copy
   Field &operator=(Field &other) {
     Swap(*this, other);
     return *this;
   }
 
+  // move, other is left with the former value of this field
+  Field &operator=(Field &&other) noexcept {
+    Swap(*this, other);
+    return *this;
+  }
+
   inline bool IsNull() const { return is_null_; }
 
+  /**
+   * @return true if this char field only holds the reference to a value stored in overflow pages
+   */
+  inline bool IsOverflow() const { return is_overflow_; }
+
+  inline void SetOverflow(bool is_overflow) { is_overflow_ = is_overflow; }
+
   inline uint32_t GetLength() const { return Type::GetInstance(type_id_)->GetLength(*this); }
 
   inline TypeId GetTypeId() const { return type_id_; }
@@ -91,8 +129,18 @@ class Field {
 
   inline uint32_t SerializeTo(char *buf) const { return Type::GetInstance(type_id_)->SerializeTo(*this, buf); }
 
+  /**
+   * @param arena Arena to copy the bytes of a char field longer than FIELD_INLINE_LEN to, the field then points to
+   * them. They are copied to the heap without one.
+   */
+  inline static uint32_t DeserializeFrom(char *buf, const TypeId type_id, Field &field, bool is_null,
+                                         Arena *arena = nullptr) {
+    return Type::GetInstance(type_id)->DeserializeFrom(buf, field, is_null, arena);
+  }
+
   inline static uint32_t DeserializeFrom(char *buf, const TypeId type_id, Field **field, bool is_null) {
-    return Type::GetInstance(type_id)->DeserializeFrom(buf, field, is_null);
+    *field = new Field(type_id);
+    return DeserializeFrom(buf, type_id, **field, is_null);
   }
 
   inline uint32_t GetSerializedSize() const { return Type::GetInstance(type_id_)->GetSerializedSize(*this, is_null_); }
@@ -127,9 +175,11 @@ class Field {
     std::swap(first.len_, second.len_);
     std::swap(first.is_null_, second.is_null_);
     std::swap(first.manage_data_, second.manage_data_);
+    std::swap(first.is_overflow_, second.is_overflow_);
+    std::swap(first.is_inline_, second.is_inline_);
   }
 
-  std::string toString() {
+  std::string toString() const {
     if (is_null_)
       return "NULL";
     else if (type_id_ == kTypeInt)
@@ -137,23 +187,40 @@ class Field {
     else if (type_id_ == kTypeFloat)
       return std::to_string(value_.float_);
     else {
-      char temp[len_ + 1];
-      memcpy(temp, value_.chars_, len_);
-      temp[len_] = '\0';
-      return {temp};
+      return {GetChars(), len_};
     }
   }
 
+ private:
+  /**
+   * @return the bytes of a char field, held inline or pointed to
+   */
+  inline const char *GetChars() const { return is_inline_ ? value_.inline_ : value_.chars_; }
+
+  /**
+   * Drop the value without freeing it, the field becomes null.
+   */
+  inline void Release() {
+    len_ = FIELD_NULL_LEN;
+    is_null_ = true;
+    manage_data_ = false;
+    is_overflow_ = false;
+    is_inline_ = false;
+  }
+
  protected:
   union Val {
     int32_t integer_;
     float float_;
     char *chars_;
+    char inline_[FIELD_INLINE_LEN];
   } value_;
   TypeId type_id_;
   uint32_t len_;
   bool is_null_{false};
   bool manage_data_{false};
+  bool is_overflow_{false};
+  bool is_inline_{false};  // the chars are stored in value_ rather than pointed to
 };
 
 #endif  // MINISQL_FIELD_H
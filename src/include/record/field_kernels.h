@@ -0,0 +1,121 @@
+#ifndef MINISQL_FIELD_KERNELS_H
+#define MINISQL_FIELD_KERNELS_H
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "common/macros.h"
+#include "record/field.h"
+
+/**
+ * Comparison operators of a predicate, parsed once from their SQL spelling.
+ */
+enum class CmpOp { kEqual, kNotEqual, kLessThan, kLessThanEquals, kGreaterThan, kGreaterThanEquals, kIsNull, kIsNotNull };
+
+/**
+ * @return the operator spelled comp, throws std::logic_error for an unsupported one
+ */
+CmpOp ParseCmpOp(const std::string &comp);
+
+/**
+ * Value access and serialization of the non-null fields of one type, without going through Type::GetInstance.
+ * DeserializeFrom fills in place a null field of the type, such as one freshly built by Field(type).
+ */
+template <TypeId type>
+struct FieldKernel;
+
+template <>
+struct FieldKernel<TypeId::kTypeInt> {
+  static inline int32_t Get(const Field &field) { return field.value_.integer_; }
+
+  static inline uint32_t SerializeTo(const Field &field, char *buf) {
+    MACH_WRITE_TO(int32_t, buf, field.value_.integer_);
+    return sizeof(int32_t);
+  }
+
+  static inline void DeserializeFrom(const char *buf, Field &field) {
+    field.value_.integer_ = MACH_READ_FROM(int32_t, buf);
+    field.len_ = sizeof(int32_t);
+    field.is_null_ = false;
+  }
+};
+
+template <>
+struct FieldKernel<TypeId::kTypeFloat> {
+  static inline float Get(const Field &field) { return field.value_.float_; }
+
+  static inline uint32_t SerializeTo(const Field &field, char *buf) {
+    MACH_WRITE_TO(float, buf, field.value_.float_);
+    return sizeof(float);
+  }
+
+  static inline void DeserializeFrom(const char *buf, Field &field) {
+    field.value_.float_ = MACH_READ_FROM(float, buf);
+    field.len_ = sizeof(float);
+    field.is_null_ = false;
+  }
+};
+
+template <>
+struct FieldKernel<TypeId::kTypeChar> {
+  static inline const char *GetData(const Field &field) { return field.GetChars(); }
+
+  static inline uint32_t GetLength(const Field &field) { return field.len_; }
+
+  /**
+   * @return the sign of the comparison of the chars, memcmp then the length
+   */
+  static inline int Compare(const Field &lhs, const Field &rhs) {
+    int cmp = memcmp(lhs.GetChars(), rhs.GetChars(), std::min(lhs.len_, rhs.len_));
+    return cmp != 0 ? cmp : (lhs.len_ > rhs.len_) - (lhs.len_ < rhs.len_);
+  }
+};
+
+template <CmpOp op, typename T>
+inline bool ApplyCmpOp(const T &lhs, const T &rhs) {
+  if constexpr (op == CmpOp::kEqual) {
+    return lhs == rhs;
+  } else if constexpr (op == CmpOp::kNotEqual) {
+    return lhs != rhs;
+  } else if constexpr (op == CmpOp::kLessThan) {
+    return lhs < rhs;
+  } else if constexpr (op == CmpOp::kLessThanEquals) {
+    return lhs <= rhs;
+  } else if constexpr (op == CmpOp::kGreaterThan) {
+    return lhs > rhs;
+  } else {
+    return lhs >= rhs;
+  }
+}
+
+/**
+ * Compare two fields of the given type, the straight-line counterpart of Field::CompareEquals and its siblings.
+ * The fields must both be of that type, which is not checked.
+ */
+template <TypeId type, CmpOp op>
+CmpBool CompareFields(const Field &lhs, const Field &rhs) {
+  if (lhs.IsNull() || rhs.IsNull()) {
+    return CmpBool::kNull;
+  }
+  if constexpr (type == TypeId::kTypeChar) {
+    return GetCmpBool(ApplyCmpOp<op>(FieldKernel<type>::Compare(lhs, rhs), 0));
+  } else {
+    return GetCmpBool(ApplyCmpOp<op>(FieldKernel<type>::Get(lhs), FieldKernel<type>::Get(rhs)));
+  }
+}
+
+using FieldCompareFn = CmpBool (*)(const Field &, const Field &);
+
+/**
+ * Select the comparison kernel of a type and a binary operator, once when a predicate is built.
+ * @return nullptr for an invalid type or a null test
+ */
+FieldCompareFn GetCompareKernel(TypeId type, CmpOp op);
+
+/**
+ * Compare two fields through the generic Type dispatch, for operands whose types are only known at run time.
+ */
+CmpBool CompareFields(const Field &lhs, const Field &rhs, CmpOp op);
+
+#endif  // MINISQL_FIELD_KERNELS_H
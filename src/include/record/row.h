@@ -4,8 +4,10 @@
 #include <memory>
 #include <vector>
 
+#include "common/arena.h"
 #include "common/macros.h"
 #include "common/rowid.h"
+#include "common/small_vector.h"
 #include "record/field.h"
 #include "record/schema.h"
 
@@ -19,10 +21,14 @@
  * | Field Nums | Null bitmap |
  * -------------------------------------------
  *
- *
+ * This self-describing format is kept for index keys, table tuples are stored in the format of their schema
+ * (see RowFormat).
  */
 class Row {
  public:
+  /** Fields of a row, stored by value */
+  using Fields = SmallVector<Field, ROW_INLINE_FIELDS>;
+
   /**
    * Row used for insert
    * Field integrity should check by upper level
@@ -30,20 +36,13 @@ class Row {
   Row(std::vector<Field> &fields) {
     // deep copy
     for (auto &field : fields) {
-      fields_.push_back(new Field(field));
+      AppendField(field);
     }
   }
 
-  void destroy() {
-    if (!fields_.empty()) {
-      for (auto field : fields_) {
-        delete field;
-      }
-      fields_.clear();
-    }
-  }
+  void destroy() { fields_.clear(); }
 
-  ~Row() { destroy(); };
+  ~Row() = default;
 
   /**
    * Row used for deserialize
@@ -56,28 +55,71 @@ class Row {
   Row(RowId rid) : rid_(rid) {}
 
   /**
-   * Row copy function, deep copy
+   * Row copy function, deep copy into the arena of other
    */
-  Row(const Row &other) {
-    destroy();
-    rid_ = other.rid_;
+  Row(const Row &other) : rid_(other.rid_), arena_(other.arena_) {
+    fields_.reserve(other.fields_.size());
     for (auto &field : other.fields_) {
-      fields_.push_back(new Field(*field));
+      AppendField(field);
     }
   }
 
   /**
-   * Assign operator, deep copy
+   * Row move function, the fields are handed over and other is left empty
+   */
+  Row(Row &&other) noexcept : rid_(other.rid_), fields_(std::move(other.fields_)), arena_(other.arena_) {}
+
+  /**
+   * Assign operator, deep copy into the arena of this row
    */
   Row &operator=(const Row &other) {
+    if (this == &other) {
+      return *this;
+    }
     destroy();
     rid_ = other.rid_;
+    fields_.reserve(other.fields_.size());
     for (auto &field : other.fields_) {
-      fields_.push_back(new Field(*field));
+      AppendField(field);
     }
     return *this;
   }
 
+  /**
+   * Move assign operator, the fields of other are handed over and this row keeps its arena for later copies
+   */
+  Row &operator=(Row &&other) noexcept {
+    rid_ = other.rid_;
+    fields_ = std::move(other.fields_);
+    return *this;
+  }
+
+  /**
+   * Copy the chars of the fields of this row longer than FIELD_INLINE_LEN to an arena, nullptr for the heap. Such
+   * chars of an arena row are valid until the arena is reset, whatever the lifetime of the row.
+   */
+  inline void SetArena(Arena *arena) {
+    ASSERT(fields_.empty(), "Arena of a non empty row.");
+    arena_ = arena;
+  }
+
+  inline Arena *GetArena() const { return arena_; }
+
+  /**
+   * Append a deep copy of field, the row owning its char data.
+   */
+  inline void AppendField(const Field &field) { fields_.push_back(CopyField(field)); }
+
+  /**
+   * Append a field as is, a char field only pointing to its data keeps doing so.
+   */
+  inline void AppendField(Field &&field) { fields_.push_back(std::move(field)); }
+
+  /**
+   * Replace the field at idx with a deep copy of field.
+   */
+  void SetField(uint32_t idx, const Field &field);
+
   /**
    * Note: Make sure that bytes write to buf is equal to GetSerializedSize()
    */
@@ -94,22 +136,46 @@ class Row {
 
   void GetKeyFromRow(const Schema *schema, const Schema *key_schema, Row &key_row);
 
+  /**
+   * @return false if a char field is longer than its column, column_idx is then set to that column
+   */
+  bool FitsSchema(const Schema *schema, uint32_t &column_idx) const;
+
+  /**
+   * @return false if a column which is not nullable holds a null, column_idx is then set to that column
+   */
+  bool FitsNullability(const Schema *schema, uint32_t &column_idx) const;
+
   inline const RowId GetRowId() const { return rid_; }
 
   inline void SetRowId(RowId rid) { rid_ = rid; }
 
-  inline std::vector<Field *> &GetFields() { return fields_; }
+  inline Fields &GetFields() { return fields_; }
 
-  inline Field *GetField(uint32_t idx) const {
+  inline const Fields &GetFields() const { return fields_; }
+
+  inline Field *GetField(uint32_t idx) {
     ASSERT(idx < fields_.size(), "Failed to access field");
-    return fields_[idx];
+    return &fields_[idx];
+  }
+
+  inline const Field *GetField(uint32_t idx) const {
+    ASSERT(idx < fields_.size(), "Failed to access field");
+    return &fields_[idx];
   }
 
   inline size_t GetFieldCount() const { return fields_.size(); }
 
+ private:
+  /**
+   * @return a deep copy of field, its long chars in the arena of this row
+   */
+  Field CopyField(const Field &field) const;
+
  private:
   RowId rid_{};
-  std::vector<Field *> fields_; /** Make sure that all field ptr are destructed*/
+  Fields fields_;
+  Arena *arena_{nullptr};  // arena of the long chars of the fields, nullptr if they are on the heap
 };
 
 #endif  // MINISQL_ROW_H
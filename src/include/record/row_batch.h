@@ -0,0 +1,51 @@
+#ifndef MINISQL_ROW_BATCH_H
+#define MINISQL_ROW_BATCH_H
+
+#include <memory>
+#include <vector>
+
+#include "common/macros.h"
+#include "record/row.h"
+
+/**
+ * Reusable buffer of rows filled a page at a time by TableHeap::ScanBatch. Clearing the batch keeps the row
+ * objects around, so a scan allocates them only while the batch grows to the largest page seen.
+ */
+class RowBatch {
+ public:
+  RowBatch() = default;
+
+  inline size_t Size() const { return size_; }
+
+  inline bool Empty() const { return size_ == 0; }
+
+  inline Row &At(size_t idx) {
+    ASSERT(idx < size_, "Failed to access row in batch");
+    return *rows_[idx];
+  }
+
+  inline Row &operator[](size_t idx) { return At(idx); }
+
+  /**
+   * Drop the rows of the batch, their storage is kept for the next fill.
+   */
+  inline void Clear() { size_ = 0; }
+
+  /**
+   * @return an empty row appended to the batch
+   */
+  Row *Append() {
+    if (size_ == rows_.size()) {
+      rows_.emplace_back(std::make_unique<Row>());
+    }
+    Row *row = rows_[size_++].get();
+    row->destroy();
+    return row;
+  }
+
+ private:
+  std::vector<std::unique_ptr<Row>> rows_;
+  size_t size_{0};
+};
+
+#endif  // MINISQL_ROW_BATCH_H
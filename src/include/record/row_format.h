@@ -0,0 +1,101 @@
+#ifndef MINISQL_ROW_FORMAT_H
+#define MINISQL_ROW_FORMAT_H
+
+#include <cstdint>
+#include <vector>
+
+#include "common/config.h"
+#include "common/macros.h"
+#include "record/column.h"
+
+class Row;
+
+/**
+ * Tuple format of the table pages, decoded through offsets precomputed once per schema.
+ *  -------------------------------------------------------------------------------------------
+ * | Version (1) | Null bitmap | Fixed fields | Var field end offsets (2 each) | Var field data |
+ *  -------------------------------------------------------------------------------------------
+ * Fixed width fields (int, float) sit at the same offset in every tuple, a null one is zero filled. Char fields
+ * are variable width: the offset array records where each of them ends from the start of the tuple, so any field
+ * is reached in O(1). An end offset with OVERFLOW_BIT set marks a char whose bytes are a reference to overflow
+ * pages (see OverflowStore). A dictionary encoded char column is a fixed width field holding the code of its value
+ * (see Dictionary). The row id and field count are not stored, they follow from the slot and the schema.
+ */
+class RowFormat {
+ public:
+  explicit RowFormat(const std::vector<Column *> &columns);
+
+  /**
+   * @return the size of the row in this format
+   */
+  uint32_t GetSerializedSize(const Row &row) const;
+
+  /**
+   * @return the number of bytes written, equal to GetSerializedSize(row)
+   */
+  uint32_t SerializeTo(const Row &row, char *buf) const;
+
+  /**
+   * Decode the fields of a tuple into row, whose row id is left untouched.
+   * @return the number of bytes read
+   */
+  uint32_t DeserializeFrom(const char *buf, Row *row) const;
+
+  inline bool IsNull(const char *buf, uint32_t idx) const {
+    return (buf[OFFSET_BITMAP + idx / 8] & (1 << (idx % 8))) != 0;
+  }
+
+  inline bool IsVariable(uint32_t idx) const { return columns_[idx].var_index_ != NOT_VARIABLE; }
+
+  /**
+   * @return true if the char field holds a reference to overflow pages
+   */
+  inline bool IsOverflow(const char *buf, uint32_t idx) const {
+    return IsVariable(idx) && (ReadEndOffset(buf, columns_[idx].var_index_) & OVERFLOW_BIT) != 0;
+  }
+
+  /**
+   * @return the bytes of the field, the overflow reference for a char kept out of line
+   */
+  inline const char *GetData(const char *buf, uint32_t idx) const {
+    return buf + (IsVariable(idx) ? GetVarBegin(buf, columns_[idx].var_index_) : columns_[idx].offset_);
+  }
+
+  /**
+   * @return the number of bytes of a char field
+   */
+  inline uint32_t GetVarLength(const char *buf, uint32_t idx) const {
+    uint32_t var_index = columns_[idx].var_index_;
+    return (ReadEndOffset(buf, var_index) & ~OVERFLOW_BIT) - GetVarBegin(buf, var_index);
+  }
+
+ public:
+  static constexpr uint8_t VERSION = 1;
+  static constexpr uint16_t OVERFLOW_BIT = 1U << 15;
+
+ private:
+  inline uint16_t ReadEndOffset(const char *buf, uint32_t var_index) const {
+    return MACH_READ_FROM(uint16_t, buf + var_offsets_offset_ + var_index * sizeof(uint16_t));
+  }
+
+  inline uint32_t GetVarBegin(const char *buf, uint32_t var_index) const {
+    return var_index == 0 ? var_data_offset_ : ReadEndOffset(buf, var_index - 1) & ~OVERFLOW_BIT;
+  }
+
+ private:
+  static_assert(PAGE_SIZE <= OVERFLOW_BIT, "Tuple offsets must leave room for the overflow bit.");
+  static constexpr uint32_t OFFSET_BITMAP = 1;
+  static constexpr uint32_t NOT_VARIABLE = UINT32_MAX;
+
+  struct ColumnFormat {
+    TypeId type_;         // type of the stored field, int for a dictionary encoded char
+    uint32_t offset_;     // offset of a fixed width field from the start of the tuple
+    uint32_t var_index_;  // position of a char field in the offset array, NOT_VARIABLE for a fixed width one
+  };
+
+  std::vector<ColumnFormat> columns_;
+  uint32_t var_offsets_offset_;  // start of the offset array
+  uint32_t var_data_offset_;     // start of the char data
+};
+
+#endif  // MINISQL_ROW_FORMAT_H
@@ -0,0 +1,141 @@
+#ifndef MINISQL_ROW_VIEW_H
+#define MINISQL_ROW_VIEW_H
+
+#include <memory>
+#include <vector>
+
+#include "common/macros.h"
+#include "common/rowid.h"
+#include "page/pax_layout.h"
+#include "record/field.h"
+#include "record/row.h"
+#include "record/schema.h"
+
+class Dictionary;
+class OverflowStore;
+class TablePage;
+
+/**
+ * Read-only view of a tuple in the format of its schema (see RowFormat). Fields are read in place, so the bytes
+ * must outlive the view, e.g. the table page holding the tuple stays pinned. Every field is reached through the
+ * offsets of the format, so resetting the view to another tuple decodes nothing and never allocates. A value kept
+ * in overflow pages is loaded through the overflow store only when its field is read, and a dictionary encoded
+ * field is looked up in the dictionary of the table. A tuple of a PAX page is viewed in its minipages, so only the
+ * columns actually read are touched.
+ */
+class RowView {
+ public:
+  explicit RowView(Schema *schema, const OverflowStore *overflow_store = nullptr,
+                   const Dictionary *dictionary = nullptr)
+      : schema_(schema), format_(&schema->GetRowFormat()), overflow_store_(overflow_store), dictionary_(dictionary) {}
+
+  /**
+   * Point the view at another tuple of the same schema.
+   * @param rid Row id reported for the tuple, which is not stored with it
+   */
+  void Reset(const char *data, RowId rid = INVALID_ROWID);
+
+  /**
+   * Point the view at the tuple in a slot of a table page of either layout, the page stays pinned and latched.
+   * @param rid Row id reported for the tuple, the slot by default; a relocated tuple is reported at its stub
+   */
+  void Reset(TablePage *page, uint32_t slot_num, RowId rid = INVALID_ROWID);
+
+  inline RowId GetRowId() const { return rid_; }
+
+  inline uint32_t GetFieldCount() const { return schema_->GetColumnCount(); }
+
+  inline bool IsNull(uint32_t idx) const {
+    if (pax_layout_ != nullptr) {
+      return pax_layout_->IsNull(data_, idx, rid_.GetSlotNum());
+    }
+    return format_->IsNull(data_, idx);
+  }
+
+  inline int32_t GetInt(uint32_t idx) const { return MACH_READ_FROM(int32_t, GetValue(idx)); }
+
+  inline float GetFloat(uint32_t idx) const { return MACH_READ_FROM(float, GetValue(idx)); }
+
+  /**
+   * @return true if the char field only holds a reference to overflow pages, GetChars then returns the reference
+   */
+  inline bool IsOverflow(uint32_t idx) const { return pax_layout_ == nullptr && format_->IsOverflow(data_, idx); }
+
+  /**
+   * @return true if the char field holds the code of its value in the dictionary of the table
+   */
+  inline bool IsEncoded(uint32_t idx) const {
+    return dictionary_ != nullptr && schema_->GetColumn(idx)->IsDictionary();
+  }
+
+  inline uint32_t GetCode(uint32_t idx) const { return MACH_READ_UINT32(GetValue(idx)); }
+
+  inline uint32_t GetCharLength(uint32_t idx) const {
+    if (pax_layout_ != nullptr) {
+      return MACH_READ_UINT32(GetValue(idx));
+    }
+    return IsEncoded(idx) ? GetDecoded(idx).size() : format_->GetVarLength(data_, idx);
+  }
+
+  inline const char *GetChars(uint32_t idx) const {
+    if (pax_layout_ != nullptr) {
+      return GetValue(idx) + sizeof(uint32_t);
+    }
+    return IsEncoded(idx) ? GetDecoded(idx).data() : GetValue(idx);
+  }
+
+  /**
+   * Compare a dictionary encoded field with a char value through their codes, without decoding the field. The
+   * code of the value is looked up once and remembered for the following tuples.
+   * @param value A char value staying at the same address while the view is in use, e.g. a constant of a predicate
+   */
+  CmpBool CompareEncoded(uint32_t idx, const Field &value) const;
+
+  /**
+   * @param manage_data false to let a char field point into the viewed bytes, true to copy them out. A value
+   * loaded from overflow pages is always copied.
+   * @return the field at idx
+   */
+  Field GetField(uint32_t idx, bool manage_data = false) const;
+
+  /**
+   * Deserialize the viewed tuple into row, replacing its fields.
+   */
+  void Materialize(Row *row) const;
+
+  /**
+   * Build a row holding copies of the columns of output_schema, which refer to the viewed schema by table index.
+   */
+  void Materialize(const Schema *output_schema, Row *row) const;
+
+ private:
+  /**
+   * @return the bytes of the field at idx, a PAX char starts with its length
+   */
+  inline const char *GetValue(uint32_t idx) const {
+    return pax_layout_ != nullptr ? data_ + pax_offsets_[idx] : format_->GetData(data_, idx);
+  }
+
+  const std::string &GetDecoded(uint32_t idx) const;
+
+ private:
+  Schema *schema_;
+  const RowFormat *format_;
+  const OverflowStore *overflow_store_;
+  const Dictionary *dictionary_;
+  const char *data_{nullptr};
+  RowId rid_;
+  std::unique_ptr<PaxLayout> pax_layout_; /** minipages of the viewed PAX page, nullptr for a tuple in a row page */
+  std::vector<uint32_t> pax_offsets_;     /** offset of each field of the viewed PAX tuple from data_ */
+  /** Code of a value compared with an encoded field, a value not in the dictionary is looked up again once the
+   * dictionary grows */
+  struct CodeLookup {
+    uint32_t idx_;
+    const Field *value_;
+    uint32_t code_;
+    uint32_t value_count_;
+  };
+  mutable std::vector<CodeLookup> code_lookups_;
+};
+
+#endif  // MINISQL_ROW_VIEW_H
@@ -6,6 +6,7 @@
 #include "common/macros.h"
 #include "glog/logging.h"
 #include "record/column.h"
+#include "record/row_format.h"
 
 #ifndef MINISQL_SCHEMA_H
 #define MINISQL_SCHEMA_H
@@ -13,7 +14,7 @@
 class Schema {
  public:
   explicit Schema(const std::vector<Column *> columns, bool is_manage_ = true)
-      : columns_(std::move(columns)), is_manage_(is_manage_) {}
+      : columns_(std::move(columns)), is_manage_(is_manage_), row_format_(columns_) {}
 
   ~Schema() {
     if (is_manage_) {
@@ -39,6 +40,11 @@ class Schema {
 
   inline uint32_t GetColumnCount() const { return static_cast<uint32_t>(columns_.size()); }
 
+  /**
+   * @return the format of the tuples of a table with this schema
+   */
+  inline const RowFormat &GetRowFormat() const { return row_format_; }
+
   /**
    * Shallow copy schema, only used in index
    *
@@ -84,6 +90,7 @@ class Schema {
   static constexpr uint32_t SCHEMA_MAGIC_NUM = 200715;
   std::vector<Column *> columns_;
   bool is_manage_ = false; /** if false, don't need to delete pointer to column */
+  RowFormat row_format_;
 };
 
 using IndexSchema = Schema;
@@ -8,6 +8,7 @@
 #include "common/config.h"
 #include "record/type_id.h"
 
+class Arena;
 class Field;
 
 enum CmpBool { kFalse = 0, kTrue, kNull };
@@ -43,8 +44,9 @@ class Type {
   // Serialize this field into the given storage space.
   virtual uint32_t SerializeTo(const Field &field, char *buf) const;
 
-  // Deserialize a field of the given type from the given storage space.
-  virtual uint32_t DeserializeFrom(char *storage, Field **field, bool is_null) const;
+  // Deserialize a field of the given type from the given storage space, long chars are copied to the arena if one
+  // is given.
+  virtual uint32_t DeserializeFrom(char *storage, Field &field, bool is_null, Arena *arena = nullptr) const;
 
   // Get serialize size of a field
   virtual uint32_t GetSerializedSize(const Field &field, bool is_null) const;
@@ -78,7 +80,7 @@ class TypeInt : public Type {
 
   virtual uint32_t SerializeTo(const Field &field, char *buf) const override;
 
-  virtual uint32_t DeserializeFrom(char *storage, Field **field, bool is_null) const override;
+  uint32_t DeserializeFrom(char *storage, Field &field, bool is_null, Arena *arena = nullptr) const override;
 
   virtual uint32_t GetSerializedSize(const Field &field, bool is_null) const override;
 
@@ -101,7 +103,7 @@ class TypeChar : public Type {
 
   virtual uint32_t SerializeTo(const Field &field, char *buf) const override;
 
-  virtual uint32_t DeserializeFrom(char *storage, Field **field, bool is_null) const override;
+  uint32_t DeserializeFrom(char *storage, Field &field, bool is_null, Arena *arena = nullptr) const override;
 
   virtual uint32_t GetSerializedSize(const Field &field, bool is_null) const override;
 
@@ -120,6 +122,9 @@ class TypeChar : public Type {
   virtual CmpBool CompareGreaterThan(const Field &left, const Field &right) const override;
 
   virtual CmpBool CompareGreaterThanEquals(const Field &left, const Field &right) const override;
+
+  /** Set in the serialized length of a value moved to overflow pages, the bytes that follow are its reference */
+  static constexpr uint32_t OVERFLOW_FLAG = 1U << 31;
 };
 
 class TypeFloat : public Type {
@@ -128,7 +133,7 @@ class TypeFloat : public Type {
 
   virtual uint32_t SerializeTo(const Field &field, char *buf) const override;
 
-  virtual uint32_t DeserializeFrom(char *storage, Field **field, bool is_null) const override;
+  uint32_t DeserializeFrom(char *storage, Field &field, bool is_null, Arena *arena = nullptr) const override;
 
   virtual uint32_t GetSerializedSize(const Field &field, bool is_null) const override;
 
@@ -0,0 +1,111 @@
+#ifndef MINISQL_DICTIONARY_H
+#define MINISQL_DICTIONARY_H
+
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "page/dictionary_page.h"
+#include "record/row.h"
+
+/**
+ * Dictionary of the char columns of a table declared with dictionary encoding. Each distinct value of such a
+ * column is given a code, the position of the value among the values of the column, and tuples hold the code
+ * instead of the value: the field of an encoded column is an int field in a row on its way to or from the table
+ * pages. Codes are only ever appended, so a code never changes meaning. The values are persisted in a chain of
+ * dictionary pages and loaded back in full when the table is opened.
+ */
+class Dictionary {
+ public:
+  Dictionary(BufferPoolManager *buffer_pool_manager, const Schema *schema);
+
+  /**
+   * @return true if some column of the schema is declared with dictionary encoding
+   */
+  static bool HasEncodedColumns(const Schema *schema);
+
+  /**
+   * @return true if the column can be dictionary encoded, i.e. it is a char column short enough to be kept inline
+   */
+  static bool CanEncode(const Column *column);
+
+  /**
+   * Allocate the first dictionary page of a new table.
+   * @return false if the buffer pool is exhausted
+   */
+  bool Create();
+
+  /**
+   * Read back the values of an existing table.
+   */
+  void Load(page_id_t first_page_id);
+
+  /**
+   * Return the dictionary pages to the disk manager.
+   */
+  void Free();
+
+  inline page_id_t GetFirstPageId() const { return first_page_id_; }
+
+  inline bool IsEncoded(uint32_t column) const { return columns_[column].is_encoded_; }
+
+  /**
+   * @return true if some encoded field of the row still holds a value rather than a code
+   */
+  bool NeedsEncoding(const Row &row) const;
+
+  /**
+   * Copy the row into encoded, replacing the value of every encoded column with its code. Values seen for the
+   * first time are appended to the dictionary.
+   * @return false if the buffer pool is exhausted
+   */
+  bool Encode(const Row &row, Row *encoded);
+
+  /**
+   * Replace the codes of the row with the values they stand for.
+   */
+  void Decode(Row *row) const;
+
+  /**
+   * @return the code of a value of the column, NOT_FOUND if the value has not been seen
+   */
+  uint32_t Lookup(uint32_t column, const char *data, uint32_t len) const;
+
+  inline const std::string &GetValue(uint32_t column, uint32_t code) const { return columns_[column].values_[code]; }
+
+  /**
+   * @return the number of distinct values of the column
+   */
+  inline uint32_t GetValueCount(uint32_t column) const {
+    return static_cast<uint32_t>(columns_[column].values_.size());
+  }
+
+ public:
+  static constexpr uint32_t NOT_FOUND = UINT32_MAX;
+
+ private:
+  /**
+   * @return the code of the value, appended to the dictionary if it is new; NOT_FOUND if the buffer pool is
+   * exhausted
+   */
+  uint32_t GetOrAssign(uint32_t column, const char *data, uint32_t len);
+
+  void AddValue(uint32_t column, const char *data, uint32_t len);
+
+ private:
+  struct ColumnDictionary {
+    bool is_encoded_{false};
+    std::deque<std::string> values_;                       // code -> value, a deque keeps the strings in place
+    std::unordered_map<std::string_view, uint32_t> codes_;  // value -> code, viewing the strings of values_
+  };
+
+  BufferPoolManager *buffer_pool_manager_;
+  std::vector<ColumnDictionary> columns_;
+  page_id_t first_page_id_{INVALID_PAGE_ID};
+  page_id_t last_page_id_{INVALID_PAGE_ID};
+};
+
+#endif  // MINISQL_DICTIONARY_H
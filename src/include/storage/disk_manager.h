@@ -99,7 +99,7 @@ private:
  // stream to write db file
  std::fstream db_io_;
  std::string file_name_;
- // with multiple buffer pool instances, need to protect file access
+ // the buffer pool reads pages in without holding its own latch, need to protect file access
  std::recursive_mutex db_io_latch_;
  bool closed{false};
  char meta_data_[PAGE_SIZE];
@@ -0,0 +1,74 @@
+#ifndef MINISQL_OVERFLOW_STORE_H
+#define MINISQL_OVERFLOW_STORE_H
+
+#include "buffer/buffer_pool_manager.h"
+#include "page/overflow_page.h"
+#include "record/row.h"
+
+/**
+ * Keeps char values longer than OVERFLOW_THRESHOLD out of line in chains of overflow pages. The tuple holds a
+ * reference in place of such a value, a char field flagged as overflow whose bytes are:
+ *  -----------------------------------
+ * | Length (4) | FirstPageId (4) |
+ *  -----------------------------------
+ */
+class OverflowStore {
+ public:
+  explicit OverflowStore(BufferPoolManager *buffer_pool_manager) : buffer_pool_manager_(buffer_pool_manager) {}
+
+  /**
+   * @return true if the field is too long to be kept inline
+   */
+  static inline bool NeedsOverflow(const Field &field) {
+    return field.GetTypeId() == TypeId::kTypeChar && !field.IsNull() && !field.IsOverflow() &&
+           field.GetLength() > OVERFLOW_THRESHOLD;
+  }
+
+  /**
+   * @return true if some char column of the schema is declared longer than OVERFLOW_THRESHOLD
+   */
+  static bool MayOverflow(const Schema *schema);
+
+  /**
+   * @return true if any field of the row is too long to be kept inline
+   */
+  static bool NeedsOverflow(Row &row);
+
+  /**
+   * Copy the row into stored, moving every value too long to be kept inline into overflow pages.
+   * @return false if the buffer pool is exhausted, no overflow page is left behind
+   */
+  bool Store(Row &row, Row *stored);
+
+  /**
+   * Replace the references of the row with the values they point to.
+   */
+  void Resolve(Row *row) const;
+
+  /**
+   * @param ref The bytes of a reference
+   * @return a field owning the value the reference points to
+   */
+  Field Load(const char *ref) const;
+
+  /**
+   * Return the overflow pages referenced by the row to the disk manager.
+   */
+  void Free(Row &row);
+
+ public:
+  static constexpr uint32_t SIZE_REF = sizeof(uint32_t) + sizeof(page_id_t);
+
+ private:
+  /**
+   * @return the first page of a new chain holding the bytes, INVALID_PAGE_ID if the buffer pool is exhausted
+   */
+  page_id_t WriteChain(const char *data, uint32_t len);
+
+  void FreeChain(page_id_t page_id);
+
+ private:
+  BufferPoolManager *buffer_pool_manager_;
+};
+
+#endif  // MINISQL_OVERFLOW_STORE_H
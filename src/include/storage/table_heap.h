@@ -1,25 +1,57 @@
 #ifndef MINISQL_TABLE_HEAP_H
 #define MINISQL_TABLE_HEAP_H
 
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include "buffer/buffer_pool_manager.h"
 #include "concurrency/lock_manager.h"
+#include "page/free_space_map_page.h"
 #include "page/header_page.h"
 #include "page/table_page.h"
+#include "record/row_batch.h"
 #include "recovery/log_manager.h"
+#include "storage/dictionary.h"
+#include "storage/overflow_store.h"
 #include "storage/table_iterator.h"
+#include "storage/zone_map.h"
+
+/**
+ * How the pages of a table store their tuples, row by row or column by column in PAX minipages.
+ */
+enum class TableLayout { kRow, kPax };
 
 class TableHeap {
  friend class TableIterator;
 
 public:
+ /**
+  * A PAX heap requires TablePage::GetMaxPaxCapacity(schema) > 0. The dictionary of a schema with dictionary
+  * encoded columns is created along with the first page.
+  */
  static TableHeap *Create(BufferPoolManager *buffer_pool_manager, Schema *schema, Txn *txn, LogManager *log_manager,
-                          LockManager *lock_manager) {
-  return new TableHeap(buffer_pool_manager, schema, txn, log_manager, lock_manager);
+                          LockManager *lock_manager, TableLayout layout = TableLayout::kRow) {
+  return new TableHeap(buffer_pool_manager, schema, txn, log_manager, lock_manager, layout);
+ }
+
+ /**
+  * Open an existing heap. Without the first page of its zone map, the zones are recomputed from the tuples.
+  */
+ static TableHeap *Create(BufferPoolManager *buffer_pool_manager, page_id_t first_page_id, page_id_t fsm_page_id,
+                          Schema *schema, LogManager *log_manager, LockManager *lock_manager,
+                          page_id_t dictionary_page_id = INVALID_PAGE_ID,
+                          page_id_t zone_map_page_id = INVALID_PAGE_ID) {
+  return new TableHeap(buffer_pool_manager, first_page_id, fsm_page_id, schema, log_manager, lock_manager,
+                       dictionary_page_id, zone_map_page_id);
  }
 
- static TableHeap *Create(BufferPoolManager *buffer_pool_manager, page_id_t first_page_id, Schema *schema,
-                          LogManager *log_manager, LockManager *lock_manager) {
-  return new TableHeap(buffer_pool_manager, first_page_id, schema, log_manager, lock_manager);
+ /**
+  * @return true if the table layout is supported for the schema, a PAX page keeps its chars as values
+  */
+ static bool SupportsLayout(const Schema *schema, TableLayout layout) {
+  return layout == TableLayout::kRow ||
+         (TablePage::GetMaxPaxCapacity(schema) > 0 && !Dictionary::HasEncodedColumns(schema));
  }
 
  ~TableHeap() {
@@ -33,6 +65,15 @@ public:
   */
  bool InsertTuple(Row &row, Txn *txn);
 
+ /**
+  * Insert a batch of tuples, filling each page under a single pin and latch. Once the last page is full the
+  * remaining rows go to holes recorded in the free space map, then to pages chained in a run after the last page.
+  * @param[in/out] rows Tuples to insert, the rid of every inserted tuple is wrapped in its row
+  * @param[in] txn The recovery performing the insert
+  * @return the rids assigned to the rows in order, INVALID_ROWID for a row that could not be stored
+  */
+ std::vector<RowId> InsertTuples(std::vector<Row> &rows, Txn *txn);
+
  /**
   * Mark the tuple as deleted. The actual delete will occur when ApplyDelete is called.
   * @param[in] rid Resource id of the tuple of delete
@@ -42,7 +83,9 @@ public:
  bool MarkDelete(const RowId &rid, Txn *txn);
 
  /**
-  * if the new tuple is too large to fit in the old page, return false (will delete and insert)
+  * Update the tuple at rid. A tuple outgrowing its page is relocated to a page with room and its slot keeps a
+  * forwarding stub, so the tuple stays at rid. A relocated tuple is updated where it is, moved back into its own
+  * page once it fits or relocated again, the stub always pointing at the tuple itself.
   * @param[in] row Tuple of new row
   * @param[in] rid Rid of the old tuple
   * @param[in] txn Txn performing the update
@@ -72,6 +115,39 @@ public:
   */
  bool GetTuple(Row *row, Txn *txn);
 
+ /**
+  * Decode every visible tuple of the page at cursor into batch under a single pin, skipping empty pages.
+  * @param[in/out] cursor Page to scan, start from GetFirstPageId(); moved to the following page
+  * @param[out] batch Cleared and refilled with the tuples of one page, rids included
+  * @param[in] txn recovery performing the read
+  * @return false once the heap is exhausted and the batch is empty
+  */
+ bool ScanBatch(page_id_t &cursor, RowBatch &batch, Txn *txn);
+
+ /**
+  * Decode every visible tuple of a single heap page and append them to batch, rids included.
+  * @param[out] next_page_id Set to the page following it in the chain if not nullptr
+  * @return false if the page cannot be fetched
+  */
+ bool ScanPage(page_id_t page_id, RowBatch &batch, Txn *txn, page_id_t *next_page_id = nullptr);
+
+ /**
+  * Apply all pending deletes, compact every page and merge each page into its predecessor when its tuples fit,
+  * returning the emptied pages to the disk manager. The first page is never moved. A relocated tuple is moved back
+  * into the slot of its forwarding stub once it fits, a page holding stubs or relocated tuples is not merged.
+  * @param[out] moved_rows Old rid of every relocated tuple paired with the tuple at its new rid
+  * @param[in] txn Txn performing the vacuum
+  * @return the number of pages freed
+  */
+ uint32_t Vacuum(std::vector<std::pair<RowId, Row>> &moved_rows, Txn *txn);
+
+ /**
+  * @return true if threshold dead tuples per page piled up since the last vacuum, never for a threshold of 0
+  */
+ inline bool NeedsVacuum(uint32_t threshold) const {
+  return threshold > 0 && dead_tuple_count_ >= threshold * number_of_pages;
+ }
+
  void FreeTableHeap() {
   auto next_page_id = first_page_id_;
   while (next_page_id != INVALID_PAGE_ID) {
@@ -79,11 +155,27 @@ public:
    auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(old_page_id));
    assert(page != nullptr);
    next_page_id = page->GetNextPageId();
+   FreeOverflowPages(page, false);
    buffer_pool_manager_->UnpinPage(old_page_id, false);
    buffer_pool_manager_->DeletePage(old_page_id);
   }
+  FreeFreeSpaceMap();
+  dictionary_.Free();
+  zone_map_.Free();
  }
 
+ /**
+  * Follow the forwarding stub in a visible slot of a pinned and read latched page.
+  * @param[in/out] slot_num Slot of the tuple, moved to the slot of the relocated tuple for a stub
+  * @return the page holding the tuple, page itself or the page of the relocated tuple pinned and read latched
+  */
+ TablePage *FetchTuplePage(TablePage *page, uint32_t &slot_num);
+
+ /**
+  * Release the page returned by FetchTuplePage.
+  */
+ void ReleaseTuplePage(TablePage *page, TablePage *tuple_page);
+
  /**
   * Free table heap and release storage in disk file
   */
@@ -104,42 +196,193 @@ public:
   */
  inline page_id_t GetFirstPageId() const { return first_page_id_; }
 
+ /**
+  * @return the id of the first free space map page of this table
+  */
+ inline page_id_t GetFsmPageId() const { return fsm_page_id_; }
+
+ /**
+  * @return the number of heap pages of this table
+  */
+ inline uint32_t GetPageCount() const { return number_of_pages; }
+
+ /**
+  * @return the id of the heap page at the given position of the page chain, looked up in the page directory
+  */
+ inline page_id_t GetPageId(uint32_t index) const { return page_ids_[index]; }
+
+ /**
+  * Split the heap pages into parts contiguous ranges of near equal length.
+  * @param[out] begin Position of the first page of the part
+  * @param[out] end Position past the last page of the part
+  */
+ inline void GetPageRange(uint32_t part, uint32_t parts, uint32_t &begin, uint32_t &end) const {
+  begin = static_cast<uint32_t>(static_cast<uint64_t>(number_of_pages) * part / parts);
+  end = static_cast<uint32_t>(static_cast<uint64_t>(number_of_pages) * (part + 1) / parts);
+ }
+
+ /**
+  * @return the number of visible tuples of this table, summed over the page directory without touching the heap
+  */
+ uint64_t GetTupleCount();
+
+ /**
+  * @return the store of the values kept out of line, nullptr if no column of the table is long enough to need it
+  */
+ inline const OverflowStore *GetOverflowStore() const { return has_overflow_ ? &overflow_store_ : nullptr; }
+
+ /**
+  * @return the dictionary of the encoded columns, nullptr if no column of the table is dictionary encoded
+  */
+ inline const Dictionary *GetDictionary() const { return has_dictionary_ ? &dictionary_ : nullptr; }
+
+ /**
+  * @return the id of the first dictionary page of this table, INVALID_PAGE_ID without a dictionary
+  */
+ inline page_id_t GetDictionaryPageId() const { return dictionary_.GetFirstPageId(); }
+
+ /**
+  * @return the zones of the heap pages, in the order of the page directory
+  */
+ inline const ZoneMap &GetZoneMap() const { return zone_map_; }
+
+ /**
+  * @return the id of the first zone map page of this table, INVALID_PAGE_ID if no column is zoned
+  */
+ inline page_id_t GetZoneMapPageId() const { return zone_map_.GetFirstPageId(); }
+
+ inline TableLayout GetLayout() const { return pax_capacity_ == 0 ? TableLayout::kRow : TableLayout::kPax; }
+
 private:
  /**
   * create table heap and initialize first page
   */
  explicit TableHeap(BufferPoolManager *buffer_pool_manager, Schema *schema, Txn *txn, LogManager *log_manager,
-                    LockManager *lock_manager)
-  : buffer_pool_manager_(buffer_pool_manager),
-    schema_(schema),
-    log_manager_(log_manager),
-    lock_manager_(lock_manager) {
-  //initialize to make sure there must have first page
-  auto first_page = reinterpret_cast<TablePage *>(buffer_pool_manager->NewPage(first_page_id_));
-  first_page->Init(first_page_id_, INVALID_PAGE_ID, log_manager, txn);
-  buffer_pool_manager->UnpinPage(first_page_id_, true);
-  schema_ = schema;
-  last_page_id_ = first_page_id_;
-  number_of_pages = 1;
- };
-
- explicit TableHeap(BufferPoolManager *buffer_pool_manager, page_id_t first_page_id, Schema *schema,
-                    LogManager *log_manager, LockManager *lock_manager)
-  : buffer_pool_manager_(buffer_pool_manager),
-    first_page_id_(first_page_id),
-    schema_(schema),
-    log_manager_(log_manager),
-    lock_manager_(lock_manager) {
- }
+                    LockManager *lock_manager, TableLayout layout);
+
+ /**
+  * open an existing table heap, the free space map is loaded to locate the last page, the layout is read from
+  * the first page and the dictionary and the zone map are loaded in full
+  */
+ explicit TableHeap(BufferPoolManager *buffer_pool_manager, page_id_t first_page_id, page_id_t fsm_page_id,
+                    Schema *schema, LogManager *log_manager, LockManager *lock_manager, page_id_t dictionary_page_id,
+                    page_id_t zone_map_page_id);
+
+ /**
+  * Try to insert the row into the given page, the free space map is refreshed on success.
+  */
+ bool InsertIntoPage(page_id_t page_id, Row &row, Txn *txn, bool relocated = false);
+
+ /**
+  * Store the new version of the tuple at rid in another page, leaving a forwarding stub in its slot.
+  * @param target The relocated tuple the stub currently points at, INVALID_ROWID if the slot holds the tuple
+  * @param[out] old_row The replaced tuple
+  */
+ bool RelocateTuple(Row &row, const RowId &rid, const RowId &target, Row *old_row, Txn *txn);
+
+ /**
+  * Insert a relocated tuple into a page with room, the tuple is only reached through its stub.
+  * @return the rid of the relocated tuple, INVALID_ROWID if the buffer pool is exhausted
+  */
+ RowId InsertRelocatedTuple(Row &row, Txn *txn);
+
+ /**
+  * Remove a relocated tuple whose stub is gone or points elsewhere.
+  */
+ void DeleteRelocatedTuple(const RowId &rid, bool free_overflow, Txn *txn);
+
+ /**
+  * Move the relocated tuples of the page back into the slots of their stubs when they fit.
+  * @return true if a tuple was moved back
+  */
+ bool ClearForwards(TablePage *page, Txn *txn);
+
+ /**
+  * InsertTuples for rows whose dictionary encoded fields already hold codes.
+  */
+ std::vector<RowId> InsertEncodedTuples(std::vector<Row> &rows, Txn *txn);
+
+ /**
+  * Allocate a new page, link it after the last page and register it in the free space map.
+  * @return the id of the new page, INVALID_PAGE_ID if the buffer pool is exhausted
+  */
+ page_id_t AppendNewPage(Txn *txn);
+
+ /**
+  * Chain a new page after the last page, which the caller holds pinned and write latched.
+  * @return the new page pinned, nullptr if the buffer pool is exhausted
+  */
+ TablePage *AllocatePageAfter(TablePage *last_page, Txn *txn);
+
+ /**
+  * @return a page recorded with room for a tuple of the given size, INVALID_PAGE_ID if there is none
+  */
+ page_id_t FindPageWithSpace(uint32_t tuple_size);
+
+ /**
+  * Walk the free space map chain and index its entries.
+  * @return false if a map page could not be fetched
+  */
+ bool LoadFreeSpaceMap();
+
+ /**
+  * Record a new heap page at the end of the free space map, chaining a new map page when the last one is full.
+  * @return false if no map page could be fetched or allocated, nothing is recorded then
+  */
+ bool AppendPageEntry(page_id_t page_id, uint32_t free_space, uint32_t tuple_count);
+
+ /**
+  * Record the free space and visible tuple count of a heap page in the page directory.
+  */
+ void UpdatePageEntry(page_id_t page_id, uint32_t free_space, uint32_t tuple_count);
+
+ /**
+  * Refill the free space map from the page chain, reusing its pages.
+  */
+ void RebuildFreeSpaceMap();
+
+ void FreeFreeSpaceMap();
+
+ /**
+  * Widen the zone of a heap page to the values of a row stored in it or reached through one of its stubs.
+  */
+ void WidenZone(page_id_t page_id, const Row &row);
+
+ /**
+  * Recompute every zone from the tuples of the heap.
+  */
+ void RebuildZoneMap(Txn *txn);
+
+ /**
+  * Free the overflow pages referenced by the tuples of a page.
+  * @param pending_only true to only consider the tuples marked deleted, whose delete is about to be applied
+  */
+ void FreeOverflowPages(TablePage *page, bool pending_only);
+
+ /**
+  * Free the overflow pages referenced by a serialized tuple.
+  */
+ void FreeOverflowPages(char *tuple);
 
 private:
  BufferPoolManager *buffer_pool_manager_;
  uint32_t number_of_pages{0};
  page_id_t first_page_id_;
- page_id_t last_page_id_;
+ page_id_t last_page_id_{INVALID_PAGE_ID};
+ page_id_t fsm_page_id_{INVALID_PAGE_ID};
+ std::vector<page_id_t> fsm_page_ids_;                 // free space map pages in chain order
+ std::unordered_map<page_id_t, uint32_t> fsm_entries_;  // heap page id -> entry number in the map
+ std::vector<page_id_t> page_ids_;                      // entry number in the map -> heap page id
+ uint32_t dead_tuple_count_{0};                          // tuples marked deleted since the last vacuum
  Schema *schema_;
  [[maybe_unused]] LogManager *log_manager_;
  [[maybe_unused]] LockManager *lock_manager_;
+ OverflowStore overflow_store_;
+ bool has_overflow_{false};  // some char column is declared longer than OVERFLOW_THRESHOLD
+ Dictionary dictionary_;
+ bool has_dictionary_{false};  // some char column is dictionary encoded
+ ZoneMap zone_map_;
+ uint32_t pax_capacity_{0};  // rows per page of a PAX heap, 0 for a heap storing tuples row by row
 };
 
 #endif  // MINISQL_TABLE_HEAP_H
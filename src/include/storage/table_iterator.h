@@ -17,6 +17,11 @@ public:
 
     explicit TableIterator(const TableIterator &other);
 
+    /**
+     * The row of other is handed over, other is left at the end.
+     */
+    TableIterator(TableIterator &&other) noexcept;
+
     virtual ~TableIterator();
 
     bool operator==(const TableIterator &itr) const;
@@ -29,10 +34,25 @@ public:
 
     TableIterator &operator=(const TableIterator &itr) noexcept;
 
+    TableIterator &operator=(TableIterator &&itr) noexcept;
+
+    /**
+     * Advance to the next tuple, read into the row of the iterator.
+     */
     TableIterator &operator++();
 
+    /**
+     * Advance to the next tuple, the returned iterator takes the current row over. Prefer the prefix increment,
+     * which reuses the row.
+     */
     TableIterator operator++(int);
 
+private:
+    /**
+     * Read the tuple at rid into the row of the iterator.
+     */
+    void LoadRow(const RowId &rid);
+
 private:
     Row *row{nullptr};
     TableHeap *table_heap_{nullptr};
@@ -0,0 +1,106 @@
+#ifndef MINISQL_ZONE_MAP_H
+#define MINISQL_ZONE_MAP_H
+
+#include <string>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "page/zone_map_page.h"
+#include "record/row.h"
+
+/**
+ * Zone map of a table heap, in the manner of a BRIN index. Every int and float column of the table is zoned: the
+ * zone of a heap page records the smallest and largest non-null value of each zoned column over the tuples of the
+ * page, so a scan can skip a page whose zone cannot satisfy its predicate. Zones follow the page directory, the
+ * Nth heap page having the Nth zone. Inserts and updates only widen a zone, which therefore may be wider than the
+ * tuples it covers but never narrower, until the heap is vacuumed and every zone is recomputed. A relocated tuple
+ * belongs to the zone of the page holding its forwarding stub, where scans find it. The zones are persisted in a
+ * chain of zone map pages and mirrored in memory.
+ */
+class ZoneMap {
+ public:
+  ZoneMap(BufferPoolManager *buffer_pool_manager, const Schema *schema);
+
+  /**
+   * @return true if the schema has a column to zone, a table without one keeps no zone map pages
+   */
+  inline bool IsEnabled() const { return zone_words_ != 0; }
+
+  /**
+   * Allocate the first zone map page of a new table.
+   * @return false if the buffer pool is exhausted
+   */
+  bool Create();
+
+  /**
+   * Read back the zones of an existing table.
+   */
+  void Load(page_id_t first_page_id);
+
+  /**
+   * Return the zone map pages to the disk manager.
+   */
+  void Free();
+
+  inline page_id_t GetFirstPageId() const { return page_ids_.empty() ? INVALID_PAGE_ID : page_ids_.front(); }
+
+  inline uint32_t GetZoneCount() const { return zone_count_; }
+
+  /**
+   * Add an empty zone for a heap page appended to the page directory.
+   */
+  void Append();
+
+  /**
+   * Widen a zone to the values of the row and write it back if it changed.
+   */
+  void Widen(uint32_t zone, const Row &row) {
+    if (Extend(zone, row)) {
+      Write(zone);
+    }
+  }
+
+  /**
+   * Widen a zone in memory only, the caller writes it back with Write once done with the page.
+   * @return true if the zone changed
+   */
+  bool Extend(uint32_t zone, const Row &row);
+
+  void Write(uint32_t zone);
+
+  /**
+   * Empty every zone and resize the map to zone_count zones in memory, the caller recomputes them with Extend and
+   * writes the map back with Flush.
+   */
+  void Reset(uint32_t zone_count);
+
+  /**
+   * Write every zone back, resizing the chain of pages to the zone count.
+   */
+  void Flush();
+
+  /**
+   * @param comp One of the comparisons of a ComparisonExpression, applied as `column comp value`
+   * @return false if no tuple of the heap page can satisfy the comparison. A column which is not zoned, a value of
+   * another type or a comparison other than =, <, <=, > and >= may always match.
+   */
+  bool MayMatch(uint32_t zone, uint32_t column, const std::string &comp, const Field &value) const;
+
+ private:
+  /**
+   * Empty a zone in memory.
+   */
+  void Clear(uint32_t zone);
+
+ private:
+  BufferPoolManager *buffer_pool_manager_;
+  std::vector<int32_t> slots_;    // column -> position of its bounds in a zone, -1 for a column which is not zoned
+  std::vector<TypeId> types_;     // type of each zoned column
+  uint32_t zone_words_{0};        // words per zone, a minimum and a maximum per zoned column
+  uint32_t zones_per_page_{0};
+  uint32_t zone_count_{0};
+  std::vector<uint32_t> words_;   // zones in memory, in the format of the pages
+  std::vector<page_id_t> page_ids_;
+};
+
+#endif  // MINISQL_ZONE_MAP_H
@@ -46,15 +46,12 @@ BPlusTree::BPlusTree(index_id_t idx_id, BufferPoolManager *buf_pool_mgr, const K
 }
 
 void BPlusTree::Destroy(page_id_t current_page_id) {
-  // Check if the B+ tree is empty
-  if(IsEmpty())
-    return;
-
   // If the current page ID is invalid, use the root page ID
   if(current_page_id == INVALID_PAGE_ID) {
-    current_page_id = root_page_id_;
-    root_page_id_ = INVALID_PAGE_ID;
-    UpdateRootPageId(2); // 2 signifies root removal
+    current_page_id = Detach();
+    // Check if the B+ tree is empty
+    if(current_page_id == INVALID_PAGE_ID)
+      return;
   }
 
   // Fetch and convert the current page to a B+ tree page
@@ -68,9 +65,18 @@ void BPlusTree::Destroy(page_id_t current_page_id) {
     }
   }
 
-  // Delete the current page and unpin it from the buffer pool
-  buffer_pool_manager_->DeletePage(current_page_id);
+  // Unpin the current page and delete it, a pinned page cannot be deleted
   buffer_pool_manager_->UnpinPage(current_page_id, false);
+  buffer_pool_manager_->DeletePage(current_page_id);
+}
+
+page_id_t BPlusTree::Detach() {
+  page_id_t old_root_page_id = root_page_id_;
+  if(old_root_page_id != INVALID_PAGE_ID) {
+    root_page_id_ = INVALID_PAGE_ID;
+    UpdateRootPageId(2); // 2 signifies root removal
+  }
+  return old_root_page_id;
 }
 
 // Helper function to check if the B+ tree is empty
@@ -233,8 +239,8 @@ void BPlusTree::InsertIntoParent(BPlusTreePage *old_node, GenericKey *key, BPlus
 /*****************************************************************************
  * REMOVE
  *****************************************************************************/
-void BPlusTree::Remove(const GenericKey *key, Txn *transaction) {
-  if(IsEmpty()) return; // If tree is empty, return immediately.
+bool BPlusTree::Remove(const GenericKey *key, Txn *transaction) {
+  if(IsEmpty()) return false; // If tree is empty, return immediately.
 
   // Find the leaf node containing the key for deletion.
   auto leaf_node = reinterpret_cast<LeafPage *>(FindLeafPage(key, root_page_id_, false)->GetData());
@@ -245,10 +251,11 @@ void BPlusTree::Remove(const GenericKey *key, Txn *transaction) {
     // Successful deletion, attempt coalesce or redistribution.
     CoalesceOrRedistribute(leaf_node, transaction);
     buffer_pool_manager_->UnpinPage(leaf_node->GetPageId(), true);
-  } else {
-    // Deletion failed, simply unpin the leaf node without marking modifications.
-    buffer_pool_manager_->UnpinPage(leaf_node->GetPageId(), false);
+    return true;
   }
+  // Deletion failed, simply unpin the leaf node without marking modifications.
+  buffer_pool_manager_->UnpinPage(leaf_node->GetPageId(), false);
+  return false;
 }
 
 template <typename N>
@@ -268,11 +275,12 @@ bool BPlusTree::CoalesceOrRedistribute(N *&node, Txn *transaction) {
 
     // Decide whether to redistribute or coalesce based on sizes.
     bool res = false;
+    // Both expect the index of node itself, index 0 means the sibling is on the right.
     if(node->GetSize() + sibling_node->GetSize() >= node->GetMaxSize()) {
-      Redistribute(sibling_node, node, sibling_index);
+      Redistribute(sibling_node, node, node_index);
       res = false; // No deletion needed after redistribution.
     } else {
-      Coalesce(sibling_node, node, parent_node, sibling_index, transaction);
+      Coalesce(sibling_node, node, parent_node, node_index, transaction);
       res = true; // Deletion needed after coalescing.
     }
 
@@ -397,6 +405,7 @@ bool BPlusTree::AdjustRoot(BPlusTreePage *old_root_node) {
  * @return : index iterator
  */
 IndexIterator BPlusTree::Begin() {
+  if(IsEmpty())return IndexIterator();
   auto * page = reinterpret_cast<LeafPage *>(FindLeafPage(nullptr, root_page_id_, true)->GetData());
   page_id_t page_id = page->GetPageId();
   buffer_pool_manager_->UnpinPage(page_id, false);
@@ -409,9 +418,16 @@ IndexIterator BPlusTree::Begin() {
  * @return : index iterator
  */
 IndexIterator BPlusTree::Begin(const GenericKey *key) {
+  if(IsEmpty())return IndexIterator();
   auto * page = reinterpret_cast<LeafPage *>(FindLeafPage(key, root_page_id_, false)->GetData());
   int index = page ->KeyIndex(key, processor_);
   page_id_t page_id = page ->GetPageId();
+  page_id_t next_page_id = page ->GetNextPageId();
+  // every key of the leaf is less than key, start at the next leaf
+  if(index == page ->GetSize() && next_page_id != INVALID_PAGE_ID){
+    buffer_pool_manager_ ->UnpinPage(page_id, false);
+    return IndexIterator(next_page_id, buffer_pool_manager_, 0);
+  }
   buffer_pool_manager_ ->UnpinPage(page_id, false);
   return IndexIterator(page_id, buffer_pool_manager_, index);
 }
@@ -423,19 +439,18 @@ IndexIterator BPlusTree::Begin(const GenericKey *key) {
  */
 IndexIterator BPlusTree::End() {
   if(root_page_id_ == INVALID_PAGE_ID)return IndexIterator();
-  auto root = reinterpret_cast<BPlusTreePage *> (buffer_pool_manager_ ->FetchPage(root_page_id_) -> GetData());
-  if(root -> IsLeafPage()){
-    auto node = reinterpret_cast<LeafPage *>(root);
-    auto endleaf = FindLeafPage(node ->KeyAt(node -> GetSize() - 1),root_page_id_);
-    buffer_pool_manager_ ->UnpinPage(root_page_id_, false);
-    return IndexIterator(endleaf -> GetPageId(), buffer_pool_manager_, node -> GetSize() );
-  }
-  else{
-    auto node = reinterpret_cast<InternalPage *>(root);
-    auto endleaf = FindLeafPage(node ->KeyAt(node -> GetSize() - 1),root_page_id_);
-    buffer_pool_manager_ ->UnpinPage(root_page_id_, false);
-    return IndexIterator(endleaf -> GetPageId(), buffer_pool_manager_, node -> GetSize() );
+  // one past the last pair of the rightmost leaf
+  page_id_t page_id = root_page_id_;
+  auto node = reinterpret_cast<BPlusTreePage *> (buffer_pool_manager_ ->FetchPage(page_id) -> GetData());
+  while(!node -> IsLeafPage()){
+    page_id_t child_id = reinterpret_cast<InternalPage *>(node) ->ValueAt(node -> GetSize() - 1);
+    buffer_pool_manager_ ->UnpinPage(page_id, false);
+    page_id = child_id;
+    node = reinterpret_cast<BPlusTreePage *> (buffer_pool_manager_ ->FetchPage(page_id) -> GetData());
   }
+  int size = node -> GetSize();
+  buffer_pool_manager_ ->UnpinPage(page_id, false);
+  return IndexIterator(page_id, buffer_pool_manager_, size);
 }
 
 /*****************************************************************************
@@ -469,7 +484,10 @@ Page *BPlusTree::FindLeafPage(const GenericKey *key, page_id_t page_id, bool lef
  * updating it.
  */
 void BPlusTree::UpdateRootPageId(int insert_record) {
-  auto page = reinterpret_cast<IndexRootsPage *> (buffer_pool_manager_ ->FetchPage(INDEX_ROOTS_PAGE_ID) -> GetData());\
+  auto roots_page = buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID);
+  // shared by the indexes of every table, an auto-vacuum may move the roots of its table meanwhile
+  roots_page->WLatch();
+  auto page = reinterpret_cast<IndexRootsPage *>(roots_page->GetData());
   if(insert_record == 0){
     page ->Update(index_id_, root_page_id_);
   }
@@ -479,6 +497,7 @@ void BPlusTree::UpdateRootPageId(int insert_record) {
   else{
     page ->Delete(index_id_);
   }
+  roots_page->WUnlatch();
   buffer_pool_manager_ ->UnpinPage(INDEX_ROOTS_PAGE_ID, true);
 }
 
@@ -6,7 +6,11 @@ BPlusTreeIndex::BPlusTreeIndex(index_id_t index_id, IndexSchema *key_schema, siz
                                BufferPoolManager *buffer_pool_manager)
     : Index(index_id, key_schema),
       processor_(key_schema_, key_size),
-      container_(index_id, buffer_pool_manager, processor_) {}
+      container_(index_id, buffer_pool_manager, processor_) {
+  if (ENABLE_INDEX_KEY_FILTER) {
+    RebuildFilter();
+  }
+}
 
 dberr_t BPlusTreeIndex::InsertEntry(const Row &key, RowId row_id, Txn *txn) {
   // ASSERT(row_id.Get() != INVALID_ROWID.Get(), "Invalid row id for index insert.");
@@ -15,6 +19,13 @@ dberr_t BPlusTreeIndex::InsertEntry(const Row &key, RowId row_id, Txn *txn) {
 
   bool status = container_.Insert(index_key, row_id, txn);
   free(index_key);
+  uint64_t hash;
+  if (status && ENABLE_INDEX_KEY_FILTER && KeyFilter::Hash(key, hash)) {
+    filter_.Add(hash);
+    if (filter_.GetKeyCount() > filter_.GetCapacity()) {
+      RebuildFilter();
+    }
+  }
   //  TreeFileManagers mgr("tree_");
   //  static int i = 0;
   //  if (i % 10 == 0) container_.PrintTree(mgr[i]);
@@ -30,11 +41,20 @@ dberr_t BPlusTreeIndex::RemoveEntry(const Row &key, RowId row_id, Txn *txn) {
   GenericKey *index_key = processor_.InitKey();
   processor_.SerializeFromKey(index_key, key, key_schema_);
 
-  container_.Remove(index_key, txn);
+  bool removed = container_.Remove(index_key, txn);
   free(index_key);
+  uint64_t hash;
+  if (removed && ENABLE_INDEX_KEY_FILTER && KeyFilter::Hash(key, hash)) {
+    filter_.Remove(hash);
+  }
   return DB_SUCCESS;
 }
 
+bool BPlusTreeIndex::MayContain(const Row &key) {
+  uint64_t hash;
+  return !ENABLE_INDEX_KEY_FILTER || !KeyFilter::Hash(key, hash) || filter_.MayContain(hash);
+}
+
 dberr_t BPlusTreeIndex::ScanKey(const Row &key, vector<RowId> &result, Txn *txn, string compare_operator) {
   GenericKey *index_key = processor_.InitKey();
   processor_.SerializeFromKey(index_key, key, key_schema_);
@@ -55,17 +75,24 @@ dberr_t BPlusTreeIndex::ScanKey(const Row &key, vector<RowId> &result, Txn *txn,
   } else if (compare_operator == "<") {
     auto stop_iter = GetBeginIterator(index_key);
     for (auto iter = GetBeginIterator(); iter != stop_iter; ++iter) {
-      result.emplace_back((*iter).second);
+      // null keys sort first but are less than no key
+      if (!processor_.HasNull((*iter).first)) {
+        result.emplace_back((*iter).second);
+      }
     }
   } else if (compare_operator == "<=") {
     auto stop_iter = GetBeginIterator(index_key);
     for (auto iter = GetBeginIterator(); iter != stop_iter; ++iter) {
-      result.emplace_back((*iter).second);
+      if (!processor_.HasNull((*iter).first)) {
+        result.emplace_back((*iter).second);
+      }
     }
     container_.GetValue(index_key, result, txn);
   } else if (compare_operator == "<>") {
     for (auto iter = GetBeginIterator(); iter != end_iter; ++iter) {
-      result.emplace_back((*iter).second);
+      if (!processor_.HasNull((*iter).first)) {
+        result.emplace_back((*iter).second);
+      }
     }
     vector<RowId> temp;
     if (container_.GetValue(index_key, temp, txn))
@@ -80,9 +107,21 @@ dberr_t BPlusTreeIndex::ScanKey(const Row &key, vector<RowId> &result, Txn *txn,
 
 dberr_t BPlusTreeIndex::Destroy() {
   container_.Destroy();
+  filter_.Reset(0);
   return DB_SUCCESS;
 }
 
+page_id_t BPlusTreeIndex::Detach() {
+  filter_.Reset(0);
+  return container_.Detach();
+}
+
+void BPlusTreeIndex::FreeDetached(page_id_t page_id) {
+  if (page_id != INVALID_PAGE_ID) {
+    container_.Destroy(page_id);
+  }
+}
+
 IndexIterator BPlusTreeIndex::GetBeginIterator() {
   return container_.Begin();
 }
@@ -93,4 +132,20 @@ IndexIterator BPlusTreeIndex::GetBeginIterator(GenericKey *key) {
 
 IndexIterator BPlusTreeIndex::GetEndIterator() {
   return container_.End();
-}
\ No newline at end of file
+}
+
+void BPlusTreeIndex::RebuildFilter() {
+  std::vector<uint64_t> hashes;
+  container_.ForEachKey([&](const GenericKey *index_key) {
+    Row key(INVALID_ROWID);
+    processor_.DeserializeToKey(index_key, key, key_schema_);
+    uint64_t hash;
+    if (KeyFilter::Hash(key, hash)) {
+      hashes.push_back(hash);
+    }
+  });
+  filter_.Reset(2 * hashes.size());
+  for (auto hash : hashes) {
+    filter_.Add(hash);
+  }
+}
@@ -28,13 +28,15 @@ IndexIterator &IndexIterator::operator++() {
       //current_page_id = INVALID_PAGE_ID;
     }
     else{
+      // the iterator keeps its page pinned
       auto next_page = reinterpret_cast<LeafPage *> (buffer_pool_manager->FetchPage(next_id) -> GetData());
+      buffer_pool_manager ->UnpinPage(current_page_id, false);
       page = next_page;
       current_page_id = next_id;
       item_index = 0;
-      buffer_pool_manager ->UnpinPage(next_id, false);
     }
   }
+  return *this;
 }
 
 bool IndexIterator::operator==(const IndexIterator &itr) const {
@@ -0,0 +1,85 @@
+#include "index/key_filter.h"
+
+#include <algorithm>
+#include <limits>
+#include <string_view>
+
+namespace {
+
+inline uint64_t Mix(uint64_t hash) {
+  // splitmix64 finalizer, the probes are derived from both halves of the hash
+  hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+  return hash ^ (hash >> 31);
+}
+
+/**
+ * Counter of the ith probe of a hash, by double hashing.
+ */
+inline size_t Probe(uint64_t hash, uint32_t i, size_t counter_count) {
+  auto h1 = static_cast<uint32_t>(hash);
+  auto h2 = static_cast<uint32_t>(hash >> 32) | 1;
+  return (h1 + static_cast<uint64_t>(i) * h2) % counter_count;
+}
+
+}  // namespace
+
+void KeyFilter::Reset(uint32_t capacity) {
+  capacity_ = std::max(capacity, INDEX_FILTER_MIN_KEYS);
+  key_count_ = 0;
+  counters_.assign(static_cast<size_t>(capacity_) * INDEX_FILTER_COUNTERS_PER_KEY, 0);
+}
+
+bool KeyFilter::Hash(const Row &key, uint64_t &hash) {
+  hash = 0;
+  for (uint32_t i = 0; i < key.GetFieldCount(); i++) {
+    const Field *field = key.GetField(i);
+    if (field->IsNull()) {
+      return false;
+    }
+    uint64_t field_hash;
+    if (field->GetTypeId() == TypeId::kTypeChar) {
+      field_hash = std::hash<std::string_view>()(std::string_view(field->GetData(), field->GetLength()));
+    } else {
+      char buf[sizeof(uint64_t)];
+      uint32_t len = field->SerializeTo(buf);
+      if (field->GetTypeId() == TypeId::kTypeFloat && MACH_READ_FROM(float, buf) == 0) {
+        // -0.0 equals 0.0
+        MACH_WRITE_TO(float, buf, 0.0f);
+      }
+      field_hash = std::hash<std::string_view>()(std::string_view(buf, len));
+    }
+    hash = Mix(hash + field_hash);
+  }
+  return true;
+}
+
+void KeyFilter::Add(uint64_t hash) {
+  for (uint32_t i = 0; i < INDEX_FILTER_PROBES; i++) {
+    uint8_t &counter = counters_[Probe(hash, i, counters_.size())];
+    if (counter != std::numeric_limits<uint8_t>::max()) {
+      counter++;
+    }
+  }
+  key_count_++;
+}
+
+void KeyFilter::Remove(uint64_t hash) {
+  for (uint32_t i = 0; i < INDEX_FILTER_PROBES; i++) {
+    uint8_t &counter = counters_[Probe(hash, i, counters_.size())];
+    // a saturated counter lost count of its keys
+    if (counter != 0 && counter != std::numeric_limits<uint8_t>::max()) {
+      counter--;
+    }
+  }
+  key_count_--;
+}
+
+bool KeyFilter::MayContain(uint64_t hash) const {
+  for (uint32_t i = 0; i < INDEX_FILTER_PROBES; i++) {
+    if (counters_[Probe(hash, i, counters_.size())] == 0) {
+      return false;
+    }
+  }
+  return true;
+}
@@ -71,21 +71,9 @@ void InternalPage::PairCopy(void *dest, void *src, int pair_num) {
  * 用了二分查找
  */
 page_id_t InternalPage::Lookup(const GenericKey *key, const KeyManager &KM) {
-  int right=GetSize()-1;
-  int left=1;
-  while(right-left>=0){
-    int   middle=(left+right)/2;
-    if(KM.CompareKeys(key,KeyAt(middle))==0){
-      return  ValueAt(middle);
-    }
-    if(KM.CompareKeys(key,KeyAt(middle))>0){
-      left=middle+1;
-    }
-    if(KM.CompareKeys(key,KeyAt(middle))<0){
-      right=middle-1;
-    }
-  }
-  return ValueAt(left-1);
+  // the child before the first key greater than key
+  int index = 1 + KM.UpperBound(pairs_off + pair_size + key_off, pair_size, GetSize() - 1, key);
+  return ValueAt(index - 1);
 }
 
 /*****************************************************************************
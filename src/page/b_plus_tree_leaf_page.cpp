@@ -51,21 +51,7 @@ void LeafPage::SetNextPageId(page_id_t next_page_id) {
  * 二分查找
  */
 int LeafPage::KeyIndex(const GenericKey *key, const KeyManager &KM) {
-  if(GetSize() == 0)return 0;
-  int left = 0;
-  int right = GetSize()-1;
-  while(left<=right){
-    int middle = (left+right) / 2;
-    int cmp = KM.CompareKeys(key, KeyAt(middle));
-    if(cmp == 0){
-      return middle;
-    }else if(cmp > 0){
-      left = middle + 1;
-    }else {
-      right = middle - 1;
-    }
-  }
-  return right + 1;
+  return KM.LowerBound(pairs_off + key_off, pair_size, GetSize(), key);
 }
 
 /*
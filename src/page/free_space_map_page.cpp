@@ -0,0 +1,33 @@
+#include "page/free_space_map_page.h"
+
+bool FreeSpaceMapPage::Append(page_id_t heap_page_id, uint32_t free_space, uint32_t tuple_count) {
+  if (IsFull()) {
+    return false;
+  }
+  heap_page_ids_[count_] = heap_page_id;
+  tuple_counts_[count_] = static_cast<uint16_t>(tuple_count);
+  buckets_[count_] = ToBucket(free_space);
+  count_++;
+  return true;
+}
+
+bool FreeSpaceMapPage::Update(uint32_t index, uint32_t free_space, uint32_t tuple_count) {
+  uint8_t bucket = ToBucket(free_space);
+  if (index >= count_ || (buckets_[index] == bucket && tuple_counts_[index] == tuple_count)) {
+    return false;
+  }
+  buckets_[index] = bucket;
+  tuple_counts_[index] = static_cast<uint16_t>(tuple_count);
+  return true;
+}
+
+int FreeSpaceMapPage::FindFreeEntry(uint32_t tuple_size, uint32_t start) const {
+  // round up, a bucket only promises BUCKET_SIZE * bucket bytes
+  uint32_t need = (tuple_size + BUCKET_SIZE - 1) / BUCKET_SIZE;
+  for (uint32_t i = start; i < count_; i++) {
+    if (buckets_[i] >= need) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
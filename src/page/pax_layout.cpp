@@ -0,0 +1,67 @@
+#include "page/pax_layout.h"
+
+#include <algorithm>
+
+#include "common/config.h"
+
+static inline uint32_t AlignUp(uint32_t offset) { return (offset + 7) & ~7U; }
+
+PaxLayout::PaxLayout(const Schema *schema, uint32_t capacity, uint32_t begin) : capacity_(capacity) {
+  null_offsets_.reserve(schema->GetColumnCount());
+  value_offsets_.reserve(schema->GetColumnCount());
+  value_sizes_.reserve(schema->GetColumnCount());
+  Place(schema, capacity, begin, this);
+}
+
+uint32_t PaxLayout::GetMaxCapacity(const Schema *schema, uint32_t begin, uint32_t max_capacity) {
+  uint32_t row_bits = 0;
+  for (auto column : schema->GetColumns()) {
+    uint32_t value_size = GetValueSize(column);
+    if (value_size == 0) {
+      return 0;
+    }
+    row_bits += 8 * value_size + 1;
+  }
+  if (row_bits == 0 || begin >= PAGE_SIZE) {
+    return 0;
+  }
+  // start from the estimate without padding and back off until the minipages fit
+  uint32_t capacity = std::min<uint32_t>(max_capacity, 8 * (PAGE_SIZE - begin) / row_bits);
+  while (capacity > 0 && Place(schema, capacity, begin, nullptr) > PAGE_SIZE) {
+    capacity--;
+  }
+  return capacity;
+}
+
+uint32_t PaxLayout::GetValueSize(const Column *column) {
+  switch (column->GetType()) {
+    case TypeId::kTypeInt:
+    case TypeId::kTypeFloat:
+      return column->GetLength();
+    case TypeId::kTypeChar:
+      // a value long enough to go out of line has no fixed width
+      return column->GetLength() > OVERFLOW_THRESHOLD ? 0 : sizeof(uint32_t) + column->GetLength();
+    default:
+      return 0;
+  }
+}
+
+uint32_t PaxLayout::Place(const Schema *schema, uint32_t capacity, uint32_t begin, PaxLayout *layout) {
+  uint32_t offset = AlignUp(begin);
+  for (auto column : schema->GetColumns()) {
+    uint32_t value_size = GetValueSize(column);
+    if (value_size == 0) {
+      return 0;
+    }
+    if (layout != nullptr) {
+      layout->null_offsets_.push_back(offset);
+    }
+    offset = AlignUp(offset + (capacity + 7) / 8);
+    if (layout != nullptr) {
+      layout->value_offsets_.push_back(offset);
+      layout->value_sizes_.push_back(value_size);
+    }
+    offset = AlignUp(offset + capacity * value_size);
+  }
+  return offset;
+}
@@ -2,39 +2,65 @@
 
 // TODO: Update interface implementation if apply recovery
 
-void TablePage::Init(page_id_t page_id, page_id_t prev_id, LogManager *log_mgr, Txn *txn) {
+void TablePage::Init(page_id_t page_id, page_id_t prev_id, LogManager *log_mgr, Txn *txn, uint32_t pax_capacity) {
+  ASSERT(pax_capacity <= MAX_SLOT_COUNT, "PAX page cannot hold more rows than slots.");
   memcpy(GetData(), &page_id, sizeof(page_id));
   SetPrevPageId(prev_id);
   SetNextPageId(INVALID_PAGE_ID);
   SetFreeSpacePointer(PAGE_SIZE);
   SetTupleCount(0);
+  memset(GetData() + OFFSET_FREE_SLOT_BITMAP, 0, 2 * SIZE_SLOT_BITMAP);
+  memcpy(GetData() + OFFSET_PAX_CAPACITY, &pax_capacity, sizeof(uint32_t));
+}
+
+uint32_t TablePage::FindNextSetBit(const uint64_t *bitmap, uint32_t from, uint32_t limit) {
+  if (from >= limit) {
+    return limit;
+  }
+  uint32_t word_index = from / 64;
+  // Drop the bits before from in the first word.
+  uint64_t word = bitmap[word_index] & (~0ULL << (from % 64));
+  while (word == 0) {
+    if (++word_index * 64 >= limit) {
+      return limit;
+    }
+    word = bitmap[word_index];
+  }
+  uint32_t bit = word_index * 64 + __builtin_ctzll(word);
+  return bit < limit ? bit : limit;
 }
 
 bool TablePage::InsertTuple(Row &row, Schema *schema, Txn *txn, LockManager *lock_manager, LogManager *log_manager) {
-  uint32_t serialized_size = row.GetSerializedSize(schema);
+  return InsertTuple(row, schema->GetRowFormat().GetSerializedSize(row), schema, txn, lock_manager, log_manager);
+}
+
+bool TablePage::InsertTuple(Row &row, uint32_t serialized_size, Schema *schema, Txn *txn, LockManager *lock_manager,
+                            LogManager *log_manager) {
   ASSERT(serialized_size > 0, "Can not have empty row.");
-  if (GetFreeSpaceRemaining() < serialized_size + SIZE_TUPLE) {
+  if (IsPax()) {
+    return InsertPaxTuple(row, schema);
+  }
+  // Try to find a free slot to reuse, a new slot needs room in the slot array as well.
+  uint32_t i = FindNextSetBit(GetFreeSlotBitmap(), 0, GetTupleCount());
+  if (i == GetTupleCount() && (i == MAX_SLOT_COUNT || GetFreeSpaceRemaining() < serialized_size + SIZE_TUPLE)) {
     return false;
   }
-  // Try to find a free slot to reuse.
-  uint32_t i;
-  for (i = 0; i < GetTupleCount(); i++) {
-    // If the slot is empty, i.e. its tuple has size 0,
-    if (GetTupleSize(i) == 0) {
-      // Then we break out of the loop at index i.
-      break;
-    }
+  if (GetFreeSpaceRemaining() < serialized_size) {
+    return false;
   }
-  // Otherwise we claim available free space..
+  // Claim available free space.
   SetFreeSpacePointer(GetFreeSpacePointer() - serialized_size);
   // Set rid
   row.SetRowId(RowId(GetTablePageId(), i));
-  uint32_t __attribute__((unused)) write_bytes = row.SerializeTo(GetData() + GetFreeSpacePointer(), schema);
+  uint32_t __attribute__((unused)) write_bytes =
+      schema->GetRowFormat().SerializeTo(row, GetData() + GetFreeSpacePointer());
   ASSERT(write_bytes == serialized_size, "Unexpected behavior in row serialize.");
 
   // Set the tuple.
   SetTupleOffsetAtSlot(i, GetFreeSpacePointer());
   SetTupleSize(i, serialized_size);
+  ClearSlotBit(GetFreeSlotBitmap(), i);
+  SetSlotBit(GetLiveSlotBitmap(), i);
 
   if (i == GetTupleCount()) {
     SetTupleCount(GetTupleCount() + 1);
@@ -48,6 +74,9 @@ bool TablePage::MarkDelete(const RowId &rid, Txn *txn, LockManager *lock_manager
   if (slot_num >= GetTupleCount()) {
     return false;
   }
+  if (IsPax()) {
+    return MarkPaxDelete(slot_num);
+  }
   uint32_t tuple_size = GetTupleSize(slot_num);
   // If the tuple is already deleted, abort.
   if (IsDeleted(tuple_size)) {
@@ -56,6 +85,7 @@ bool TablePage::MarkDelete(const RowId &rid, Txn *txn, LockManager *lock_manager
   // Mark the tuple as deleted.
   if (tuple_size > 0) {
     SetTupleSize(slot_num, SetDeletedFlag(tuple_size));
+    ClearSlotBit(GetLiveSlotBitmap(), slot_num);
   }
   return true;
 }
@@ -63,54 +93,131 @@ bool TablePage::MarkDelete(const RowId &rid, Txn *txn, LockManager *lock_manager
 bool TablePage::UpdateTuple(Row &new_row, Row *old_row, Schema *schema, Txn *txn, LockManager *lock_manager,
                             LogManager *log_manager) {
   ASSERT(old_row != nullptr && old_row->GetRowId().Get() != INVALID_ROWID.Get(), "invalid old row.");
-  uint32_t serialized_size = new_row.GetSerializedSize(schema);
+  if (IsPax()) {
+    return UpdatePaxTuple(new_row, old_row, schema);
+  }
+  const RowFormat &format = schema->GetRowFormat();
+  uint32_t serialized_size = format.GetSerializedSize(new_row);
   ASSERT(serialized_size > 0, "Can not have empty row.");
   uint32_t slot_num = old_row->GetRowId().GetSlotNum();
   // If the slot number is invalid, abort.
   if (slot_num >= GetTupleCount()) {
-    return -1;
+    return false;
   }
   uint32_t tuple_size = GetTupleSize(slot_num);
-  // If the tuple is deleted, abort.
-  if (IsDeleted(tuple_size)) {
-    return -2;
+  // If the tuple is deleted or only forwarded from this slot, abort.
+  if (IsDeleted(tuple_size) || IsForwarded(slot_num)) {
+    return false;
   }
+  tuple_size = GetBytes(tuple_size);
   // If there is not enough space to update, we need to update via delete followed by an insert (not enough space).
   if (GetFreeSpaceRemaining() + tuple_size < serialized_size) {
-    return -3;
+    return false;
   }
   // Copy out the old value.
   uint32_t tuple_offset = GetTupleOffsetAtSlot(slot_num);
-  uint32_t __attribute__((unused)) read_bytes = old_row->DeserializeFrom(GetData() + tuple_offset, schema);
+  uint32_t __attribute__((unused)) read_bytes = format.DeserializeFrom(GetData() + tuple_offset, old_row);
   ASSERT(tuple_size == read_bytes, "Unexpected behavior in tuple deserialize.");
+  // A tuple of the same size, e.g. one whose fields are all fixed width, is overwritten in place.
+  if (serialized_size == tuple_size) {
+    format.SerializeTo(new_row, GetData() + tuple_offset);
+    return true;
+  }
+  format.SerializeTo(new_row, ResizeTuple(slot_num, serialized_size));
+  return true;
+}
+
+char *TablePage::ResizeTuple(uint32_t slot_num, uint32_t new_size) {
+  uint32_t tuple_size = GetTupleSize(slot_num);
+  uint32_t old_size = GetBytes(tuple_size);
+  if (GetFreeSpaceRemaining() + old_size < new_size) {
+    return nullptr;
+  }
+  uint32_t tuple_offset = GetTupleOffsetAtSlot(slot_num);
+  if (new_size == old_size) {
+    return GetData() + tuple_offset;
+  }
+  // The tuples stored below it shift by the size difference to close the gap or make room.
   uint32_t free_space_pointer = GetFreeSpacePointer();
   ASSERT(tuple_offset >= free_space_pointer, "Offset should appear after current free space position.");
-  memmove(GetData() + free_space_pointer + tuple_size - serialized_size, GetData() + free_space_pointer,
-          tuple_offset - free_space_pointer);
-  SetFreeSpacePointer(free_space_pointer + tuple_size - serialized_size);
-  new_row.SerializeTo(GetData() + tuple_offset + tuple_size - serialized_size, schema);
-  SetTupleSize(slot_num, serialized_size);
+  uint32_t tuple_end = tuple_offset + old_size;
+  int32_t delta = static_cast<int32_t>(old_size) - static_cast<int32_t>(new_size);
+  memmove(GetData() + free_space_pointer + delta, GetData() + free_space_pointer, tuple_offset - free_space_pointer);
+  SetFreeSpacePointer(free_space_pointer + delta);
+  SetTupleSize(slot_num, tuple_size - old_size + new_size);
 
-  // Update all tuple offsets.
+  // Update the offsets of the shifted tuples, the resized one included.
   for (uint32_t i = 0; i < GetTupleCount(); ++i) {
     uint32_t tuple_offset_i = GetTupleOffsetAtSlot(i);
-    if (GetTupleSize(i) > 0 && tuple_offset_i < tuple_offset + tuple_size) {
-      SetTupleOffsetAtSlot(i, tuple_offset_i + tuple_size - new_row.GetSerializedSize(schema));
+    if (tuple_offset_i < tuple_end && GetTupleSize(i) > 0) {
+      SetTupleOffsetAtSlot(i, tuple_offset_i + delta);
+    }
+  }
+  return GetData() + tuple_offset + delta;
+}
+
+bool TablePage::InsertRelocatedTuple(Row &row, Schema *schema) {
+  ASSERT(!IsPax(), "PAX tuples are always updated in place.");
+  if (!InsertTuple(row, schema, nullptr, nullptr, nullptr)) {
+    return false;
+  }
+  uint32_t slot_num = row.GetRowId().GetSlotNum();
+  SetTupleSize(slot_num, GetTupleSize(slot_num) | RELOCATED_MASK);
+  ClearSlotBit(GetLiveSlotBitmap(), slot_num);
+  return true;
+}
+
+bool TablePage::SetForward(uint32_t slot_num, const RowId &target, Row *old_row, Schema *schema) {
+  ASSERT(!IsPax() && IsTupleVisible(slot_num), "Only a visible tuple can be forwarded.");
+  uint32_t tuple_size = GetBytes(GetTupleSize(slot_num));
+  if (GetFreeSpaceRemaining() + tuple_size < SIZE_FORWARD_STUB) {
+    return false;
+  }
+  if (!IsForwarded(slot_num)) {
+    schema->GetRowFormat().DeserializeFrom(GetData() + GetTupleOffsetAtSlot(slot_num), old_row);
+  }
+  char *stub = ResizeTuple(slot_num, SIZE_FORWARD_STUB);
+  MACH_WRITE_TO(page_id_t, stub, target.GetPageId());
+  MACH_WRITE_UINT32(stub + sizeof(page_id_t), target.GetSlotNum());
+  SetTupleSize(slot_num, GetTupleSize(slot_num) | FORWARD_MASK);
+  return true;
+}
+
+bool TablePage::ClearForward(uint32_t slot_num, Row &row, Schema *schema) {
+  ASSERT(IsForwarded(slot_num) && IsTupleVisible(slot_num), "Slot holds no visible forwarding stub.");
+  char *tuple = ResizeTuple(slot_num, schema->GetRowFormat().GetSerializedSize(row));
+  if (tuple == nullptr) {
+    return false;
+  }
+  schema->GetRowFormat().SerializeTo(row, tuple);
+  SetTupleSize(slot_num, GetTupleSize(slot_num) & ~FORWARD_MASK);
+  return true;
+}
+
+bool TablePage::HasForwarding() {
+  if (IsPax()) {
+    return false;
+  }
+  for (uint32_t i = 0; i < GetTupleCount(); i++) {
+    if ((GetTupleSize(i) & (FORWARD_MASK | RELOCATED_MASK)) != 0) {
+      return true;
     }
   }
-  return 1;
+  return false;
 }
 
 void TablePage::ApplyDelete(const RowId &rid, Txn *txn, LogManager *log_manager) {
   uint32_t slot_num = rid.GetSlotNum();
   ASSERT(slot_num < GetTupleCount(), "Cannot have more slots than tuples.");
+  if (IsPax()) {
+    ApplyPaxDelete(slot_num);
+    return;
+  }
 
   uint32_t tuple_offset = GetTupleOffsetAtSlot(slot_num);
   uint32_t tuple_size = GetTupleSize(slot_num);
-  // Check if this is a delete operation, i.e. commit a delete.
-  if (IsDeleted(tuple_size)) {
-    tuple_size = UnsetDeletedFlag(tuple_size);
-  }
+  // Drop the flags, e.g. when committing a delete.
+  tuple_size = GetBytes(tuple_size);
 
   uint32_t free_space_pointer = GetFreeSpacePointer();
   ASSERT(tuple_offset >= free_space_pointer, "Free space appears before tuples.");
@@ -120,6 +227,8 @@ void TablePage::ApplyDelete(const RowId &rid, Txn *txn, LogManager *log_manager)
   SetFreeSpacePointer(free_space_pointer + tuple_size);
   SetTupleSize(slot_num, 0);
   SetTupleOffsetAtSlot(slot_num, 0);
+  SetSlotBit(GetFreeSlotBitmap(), slot_num);
+  ClearSlotBit(GetLiveSlotBitmap(), slot_num);
 
   // Update all tuple offsets.
   for (uint32_t i = 0; i < GetTupleCount(); ++i) {
@@ -133,12 +242,60 @@ void TablePage::ApplyDelete(const RowId &rid, Txn *txn, LogManager *log_manager)
 void TablePage::RollbackDelete(const RowId &rid, Txn *txn, LogManager *log_manager) {
   uint32_t slot_num = rid.GetSlotNum();
   ASSERT(slot_num < GetTupleCount(), "We can't have more slots than tuples.");
+  if (IsPax()) {
+    RollbackPaxDelete(slot_num);
+    return;
+  }
   uint32_t tuple_size = GetTupleSize(slot_num);
 
   // Unset the deleted flag.
-  if (IsDeleted(tuple_size)) {
+  if (IsDeleted(tuple_size) && tuple_size != 0) {
     SetTupleSize(slot_num, UnsetDeletedFlag(tuple_size));
+    SetSlotBit(GetLiveSlotBitmap(), slot_num);
+  }
+}
+
+uint32_t TablePage::Compact(Txn *, LogManager *) {
+  if (IsPax()) {
+    return CompactPax();
   }
+  char buffer[PAGE_SIZE];
+  uint32_t free_space_pointer = PAGE_SIZE;
+  uint32_t applied = 0;
+  uint32_t tuple_count = GetTupleCount();
+  for (uint32_t i = 0; i < tuple_count; i++) {
+    uint32_t tuple_size = GetTupleSize(i);
+    if (tuple_size == 0) {
+      continue;
+    }
+    if (IsDeleted(tuple_size)) {
+      SetTupleSize(i, 0);
+      SetTupleOffsetAtSlot(i, 0);
+      SetSlotBit(GetFreeSlotBitmap(), i);
+      applied++;
+      continue;
+    }
+    free_space_pointer -= GetBytes(tuple_size);
+    memcpy(buffer + free_space_pointer, GetData() + GetTupleOffsetAtSlot(i), GetBytes(tuple_size));
+    SetTupleOffsetAtSlot(i, free_space_pointer);
+  }
+  memcpy(GetData() + free_space_pointer, buffer + free_space_pointer, PAGE_SIZE - free_space_pointer);
+  SetFreeSpacePointer(free_space_pointer);
+  // Give back the slots after the last tuple.
+  while (tuple_count > 0 && GetTupleSize(tuple_count - 1) == 0) {
+    ClearSlotBit(GetFreeSlotBitmap(), --tuple_count);
+  }
+  SetTupleCount(tuple_count);
+  return applied;
+}
+
+uint32_t TablePage::GetLiveTupleCount() {
+  uint32_t count = 0;
+  const uint64_t *bitmap = GetLiveSlotBitmap();
+  for (uint32_t i = 0; i < MAX_SLOT_COUNT / 64; i++) {
+    count += __builtin_popcountll(bitmap[i]);
+  }
+  return count;
 }
 
 bool TablePage::GetTuple(Row *row, Schema *schema, Txn *txn, LockManager *lock_manager) {
@@ -149,26 +306,32 @@ bool TablePage::GetTuple(Row *row, Schema *schema, Txn *txn, LockManager *lock_m
   if (slot_num >= GetTupleCount()) {
     return false;
   }
+  if (IsPax()) {
+    if (!TestSlotBit(GetLiveSlotBitmap(), slot_num)) {
+      return false;
+    }
+    ReadPaxTuple(GetPaxLayout(schema), slot_num, row, schema);
+    return true;
+  }
   // Otherwise get the current tuple size too.
   uint32_t tuple_size = GetTupleSize(slot_num);
-  // If the tuple is deleted, abort the recovery.
-  if (IsDeleted(tuple_size)) {
+  // If the tuple is deleted or only forwarded from this slot, abort the recovery.
+  if (IsDeleted(tuple_size) || IsForwarded(slot_num)) {
     return false;
   }
   // At this point, we have at least a shared lock on the RID. Copy the tuple data into our result.
   uint32_t tuple_offset = GetTupleOffsetAtSlot(slot_num);
-  uint32_t __attribute__((unused)) read_bytes = row->DeserializeFrom(GetData() + tuple_offset, schema);
-  ASSERT(tuple_size == read_bytes, "Unexpected behavior in tuple deserialize.");
+  uint32_t __attribute__((unused)) read_bytes = schema->GetRowFormat().DeserializeFrom(GetData() + tuple_offset, row);
+  ASSERT(GetBytes(tuple_size) == read_bytes, "Unexpected behavior in tuple deserialize.");
   return true;
 }
 
 bool TablePage::GetFirstTupleRid(RowId *first_rid) {
   // Find and return the first valid tuple.
-  for (uint32_t i = 0; i < GetTupleCount(); i++) {
-    if (!IsDeleted(GetTupleSize(i))) {
-      first_rid->Set(GetTablePageId(), i);
-      return true;
-    }
+  uint32_t i = FindNextSetBit(GetLiveSlotBitmap(), 0, GetTupleCount());
+  if (i < GetTupleCount()) {
+    first_rid->Set(GetTablePageId(), i);
+    return true;
   }
   first_rid->Set(INVALID_PAGE_ID, 0);
   return false;
@@ -177,13 +340,115 @@ bool TablePage::GetFirstTupleRid(RowId *first_rid) {
 bool TablePage::GetNextTupleRid(const RowId &cur_rid, RowId *next_rid) {
   ASSERT(cur_rid.GetPageId() == GetTablePageId(), "Wrong table!");
   // Find and return the first valid tuple after our current slot number.
-  for (auto i = cur_rid.GetSlotNum() + 1; i < GetTupleCount(); i++) {
-    if (!IsDeleted(GetTupleSize(i))) {
-      next_rid->Set(GetTablePageId(), i);
-      return true;
-    }
+  uint32_t i = FindNextSetBit(GetLiveSlotBitmap(), cur_rid.GetSlotNum() + 1, GetTupleCount());
+  if (i < GetTupleCount()) {
+    next_rid->Set(GetTablePageId(), i);
+    return true;
   }
   // Otherwise return false as there are no more tuples.
   next_rid->Set(INVALID_PAGE_ID, 0);
   return false;
 }
+
+uint32_t TablePage::GetPaxFreeSlotCount() {
+  uint32_t count = GetPaxCapacity() - GetTupleCount();
+  const uint64_t *bitmap = GetFreeSlotBitmap();
+  for (uint32_t i = 0; i < MAX_SLOT_COUNT / 64; i++) {
+    count += __builtin_popcountll(bitmap[i]);
+  }
+  return count;
+}
+
+bool TablePage::InsertPaxTuple(Row &row, Schema *schema) {
+  // Reuse a free slot, otherwise take the next row of the minipages.
+  uint32_t i = FindNextSetBit(GetFreeSlotBitmap(), 0, GetTupleCount());
+  if (i == GetPaxCapacity()) {
+    return false;
+  }
+  if (!WritePaxTuple(GetPaxLayout(schema), i, row, schema)) {
+    return false;
+  }
+  row.SetRowId(RowId(GetTablePageId(), i));
+  ClearSlotBit(GetFreeSlotBitmap(), i);
+  SetSlotBit(GetLiveSlotBitmap(), i);
+  if (i == GetTupleCount()) {
+    SetTupleCount(GetTupleCount() + 1);
+  }
+  return true;
+}
+
+bool TablePage::MarkPaxDelete(uint32_t slot_num) {
+  if (!TestSlotBit(GetLiveSlotBitmap(), slot_num)) {
+    return false;
+  }
+  ClearSlotBit(GetLiveSlotBitmap(), slot_num);
+  return true;
+}
+
+bool TablePage::UpdatePaxTuple(Row &new_row, Row *old_row, Schema *schema) {
+  uint32_t slot_num = old_row->GetRowId().GetSlotNum();
+  if (slot_num >= GetTupleCount() || !TestSlotBit(GetLiveSlotBitmap(), slot_num)) {
+    return false;
+  }
+  // Every row of the schema fits into its slot, so the update is always done in place.
+  PaxLayout layout = GetPaxLayout(schema);
+  ReadPaxTuple(layout, slot_num, old_row, schema);
+  return WritePaxTuple(layout, slot_num, new_row, schema);
+}
+
+void TablePage::ApplyPaxDelete(uint32_t slot_num) {
+  SetSlotBit(GetFreeSlotBitmap(), slot_num);
+  ClearSlotBit(GetLiveSlotBitmap(), slot_num);
+}
+
+void TablePage::RollbackPaxDelete(uint32_t slot_num) {
+  if (!TestSlotBit(GetFreeSlotBitmap(), slot_num)) {
+    SetSlotBit(GetLiveSlotBitmap(), slot_num);
+  }
+}
+
+uint32_t TablePage::CompactPax() {
+  // Tuples stay in their rows, only the slots of the pending deletes are freed.
+  uint32_t applied = 0;
+  uint32_t tuple_count = GetTupleCount();
+  for (uint32_t i = 0; i < tuple_count; i++) {
+    if (TestSlotBit(GetFreeSlotBitmap(), i) || TestSlotBit(GetLiveSlotBitmap(), i)) {
+      continue;
+    }
+    SetSlotBit(GetFreeSlotBitmap(), i);
+    applied++;
+  }
+  while (tuple_count > 0 && TestSlotBit(GetFreeSlotBitmap(), tuple_count - 1)) {
+    ClearSlotBit(GetFreeSlotBitmap(), --tuple_count);
+  }
+  SetTupleCount(tuple_count);
+  return applied;
+}
+
+bool TablePage::WritePaxTuple(const PaxLayout &layout, uint32_t slot_num, Row &row, Schema *schema) {
+  const auto &fields = row.GetFields();
+  ASSERT(fields.size() == schema->GetColumnCount(), "Row does not match the schema.");
+  for (uint32_t i = 0; i < fields.size(); i++) {
+    if (fields[i].GetTypeId() == TypeId::kTypeChar && !fields[i].IsNull() &&
+        fields[i].GetLength() > schema->GetColumn(i)->GetLength()) {
+      return false;
+    }
+  }
+  for (uint32_t i = 0; i < fields.size(); i++) {
+    layout.SetNull(GetData(), i, slot_num, fields[i].IsNull());
+    if (!fields[i].IsNull()) {
+      fields[i].SerializeTo(GetData() + layout.GetValueOffset(i, slot_num));
+    }
+  }
+  return true;
+}
+
+void TablePage::ReadPaxTuple(const PaxLayout &layout, uint32_t slot_num, Row *row, Schema *schema) {
+  row->destroy();
+  row->SetRowId(RowId(GetTablePageId(), slot_num));
+  for (uint32_t i = 0; i < schema->GetColumnCount(); i++) {
+    Field &field = row->GetFields().emplace_back(schema->GetColumn(i)->GetType());
+    Field::DeserializeFrom(GetData() + layout.GetValueOffset(i, slot_num), schema->GetColumn(i)->GetType(), field,
+                           layout.IsNull(GetData(), i, slot_num), row->GetArena());
+  }
+}
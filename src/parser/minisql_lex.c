@@ -388,8 +388,8 @@ static void yy_fatal_error(yyconst char msg[]);
 	*yy_cp = '\0'; \
 	(yy_c_buf_p) = yy_cp;
 
-#define YY_NUM_RULES 56
-#define YY_END_OF_BUFFER 57
+#define YY_NUM_RULES 62
+#define YY_END_OF_BUFFER 63
 /* This struct is not used in this scanner,
    but its presence is necessary. */
 struct yy_trans_info {
@@ -397,28 +397,32 @@ struct yy_trans_info {
 	flex_int32_t yy_nxt;
 };
 
-static yyconst flex_int16_t yy_accept[175] =
+static yyconst flex_int16_t yy_accept[205] =
 {
 	0,
-	41, 41, 57, 55, 54, 54, 55, 49, 52, 53,
-	47, 46, 41, 55, 41, 48, 50, 42, 51, 39,
-	39, 39, 39, 39, 39, 39, 39, 39, 39, 39,
-	39, 39, 39, 39, 39, 39, 39, 39, 0, 1,
-	0, 0, 41, 40, 44, 43, 45, 39, 39, 39,
-	39, 39, 39, 39, 39, 39, 39, 39, 39, 39,
-	37, 39, 39, 39, 22, 35, 39, 39, 39, 39,
-	39, 39, 39, 39, 39, 39, 39, 34, 39, 39,
-	39, 39, 39, 39, 39, 39, 39, 39, 39, 39,
-	32, 29, 36, 39, 39, 39, 39, 39, 26, 39,
-
-	39, 39, 39, 14, 39, 39, 39, 39, 31, 39,
-	39, 39, 39, 3, 39, 39, 23, 39, 39, 25,
-	38, 39, 11, 39, 39, 13, 39, 39, 39, 39,
-	39, 39, 8, 39, 39, 39, 39, 39, 33, 20,
-	39, 39, 39, 39, 18, 39, 39, 15, 39, 24,
-	9, 2, 39, 6, 39, 39, 5, 39, 39, 4,
-	19, 30, 7, 27, 39, 39, 21, 28, 39, 16,
-	12, 10, 17, 0
+	47, 47, 63, 61, 60, 61, 55, 58, 59, 53,
+	52, 47, 61, 54, 56, 48, 57, 45, 45, 45,
+	45, 45, 45, 45, 45, 45, 45, 45, 45, 45,
+	45, 45, 45, 45, 45, 45, 45, 0, 1, 0,
+	0, 46, 50, 49, 51, 45, 45, 45, 45, 45,
+	45, 45, 45, 45, 45, 45, 45, 45, 37, 45,
+	45, 45, 45, 22, 35, 45, 45, 45, 45, 45,
+	45, 45, 45, 45, 45, 45, 45, 45, 45, 34,
+	45, 45, 45, 45, 45, 45, 45, 45, 45, 45,
+	45, 45, 45, 32, 29, 45, 36, 45, 45, 45,
+
+	45, 45, 26, 45, 45, 45, 45, 45, 14, 45,
+	45, 45, 45, 45, 45, 45, 31, 45, 45, 45,
+	45, 45, 3, 45, 45, 23, 45, 45, 25, 45,
+	38, 45, 11, 45, 45, 13, 45, 45, 45, 45,
+	45, 45, 45, 45, 40, 45, 8, 45, 45, 45,
+	45, 45, 45, 33, 20, 45, 45, 45, 45, 45,
+	18, 45, 45, 45, 15, 45, 45, 24, 45, 9,
+	2, 45, 6, 45, 45, 45, 5, 41, 45, 45,
+	4, 19, 45, 30, 7, 39, 27, 43, 45, 45,
+	45, 21, 28, 45, 45, 16, 45, 12, 10, 44,
+
+	17, 45, 42, 0
 };
 
 static yyconst flex_int32_t yy_ec[256] =
@@ -437,7 +441,7 @@ static yyconst flex_int32_t yy_ec[256] =
 
 	23, 24, 25, 26, 27, 17, 28, 29, 30, 31,
 	32, 33, 34, 35, 36, 37, 38, 39, 40, 41,
-	42, 17, 1, 1, 1, 1, 1, 1, 1, 1,
+	42, 43, 1, 1, 1, 1, 1, 1, 1, 1,
 	1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
 	1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
 	1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
@@ -454,133 +458,166 @@ static yyconst flex_int32_t yy_ec[256] =
 	1, 1, 1, 1, 1
 };
 
-static yyconst flex_int32_t yy_meta[43] =
+static yyconst flex_int32_t yy_meta[44] =
 {
 	0,
 	1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-	1, 2, 1, 1, 1, 1, 2, 1, 2, 2,
-	2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-	2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-	2, 2
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1
 };
 
-static yyconst flex_int16_t yy_base[177] =
+static yyconst flex_int16_t yy_base[205] =
 {
 	0,
-	0, 0, 188, 189, 189, 189, 39, 189, 189, 189,
-	189, 189, 33, 175, 35, 189, 33, 189, 171, 0,
-	154, 161, 24, 32, 142, 23, 29, 159, 30, 35,
-	146, 142, 147, 38, 159, 38, 158, 150, 59, 189,
-	172, 162, 42, 161, 189, 189, 189, 0, 150, 146,
-	151, 139, 145, 130, 137, 133, 141, 131, 130, 50,
-	0, 119, 123, 130, 0, 0, 131, 130, 127, 44,
-	123, 134, 126, 130, 52, 122, 127, 0, 122, 113,
-	117, 127, 126, 121, 110, 121, 122, 110, 116, 115,
-	105, 0, 0, 107, 105, 97, 104, 109, 0, 91,
-
-	101, 95, 109, 0, 96, 88, 90, 93, 0, 96,
-	85, 101, 83, 0, 95, 81, 0, 76, 81, 0,
-	0, 96, 0, 94, 92, 0, 89, 73, 73, 84,
-	85, 84, 0, 69, 82, 85, 80, 75, 0, 78,
-	63, 64, 79, 60, 60, 72, 71, 0, 57, 0,
-	0, 0, 56, 0, 62, 54, 0, 43, 63, 0,
-	0, 0, 0, 0, 60, 59, 0, 0, 52, 42,
-	0, 0, 0, 189, 87, 74
+	0, 1, 44, 44, 44, 87, 44, 44, 44, 44,
+	44, 164, 173, 44, 165, 44, 178, 119, 102, 112,
+	142, 144, 125, 153, 158, 160, 184, 159, 161, 176,
+	170, 181, 172, 171, 101, 191, 174, 2, 44, 166,
+	3, 4, 44, 44, 44, 180, 189, 197, 187, 195,
+	183, 190, 200, 192, 199, 193, 194, 150, 5, 185,
+	188, 196, 202, 6, 7, 201, 205, 206, 175, 204,
+	203, 207, 210, 212, 182, 186, 215, 209, 211, 8,
+	214, 208, 217, 220, 223, 221, 213, 216, 227, 232,
+	222, 230, 231, 224, 9, 225, 10, 226, 228, 229,
+
+	233, 236, 11, 234, 235, 198, 237, 241, 12, 238,
+	239, 240, 244, 242, 219, 245, 13, 243, 246, 247,
+	248, 253, 14, 249, 250, 15, 251, 254, 16, 252,
+	17, 256, 18, 261, 263, 19, 259, 265, 255, 257,
+	266, 258, 272, 274, 20, 260, 21, 262, 275, 269,
+	277, 270, 278, 22, 281, 264, 271, 276, 287, 273,
+	279, 288, 286, 289, 23, 283, 280, 24, 291, 25,
+	26, 282, 27, 290, 293, 284, 28, 29, 285, 296,
+	30, 31, 292, 32, 33, 34, 35, 36, 300, 305,
+	302, 37, 38, 298, 307, 295, 297, 39, 40, 41,
+
+	42, 294, 43, 44
 };
 
-static yyconst flex_int16_t yy_def[177] =
+static yyconst flex_int16_t yy_def[205] =
 {
 	0,
-	174, 1, 174, 174, 174, 174, 175, 174, 174, 174,
-	174, 174, 174, 174, 174, 174, 174, 174, 174, 176,
-	176, 176, 176, 176, 176, 176, 176, 176, 176, 176,
-	176, 176, 176, 176, 176, 176, 176, 176, 175, 174,
-	175, 174, 174, 174, 174, 174, 174, 176, 176, 176,
-	176, 176, 176, 176, 176, 176, 176, 176, 176, 176,
-	176, 176, 176, 176, 176, 176, 176, 176, 176, 176,
-	176, 176, 176, 176, 176, 176, 176, 176, 176, 176,
-	176, 176, 176, 176, 176, 176, 176, 176, 176, 176,
-	176, 176, 176, 176, 176, 176, 176, 176, 176, 176,
-
-	176, 176, 176, 176, 176, 176, 176, 176, 176, 176,
-	176, 176, 176, 176, 176, 176, 176, 176, 176, 176,
-	176, 176, 176, 176, 176, 176, 176, 176, 176, 176,
-	176, 176, 176, 176, 176, 176, 176, 176, 176, 176,
-	176, 176, 176, 176, 176, 176, 176, 176, 176, 176,
-	176, 176, 176, 176, 176, 176, 176, 176, 176, 176,
-	176, 176, 176, 176, 176, 176, 176, 176, 176, 176,
-	176, 176, 176, 0, 174, 174
+	204, 1, 204, 204, 204, 1, 204, 204, 204, 204,
+	204, 204, 204, 204, 204, 204, 204, 13, 18, 18,
+	18, 18, 18, 18, 18, 18, 18, 18, 18, 18,
+	18, 18, 18, 18, 18, 18, 18, 6, 204, 6,
+	13, 13, 204, 204, 204, 18, 18, 18, 18, 18,
+	18, 18, 18, 18, 18, 18, 18, 18, 18, 18,
+	18, 18, 18, 18, 18, 18, 18, 18, 18, 18,
+	18, 18, 18, 18, 18, 18, 18, 18, 18, 18,
+	18, 18, 18, 18, 18, 18, 18, 18, 18, 18,
+	18, 18, 18, 18, 18, 18, 18, 18, 18, 18,
+
+	18, 18, 18, 18, 18, 18, 18, 18, 18, 18,
+	18, 18, 18, 18, 18, 18, 18, 18, 18, 18,
+	18, 18, 18, 18, 18, 18, 18, 18, 18, 18,
+	18, 18, 18, 18, 18, 18, 18, 18, 18, 18,
+	18, 18, 18, 18, 18, 18, 18, 18, 18, 18,
+	18, 18, 18, 18, 18, 18, 18, 18, 18, 18,
+	18, 18, 18, 18, 18, 18, 18, 18, 18, 18,
+	18, 18, 18, 18, 18, 18, 18, 18, 18, 18,
+	18, 18, 18, 18, 18, 18, 18, 18, 18, 18,
+	18, 18, 18, 18, 18, 18, 18, 18, 18, 18,
+
+	18, 18, 18, 204
 };
 
-static yyconst flex_int16_t yy_nxt[232] =
+static yyconst flex_int16_t yy_nxt[351] =
 {
-	0,
-	4, 5, 6, 7, 8, 9, 10, 11, 12, 13,
-	14, 15, 16, 17, 18, 19, 20, 4, 21, 22,
-	23, 24, 25, 26, 20, 20, 27, 28, 20, 20,
-	29, 30, 31, 32, 33, 34, 35, 36, 37, 38,
-	20, 20, 40, 42, 43, 42, 43, 45, 46, 51,
-	54, 58, 42, 43, 55, 52, 41, 59, 53, 60,
-	70, 63, 40, 71, 61, 65, 56, 64, 73, 66,
-	74, 89, 98, 75, 104, 48, 41, 173, 105, 172,
-	99, 171, 170, 169, 168, 90, 91, 39, 39, 167,
-	166, 165, 164, 163, 162, 161, 160, 159, 158, 157,
-
-	156, 155, 154, 153, 152, 151, 150, 149, 148, 147,
-	146, 145, 144, 143, 142, 141, 140, 139, 138, 137,
-	136, 135, 134, 133, 132, 131, 130, 129, 128, 127,
-	126, 125, 124, 123, 122, 121, 120, 119, 118, 117,
-	116, 115, 114, 113, 112, 111, 110, 109, 108, 107,
-	106, 103, 102, 101, 100, 97, 96, 95, 94, 93,
-	92, 88, 87, 86, 85, 84, 83, 82, 81, 80,
-	79, 78, 44, 44, 174, 77, 76, 72, 69, 68,
-	67, 62, 57, 50, 49, 47, 44, 174, 3, 174,
-	174, 174, 174, 174, 174, 174, 174, 174, 174, 174,
-
-	174, 174, 174, 174, 174, 174, 174, 174, 174, 174,
-	174, 174, 174, 174, 174, 174, 174, 174, 174, 174,
-	174, 174, 174, 174, 174, 174, 174, 174, 174, 174,
-	174
+	3,
+	4, 5, 5, 6, 7, 8, 9, 10, 11, 12,
+	13, 12, 14, 15, 16, 17, 18, 4, 19, 20,
+	21, 22, 23, 24, 18, 18, 25, 26, 27, 18,
+	28, 29, 30, 31, 32, 33, 34, 35, 36, 37,
+	18, 18, 18, 204, 204, 204, 204, 204, 204, 204,
+	204, 204, 204, 204, 204, 204, 204, 204, 204, 204,
+	204, 204, 204, 204, 204, 204, 204, 204, 204, 204,
+	204, 204, 204, 204, 204, 204, 204, 204, 204, 204,
+	204, 204, 204, 204, 204, 204, 204, 38, 38, 38,
+	39, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+
+	38, 38, 38, 38, 40, 38, 38, 38, 38, 38,
+	38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+	38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+	18, 73, 46, 74, 47, 18, 75, 18, 18, 18,
+	18, 18, 18, 18, 18, 18, 18, 18, 18, 18,
+	18, 18, 18, 18, 18, 18, 18, 18, 18, 18,
+	18, 18, 51, 3, 3, 55, 52, 48, 204, 38,
+	53, 92, 3, 49, 41, 12, 50, 3, 54, 43,
+	44, 56, 60, 38, 42, 93, 94, 57, 58, 71,
+	62, 64, 45, 59, 69, 65, 63, 70, 79, 77,
+
+	78, 80, 61, 102, 109, 72, 111, 67, 110, 76,
+	66, 103, 68, 81, 112, 82, 83, 84, 86, 85,
+	87, 89, 105, 88, 90, 91, 95, 99, 138, 96,
+	98, 100, 97, 108, 101, 104, 107, 113, 119, 115,
+	116, 120, 117, 121, 106, 114, 118, 124, 123, 122,
+	125, 126, 127, 128, 131, 129, 130, 132, 135, 140,
+	146, 134, 0, 137, 0, 133, 150, 145, 141, 148,
+	139, 0, 153, 136, 158, 147, 142, 143, 144, 152,
+	159, 161, 149, 160, 151, 162, 154, 172, 156, 157,
+	165, 155, 163, 164, 167, 166, 168, 171, 170, 173,
+
+	177, 174, 169, 176, 175, 180, 183, 178, 184, 181,
+	179, 185, 186, 188, 182, 187, 194, 189, 0, 192,
+	190, 191, 196, 197, 198, 199, 193, 0, 195, 200,
+	201, 202, 0, 0, 0, 203, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0
 };
 
-static yyconst flex_int16_t yy_chk[232] =
+static yyconst flex_int16_t yy_chk[351] =
 {
-	0,
+	1,
 	1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
 	1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
 	1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
 	1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-	1, 1, 7, 13, 13, 15, 15, 17, 17, 23,
-	24, 26, 43, 43, 24, 23, 7, 26, 23, 27,
-	34, 29, 39, 34, 27, 30, 24, 29, 36, 30,
-	36, 60, 70, 36, 75, 176, 39, 170, 75, 169,
-	70, 166, 165, 159, 158, 60, 60, 175, 175, 156,
-	155, 153, 149, 147, 146, 145, 144, 143, 142, 141,
-
-	140, 138, 137, 136, 135, 134, 132, 131, 130, 129,
-	128, 127, 125, 124, 122, 119, 118, 116, 115, 113,
-	112, 111, 110, 108, 107, 106, 105, 103, 102, 101,
-	100, 98, 97, 96, 95, 94, 91, 90, 89, 88,
-	87, 86, 85, 84, 83, 82, 81, 80, 79, 77,
-	76, 74, 73, 72, 71, 69, 68, 67, 64, 63,
-	62, 59, 58, 57, 56, 55, 54, 53, 52, 51,
-	50, 49, 44, 42, 41, 38, 37, 35, 33, 32,
-	31, 28, 25, 22, 21, 19, 14, 3, 174, 174,
-	174, 174, 174, 174, 174, 174, 174, 174, 174, 174,
-
-	174, 174, 174, 174, 174, 174, 174, 174, 174, 174,
-	174, 174, 174, 174, 174, 174, 174, 174, 174, 174,
-	174, 174, 174, 174, 174, 174, 174, 174, 174, 174,
-	174
+	1, 1, 1, 204, 204, 204, 204, 204, 204, 204,
+	204, 204, 204, 204, 204, 204, 204, 204, 204, 204,
+	204, 204, 204, 204, 204, 204, 204, 204, 204, 204,
+	204, 204, 204, 204, 204, 204, 204, 204, 204, 204,
+	204, 204, 204, 204, 204, 204, 204, 6, 6, 6,
+	6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+
+	6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+	6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+	6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+	18, 35, 19, 35, 20, 18, 35, 18, 18, 18,
+	18, 18, 18, 18, 18, 18, 18, 18, 18, 18,
+	18, 18, 18, 18, 18, 18, 18, 18, 18, 18,
+	18, 18, 22, 12, 15, 23, 22, 21, 40, 40,
+	22, 58, 13, 21, 12, 12, 21, 17, 22, 15,
+	15, 24, 26, 40, 13, 58, 58, 24, 25, 34,
+	28, 29, 17, 25, 33, 29, 28, 33, 46, 37,
+
+	37, 46, 27, 69, 75, 34, 76, 31, 75, 36,
+	30, 69, 32, 47, 76, 48, 49, 50, 52, 51,
+	53, 55, 71, 54, 56, 57, 60, 66, 106, 61,
+	63, 67, 62, 74, 68, 70, 73, 77, 84, 79,
+	81, 85, 82, 86, 72, 78, 83, 89, 88, 87,
+	90, 91, 92, 93, 98, 94, 96, 99, 102, 108,
+	115, 101, 0, 105, 0, 100, 120, 114, 110, 118,
+	107, 0, 124, 104, 132, 116, 111, 112, 113, 122,
+	134, 137, 119, 135, 121, 138, 125, 150, 128, 130,
+	141, 127, 139, 140, 143, 142, 144, 149, 148, 151,
+
+	156, 152, 146, 155, 153, 159, 162, 157, 163, 160,
+	158, 164, 166, 169, 161, 167, 180, 172, 0, 176,
+	174, 175, 189, 190, 191, 194, 179, 0, 183, 195,
+	196, 197, 0, 0, 0, 202, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0
 };
 
 /* Table of booleans, true if rule could match eol. */
-static yyconst flex_int32_t yy_rule_can_match_eol[57] =
+static yyconst flex_int32_t yy_rule_can_match_eol[63] =
 {
 	0,
 	1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 1, 0, 0,
 };
 
 static yy_state_type yy_last_accepting_state;
@@ -601,13 +638,10 @@ char *yytext;
 #line 2 "minisql.l"
 #include <stdio.h>
 #include "parser/parser.h"
-
 #include "parser/minisql_yacc.h"
-
 int yywrap();
-
 extern YYSTYPE yylval;
-#line 585 "../../parser/minisql_lex.c"
+#line 645 "../../parser/minisql_lex.c"
 
 #define INITIAL 0
 
@@ -789,7 +823,7 @@ YY_DECL {
 #line 15 "minisql.l"
 
 
-#line 770 "../../parser/minisql_lex.c"
+#line 827 "../../parser/minisql_lex.c"
 
 	if (!(yy_init)) {
 		(yy_init) = 1;
@@ -838,12 +872,12 @@ YY_DECL {
 			}
 			while (yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state) {
 				yy_current_state = (int) yy_def[yy_current_state];
-				if (yy_current_state >= 175)
+				if (yy_current_state >= 205)
 					yy_c = yy_meta[(unsigned int) yy_c];
 			}
 			yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int) yy_c];
 			++yy_cp;
-		} while (yy_base[yy_current_state] != 189);
+		} while (yy_base[yy_current_state] != 44);
 
 	yy_find_action:
 		yy_act = yy_accept[yy_current_state];
@@ -1186,74 +1220,74 @@ YY_DECL {
 #line 208 "minisql.l"
 			{
 				MinisqlParserMovePos(yylineno, yytext);
-				yylval.syntax_node = CreateSyntaxNode(kNodeIdentifier, yytext);
-				return IDENTIFIER;
+				return VACUUM;
 			}
 				YY_BREAK
 			case 40:
 				YY_RULE_SETUP
-#line 214 "minisql.l"
+#line 213 "minisql.l"
 			{
 				MinisqlParserMovePos(yylineno, yytext);
-				yylval.syntax_node = CreateSyntaxNode(kNodeNumber, yytext);
-				return NUMBER;
+				return WITH;
 			}
 				YY_BREAK
 			case 41:
 				YY_RULE_SETUP
-#line 220 "minisql.l"
+#line 218 "minisql.l"
 			{
 				MinisqlParserMovePos(yylineno, yytext);
-				yylval.syntax_node = CreateSyntaxNode(kNodeNumber, yytext);
-				return NUMBER;
+				return LAYOUT;
 			}
 				YY_BREAK
 			case 42:
 				YY_RULE_SETUP
-#line 226 "minisql.l"
+#line 223 "minisql.l"
 			{
 				MinisqlParserMovePos(yylineno, yytext);
-				return EQ;
+				return DICTIONARY;
 			}
 				YY_BREAK
 			case 43:
 				YY_RULE_SETUP
-#line 231 "minisql.l"
+#line 228 "minisql.l"
 			{
 				MinisqlParserMovePos(yylineno, yytext);
-				return NE;
+				return ANALYZE;
 			}
 				YY_BREAK
 			case 44:
 				YY_RULE_SETUP
-#line 236 "minisql.l"
+#line 233 "minisql.l"
 			{
 				MinisqlParserMovePos(yylineno, yytext);
-				return LE;
+				return TRUNCATE;
 			}
 				YY_BREAK
 			case 45:
 				YY_RULE_SETUP
-#line 241 "minisql.l"
+#line 238 "minisql.l"
 			{
 				MinisqlParserMovePos(yylineno, yytext);
-				return GE;
+				yylval.syntax_node = CreateSyntaxNode(kNodeIdentifier, yytext);
+				return IDENTIFIER;
 			}
 				YY_BREAK
 			case 46:
 				YY_RULE_SETUP
-#line 246 "minisql.l"
+#line 244 "minisql.l"
 			{
 				MinisqlParserMovePos(yylineno, yytext);
-				return (',');
+				yylval.syntax_node = CreateSyntaxNode(kNodeNumber, yytext);
+				return NUMBER;
 			}
 				YY_BREAK
 			case 47:
 				YY_RULE_SETUP
-#line 251 "minisql.l"
+#line 250 "minisql.l"
 			{
 				MinisqlParserMovePos(yylineno, yytext);
-				return ('*');
+				yylval.syntax_node = CreateSyntaxNode(kNodeNumber, yytext);
+				return NUMBER;
 			}
 				YY_BREAK
 			case 48:
@@ -1261,7 +1295,7 @@ YY_DECL {
 #line 256 "minisql.l"
 			{
 				MinisqlParserMovePos(yylineno, yytext);
-				return (';');
+				return EQ;
 			}
 				YY_BREAK
 			case 49:
@@ -1269,7 +1303,7 @@ YY_DECL {
 #line 261 "minisql.l"
 			{
 				MinisqlParserMovePos(yylineno, yytext);
-				return ('\'');
+				return NE;
 			}
 				YY_BREAK
 			case 50:
@@ -1277,7 +1311,7 @@ YY_DECL {
 #line 266 "minisql.l"
 			{
 				MinisqlParserMovePos(yylineno, yytext);
-				return ('<');
+				return LE;
 			}
 				YY_BREAK
 			case 51:
@@ -1285,7 +1319,7 @@ YY_DECL {
 #line 271 "minisql.l"
 			{
 				MinisqlParserMovePos(yylineno, yytext);
-				return ('>');
+				return GE;
 			}
 				YY_BREAK
 			case 52:
@@ -1293,7 +1327,7 @@ YY_DECL {
 #line 276 "minisql.l"
 			{
 				MinisqlParserMovePos(yylineno, yytext);
-				return ('(');
+				return (',');
 			}
 				YY_BREAK
 			case 53:
@@ -1301,32 +1335,80 @@ YY_DECL {
 #line 281 "minisql.l"
 			{
 				MinisqlParserMovePos(yylineno, yytext);
-				return (')');
+				return ('*');
 			}
 				YY_BREAK
 			case 54:
-				/* rule 54 can match eol */
 				YY_RULE_SETUP
 #line 286 "minisql.l"
 			{
 				MinisqlParserMovePos(yylineno, yytext);
+				return (';');
 			}
 				YY_BREAK
 			case 55:
 				YY_RULE_SETUP
-#line 290 "minisql.l"
+#line 291 "minisql.l"
+			{
+				MinisqlParserMovePos(yylineno, yytext);
+				return ('\'');
+			}
+				YY_BREAK
+			case 56:
+				YY_RULE_SETUP
+#line 296 "minisql.l"
+			{
+				MinisqlParserMovePos(yylineno, yytext);
+				return ('<');
+			}
+				YY_BREAK
+			case 57:
+				YY_RULE_SETUP
+#line 301 "minisql.l"
+			{
+				MinisqlParserMovePos(yylineno, yytext);
+				return ('>');
+			}
+				YY_BREAK
+			case 58:
+				YY_RULE_SETUP
+#line 306 "minisql.l"
+			{
+				MinisqlParserMovePos(yylineno, yytext);
+				return ('(');
+			}
+				YY_BREAK
+			case 59:
+				YY_RULE_SETUP
+#line 311 "minisql.l"
+			{
+				MinisqlParserMovePos(yylineno, yytext);
+				return (')');
+			}
+				YY_BREAK
+			case 60:
+				/* rule 60 can match eol */
+				YY_RULE_SETUP
+#line 316 "minisql.l"
+			{
+				MinisqlParserMovePos(yylineno, yytext);
+			}
+				YY_BREAK
+			case 61:
+				YY_RULE_SETUP
+#line 320 "minisql.l"
 			{
 				char str[128] = {0};
 				sprintf(str, "Unrecognized token [%s] in input sql.", yytext);
 				MinisqlParserSetError(str);
 			}
 				YY_BREAK
-			case 56:
+			case 62:
 				YY_RULE_SETUP
-#line 296 "minisql.l"
+#line 326 "minisql.l"
 				ECHO;
 				YY_BREAK
-#line 1314 "../../parser/minisql_lex.c"
+#line 1412 "../../parser/minisql_lex.c"
 			case YY_STATE_EOF(INITIAL):
 				yyterminate();
 
@@ -1586,7 +1668,7 @@ static yy_state_type yy_get_previous_state(void) {
 		}
 		while (yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state) {
 			yy_current_state = (int) yy_def[yy_current_state];
-			if (yy_current_state >= 175)
+			if (yy_current_state >= 205)
 				yy_c = yy_meta[(unsigned int) yy_c];
 		}
 		yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int) yy_c];
@@ -1611,11 +1693,11 @@ static yy_state_type yy_try_NUL_trans(yy_state_type yy_current_state) {
 	}
 	while (yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state) {
 		yy_current_state = (int) yy_def[yy_current_state];
-		if (yy_current_state >= 175)
+		if (yy_current_state >= 205)
 			yy_c = yy_meta[(unsigned int) yy_c];
 	}
 	yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int) yy_c];
-	yy_is_jam = (yy_current_state == 174);
+	yy_is_jam = (yy_current_state == 204);
 
 	return yy_is_jam ? 0 : yy_current_state;
 }
@@ -2254,7 +2336,7 @@ void yyfree(void *ptr) {
 
 #define YYTABLES_NAME "yytables"
 
-#line 296 "minisql.l"
+#line 326 "minisql.l"
 
 
 int yywrap() {
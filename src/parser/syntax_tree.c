@@ -171,6 +171,14 @@ const char *GetSyntaxNodeTypeStr(SyntaxNodeType type) {
       return "kNodeTrxCommit";
     case kNodeTrxRollback:
       return "kNodeTrxRollback";
+    case kNodeVacuum:
+      return "kNodeVacuum";
+    case kNodeTableLayout:
+      return "kNodeTableLayout";
+    case kNodeAnalyze:
+      return "kNodeAnalyze";
+    case kNodeTruncate:
+      return "kNodeTruncate";
     default:
       return "error type";
   }
@@ -3,6 +3,9 @@
 //
 #include "planner/planner.h"
 
+#include <algorithm>
+#include <thread>
+
 void Planner::PlanQuery(pSyntaxNode ast) {
   switch (ast->type_) {
     case kNodeSelect: {
@@ -48,7 +51,14 @@ AbstractPlanNodeRef Planner::PlanSelect(std::shared_ptr<SelectStatement> stateme
     }
   }
   if (available_index.empty() || statement->has_or) {
-    return make_shared<SeqScanPlanNode>(out_schema, statement->table_name_, statement->where_);
+    auto scan_plan = make_shared<SeqScanPlanNode>(out_schema, statement->table_name_, statement->where_);
+    // only a read-only scan may run in parallel, updates and deletes modify the heap while consuming it
+    TableInfo *info = nullptr;
+    if (context_->GetCatalog()->GetTable(statement->table_name_, info) == DB_SUCCESS &&
+        info->GetTableHeap()->GetPageCount() >= PARALLEL_SCAN_MIN_PAGES) {
+      scan_plan->parallelism_ = std::clamp(std::thread::hardware_concurrency(), 1U, PARALLEL_SCAN_MAX_THREADS);
+    }
+    return scan_plan;
   }
   return make_shared<IndexScanPlanNode>(out_schema, statement->table_name_, available_index,
                                         available_index.size() != statement->column_in_condition_.size(),
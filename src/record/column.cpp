@@ -33,7 +33,8 @@ Column::Column(const Column *other)
     len_(other->len_),
     table_ind_(other->table_ind_),
     nullable_(other->nullable_),
-    unique_(other->unique_) {
+    unique_(other->unique_),
+    dictionary_(other->dictionary_) {
 }
 
 /**
@@ -64,6 +65,9 @@ uint32_t Column::SerializeTo(char *buf) const {
   //unique
   MACH_WRITE_TO(bool, buf+op, unique_);
   op += sizeof(bool);
+  //dictionary encoded
+  MACH_WRITE_TO(bool, buf+op, dictionary_);
+  op += sizeof(bool);
   return op;
 }
 
@@ -75,7 +79,7 @@ uint32_t Column::GetSerializedSize() const {
   op += sizeof(uint32_t)*4;
   op += name_.length();
   op += sizeof(TypeId);
-  op += sizeof(bool)*2;
+  op += sizeof(bool)*3;
   return op;
 }
 
@@ -110,10 +114,13 @@ uint32_t Column::DeserializeFrom(char *buf, Column *&column) {
   op += sizeof(bool);
   bool unique = MACH_READ_FROM(bool, buf+op);
   op += sizeof(bool);
+  bool dictionary = MACH_READ_FROM(bool, buf+op);
+  op += sizeof(bool);
   if (type == kTypeChar) {
     column = new Column(name, type, len, table_ind, nullable, unique);
   } else {
     column = new Column(name, type, table_ind, nullable, unique);
   }
+  column->SetDictionary(dictionary);
   return op;
 }
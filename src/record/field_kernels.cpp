@@ -0,0 +1,83 @@
+#include "record/field_kernels.h"
+
+#include <stdexcept>
+
+CmpOp ParseCmpOp(const std::string &comp) {
+  if (comp == "=") {
+    return CmpOp::kEqual;
+  } else if (comp == "<>") {
+    return CmpOp::kNotEqual;
+  } else if (comp == "<") {
+    return CmpOp::kLessThan;
+  } else if (comp == "<=") {
+    return CmpOp::kLessThanEquals;
+  } else if (comp == ">") {
+    return CmpOp::kGreaterThan;
+  } else if (comp == ">=") {
+    return CmpOp::kGreaterThanEquals;
+  } else if (comp == "is") {
+    return CmpOp::kIsNull;
+  } else if (comp == "not") {
+    return CmpOp::kIsNotNull;
+  }
+  throw std::logic_error("Unsupported comparison type");
+}
+
+namespace {
+
+template <TypeId type>
+FieldCompareFn GetTypedCompareKernel(CmpOp op) {
+  switch (op) {
+    case CmpOp::kEqual:
+      return CompareFields<type, CmpOp::kEqual>;
+    case CmpOp::kNotEqual:
+      return CompareFields<type, CmpOp::kNotEqual>;
+    case CmpOp::kLessThan:
+      return CompareFields<type, CmpOp::kLessThan>;
+    case CmpOp::kLessThanEquals:
+      return CompareFields<type, CmpOp::kLessThanEquals>;
+    case CmpOp::kGreaterThan:
+      return CompareFields<type, CmpOp::kGreaterThan>;
+    case CmpOp::kGreaterThanEquals:
+      return CompareFields<type, CmpOp::kGreaterThanEquals>;
+    default:
+      return nullptr;
+  }
+}
+
+}  // namespace
+
+FieldCompareFn GetCompareKernel(TypeId type, CmpOp op) {
+  switch (type) {
+    case TypeId::kTypeInt:
+      return GetTypedCompareKernel<TypeId::kTypeInt>(op);
+    case TypeId::kTypeFloat:
+      return GetTypedCompareKernel<TypeId::kTypeFloat>(op);
+    case TypeId::kTypeChar:
+      return GetTypedCompareKernel<TypeId::kTypeChar>(op);
+    default:
+      return nullptr;
+  }
+}
+
+CmpBool CompareFields(const Field &lhs, const Field &rhs, CmpOp op) {
+  switch (op) {
+    case CmpOp::kEqual:
+      return lhs.CompareEquals(rhs);
+    case CmpOp::kNotEqual:
+      return lhs.CompareNotEquals(rhs);
+    case CmpOp::kLessThan:
+      return lhs.CompareLessThan(rhs);
+    case CmpOp::kLessThanEquals:
+      return lhs.CompareLessThanEquals(rhs);
+    case CmpOp::kGreaterThan:
+      return lhs.CompareGreaterThan(rhs);
+    case CmpOp::kGreaterThanEquals:
+      return lhs.CompareGreaterThanEquals(rhs);
+    case CmpOp::kIsNull:
+      return GetCmpBool(lhs.IsNull());
+    case CmpOp::kIsNotNull:
+      return GetCmpBool(!lhs.IsNull());
+  }
+  return CmpBool::kNull;
+}
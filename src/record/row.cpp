@@ -15,7 +15,7 @@ uint32_t Row::SerializeTo(char *buf, Schema *schema) const {
   unsigned char bitmap[field_num / 8 + 1];
   memset(bitmap, 0, field_num / 8 + 1);
   for (int i = 0; i < field_num; i++) {
-    if (!fields_[i]->IsNull()) {
+    if (!fields_[i].IsNull()) {
       uint32_t t_b = i / 8;
       uint32_t t_o = i % 8;
       char temp = 1 << (7 - t_o);
@@ -30,7 +30,7 @@ uint32_t Row::SerializeTo(char *buf, Schema *schema) const {
   }
   //field
   for (int i = 0; i < field_num; i++) {
-    op += fields_[i]->SerializeTo(buf + op);
+    op += fields_[i].SerializeTo(buf + op);
   }
   return op;
 }
@@ -56,13 +56,12 @@ uint32_t Row::DeserializeFrom(char *buf, Schema *schema) {
     uint32_t t_a = i % 8;
     char temp = 1 << (7 - t_a);
     //not null
-    Field *t_field;
+    Field &t_field = fields_.emplace_back(schema->GetColumn(i)->GetType());
     if ((bitmap[t_b] & temp) != 0) {
-      op += Field::DeserializeFrom(buf + op, schema->GetColumn(i)->GetType(), &t_field, false);
+      op += Field::DeserializeFrom(buf + op, schema->GetColumn(i)->GetType(), t_field, false, arena_);
     } else {
-      op += Field::DeserializeFrom(buf + op, schema->GetColumn(i)->GetType(), &t_field, true);
+      op += Field::DeserializeFrom(buf + op, schema->GetColumn(i)->GetType(), t_field, true, arena_);
     }
-    fields_.push_back(t_field);
   }
 
   return op;
@@ -79,18 +78,58 @@ uint32_t Row::GetSerializedSize(Schema *schema) const {
     op += sizeof(char);
   }
   for (int i = 0; i < field_num; i++) {
-    op += fields_[i]->GetSerializedSize();
+    op += fields_[i].GetSerializedSize();
   }
   return op;
 }
 
 void Row::GetKeyFromRow(const Schema *schema, const Schema *key_schema, Row &key_row) {
-  auto columns = key_schema->GetColumns();
-  std::vector<Field> fields;
+  key_row.destroy();
+  key_row.SetRowId(RowId());
   uint32_t idx;
-  for (auto column: columns) {
+  for (auto column: key_schema->GetColumns()) {
     schema->GetColumnIndex(column->GetName(), idx);
-    fields.emplace_back(*this->GetField(idx));
+    key_row.AppendField(*this->GetField(idx));
   }
-  key_row = Row(fields);
+}
+
+bool Row::FitsSchema(const Schema *schema, uint32_t &column_idx) const {
+  for (uint32_t i = 0; i < fields_.size(); i++) {
+    const Column *column = schema->GetColumn(i);
+    // a char column whose field has another type holds an encoded value
+    if (fields_[i].GetTypeId() == TypeId::kTypeChar && !fields_[i].IsNull() &&
+        fields_[i].GetLength() > column->GetLength()) {
+      column_idx = i;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Row::FitsNullability(const Schema *schema, uint32_t &column_idx) const {
+  for (uint32_t i = 0; i < fields_.size(); i++) {
+    if (fields_[i].IsNull() && !schema->GetColumn(i)->IsNullable()) {
+      column_idx = i;
+      return false;
+    }
+  }
+  return true;
+}
+
+void Row::SetField(uint32_t idx, const Field &field) {
+  ASSERT(idx < fields_.size(), "Failed to access field");
+  fields_[idx] = CopyField(field);
+}
+
+Field Row::CopyField(const Field &field) const {
+  if (field.GetTypeId() != TypeId::kTypeChar || field.IsNull()) {
+    return Field(field);
+  }
+  // the source may only point to its bytes, copy them in any case
+  uint32_t len = field.GetLength();
+  char *data = const_cast<char *>(field.GetData());
+  bool in_arena = arena_ != nullptr && len > FIELD_INLINE_LEN;
+  Field copy(TypeId::kTypeChar, in_arena ? arena_->CopyBytes(data, len) : data, len, !in_arena);
+  copy.SetOverflow(field.IsOverflow());
+  return copy;
 }
@@ -0,0 +1,108 @@
+#include "record/row_format.h"
+
+#include <cstring>
+
+#include "record/field_kernels.h"
+#include "record/row.h"
+
+namespace {
+
+/**
+ * Write a non-null fixed size field with the kernel of its column type, rather than through the virtual Type calls.
+ */
+inline void SerializeFixed(const Field &field, TypeId type, char *buf) {
+  if (type == TypeId::kTypeInt) {
+    FieldKernel<TypeId::kTypeInt>::SerializeTo(field, buf);
+  } else {
+    FieldKernel<TypeId::kTypeFloat>::SerializeTo(field, buf);
+  }
+}
+
+inline void DeserializeFixed(const char *buf, TypeId type, Field &field) {
+  if (type == TypeId::kTypeInt) {
+    FieldKernel<TypeId::kTypeInt>::DeserializeFrom(buf, field);
+  } else {
+    FieldKernel<TypeId::kTypeFloat>::DeserializeFrom(buf, field);
+  }
+}
+
+}  // namespace
+
+RowFormat::RowFormat(const std::vector<Column *> &columns) {
+  columns_.reserve(columns.size());
+  uint32_t offset = OFFSET_BITMAP + (columns.size() + 7) / 8;
+  uint32_t var_count = 0;
+  for (auto column : columns) {
+    if (column->GetType() == TypeId::kTypeChar && !column->IsDictionary()) {
+      columns_.push_back({column->GetType(), 0, var_count++});
+    } else {
+      // a dictionary encoded char is stored as its code
+      TypeId type = column->IsDictionary() ? TypeId::kTypeInt : column->GetType();
+      columns_.push_back({type, offset, NOT_VARIABLE});
+      offset += Type::GetTypeSize(type);
+    }
+  }
+  var_offsets_offset_ = offset;
+  var_data_offset_ = offset + var_count * sizeof(uint16_t);
+}
+
+uint32_t RowFormat::GetSerializedSize(const Row &row) const {
+  ASSERT(row.GetFieldCount() == columns_.size(), "Fields size do not match schema's column size.");
+  uint32_t size = var_data_offset_;
+  for (uint32_t i = 0; i < columns_.size(); i++) {
+    const Field *field = row.GetField(i);
+    if (IsVariable(i) && !field->IsNull()) {
+      size += field->GetLength();
+    }
+  }
+  return size;
+}
+
+uint32_t RowFormat::SerializeTo(const Row &row, char *buf) const {
+  ASSERT(row.GetFieldCount() == columns_.size(), "Fields size do not match schema's column size.");
+  // the bitmap and the fixed fields are zero filled, only the set bits and non null values are written
+  memset(buf, 0, var_offsets_offset_);
+  buf[0] = static_cast<char>(VERSION);
+  uint32_t end = var_data_offset_;
+  for (uint32_t i = 0; i < columns_.size(); i++) {
+    const Field *field = row.GetField(i);
+    if (field->IsNull()) {
+      buf[OFFSET_BITMAP + i / 8] = static_cast<char>(buf[OFFSET_BITMAP + i / 8] | (1 << (i % 8)));
+    }
+    if (!IsVariable(i)) {
+      ASSERT(field->IsNull() || field->GetTypeId() == columns_[i].type_, "Dictionary encoded field holds a value.");
+      if (!field->IsNull()) {
+        SerializeFixed(*field, columns_[i].type_, buf + columns_[i].offset_);
+      }
+      continue;
+    }
+    if (!field->IsNull()) {
+      memcpy(buf + end, field->GetData(), field->GetLength());
+      end += field->GetLength();
+    }
+    uint16_t end_offset = static_cast<uint16_t>(field->IsOverflow() ? end | OVERFLOW_BIT : end);
+    MACH_WRITE_TO(uint16_t, buf + var_offsets_offset_ + columns_[i].var_index_ * sizeof(uint16_t), end_offset);
+  }
+  return end;
+}
+
+uint32_t RowFormat::DeserializeFrom(const char *buf, Row *row) const {
+  ASSERT(static_cast<uint8_t>(buf[0]) == VERSION, "Unknown tuple format version.");
+  ASSERT(row->GetFields().empty(), "Non empty field in row.");
+  uint32_t end = var_data_offset_;
+  for (uint32_t i = 0; i < columns_.size(); i++) {
+    if (IsNull(buf, i)) {
+      row->AppendField(Field(columns_[i].type_));
+    } else if (!IsVariable(i)) {
+      DeserializeFixed(buf + columns_[i].offset_, columns_[i].type_, row->GetFields().emplace_back(columns_[i].type_));
+    } else {
+      Field field(TypeId::kTypeChar, const_cast<char *>(GetData(buf, i)), GetVarLength(buf, i), false);
+      field.SetOverflow(IsOverflow(buf, i));
+      row->AppendField(field);
+    }
+    if (IsVariable(i)) {
+      end = ReadEndOffset(buf, columns_[i].var_index_) & ~OVERFLOW_BIT;
+    }
+  }
+  return end;
+}
@@ -0,0 +1,101 @@
+#include "record/row_view.h"
+
+#include <algorithm>
+
+#include "page/table_page.h"
+#include "storage/dictionary.h"
+#include "storage/overflow_store.h"
+
+void RowView::Reset(const char *data, RowId rid) {
+  pax_layout_.reset();
+  data_ = data;
+  rid_ = rid;
+}
+
+void RowView::Reset(TablePage *page, uint32_t slot_num, RowId rid) {
+  if (!page->IsPax()) {
+    Reset(page->GetTupleData(slot_num), rid == INVALID_ROWID ? RowId(page->GetTablePageId(), slot_num) : rid);
+    return;
+  }
+  // the layout only depends on the schema and the capacity, which every page of a table shares
+  if (pax_layout_ == nullptr || pax_layout_->GetCapacity() != page->GetPaxCapacity()) {
+    pax_layout_ = std::make_unique<PaxLayout>(page->GetPaxLayout(schema_));
+    pax_offsets_.resize(schema_->GetColumnCount());
+  }
+  data_ = page->GetData();
+  rid_.Set(page->GetTablePageId(), slot_num);
+  for (uint32_t i = 0; i < pax_offsets_.size(); i++) {
+    pax_offsets_[i] = pax_layout_->GetValueOffset(i, slot_num);
+  }
+}
+
+Field RowView::GetField(uint32_t idx, bool manage_data) const {
+  TypeId type = schema_->GetColumn(idx)->GetType();
+  if (IsNull(idx)) {
+    return Field(type);
+  }
+  switch (type) {
+    case TypeId::kTypeInt:
+      return Field(type, GetInt(idx));
+    case TypeId::kTypeFloat:
+      return Field(type, GetFloat(idx));
+    default:
+      if (IsOverflow(idx)) {
+        ASSERT(overflow_store_ != nullptr, "No overflow store to load the value from.");
+        return overflow_store_->Load(GetChars(idx));
+      }
+      if (IsEncoded(idx)) {
+        const std::string &value = GetDecoded(idx);
+        return Field(type, const_cast<char *>(value.data()), value.size(), manage_data);
+      }
+      return Field(type, const_cast<char *>(GetChars(idx)), GetCharLength(idx), manage_data);
+  }
+}
+
+void RowView::Materialize(Row *row) const {
+  row->destroy();
+  row->SetRowId(rid_);
+  if (pax_layout_ != nullptr) {
+    for (uint32_t i = 0; i < pax_offsets_.size(); i++) {
+      row->AppendField(GetField(i, false));
+    }
+    return;
+  }
+  format_->DeserializeFrom(data_, row);
+  if (overflow_store_ != nullptr) {
+    overflow_store_->Resolve(row);
+  }
+  if (dictionary_ != nullptr) {
+    dictionary_->Decode(row);
+  }
+}
+
+void RowView::Materialize(const Schema *output_schema, Row *row) const {
+  // the values are copied once, straight from the page to the row
+  row->destroy();
+  row->SetRowId(rid_);
+  for (const auto column : output_schema->GetColumns()) {
+    row->AppendField(GetField(column->GetTableInd()));
+  }
+}
+
+CmpBool RowView::CompareEncoded(uint32_t idx, const Field &value) const {
+  if (IsNull(idx) || value.IsNull()) {
+    return CmpBool::kNull;
+  }
+  uint32_t value_count = dictionary_->GetValueCount(idx);
+  auto it = std::find_if(code_lookups_.begin(), code_lookups_.end(), [&](const CodeLookup &lookup) {
+    return lookup.idx_ == idx && lookup.value_ == &value;
+  });
+  if (it == code_lookups_.end()) {
+    code_lookups_.push_back({idx, &value, Dictionary::NOT_FOUND, 0});
+    it = code_lookups_.end() - 1;
+  }
+  if (it->code_ == Dictionary::NOT_FOUND && it->value_count_ != value_count) {
+    it->code_ = dictionary_->Lookup(idx, value.GetData(), value.GetLength());
+    it->value_count_ = value_count;
+  }
+  return GetCmpBool(it->code_ == GetCode(idx));
+}
+
+const std::string &RowView::GetDecoded(uint32_t idx) const { return dictionary_->GetValue(idx, GetCode(idx)); }
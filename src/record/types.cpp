@@ -1,5 +1,6 @@
 #include "record/types.h"
 
+#include "common/arena.h"
 #include "common/macros.h"
 #include "record/field.h"
 
@@ -24,7 +25,7 @@ uint32_t Type::SerializeTo(const Field &field, char *buf) const {
   return 0;
 }
 
-uint32_t Type::DeserializeFrom(char *storage, Field **field, bool is_null) const {
+uint32_t Type::DeserializeFrom(char *storage, Field &field, bool is_null, Arena *) const {
   ASSERT(false, "DeserializeFrom not implemented.");
   return 0;
 }
@@ -84,13 +85,13 @@ uint32_t TypeInt::SerializeTo(const Field &field, char *buf) const {
   return 0;
 }
 
-uint32_t TypeInt::DeserializeFrom(char *storage, Field **field, bool is_null) const {
+uint32_t TypeInt::DeserializeFrom(char *storage, Field &field, bool is_null, Arena *) const {
   if (is_null) {
-    *field = new Field(TypeId::kTypeInt);
+    field = Field(TypeId::kTypeInt);
     return 0;
   }
   int32_t val = MACH_READ_FROM(int32_t, storage);
-  *field = new Field(TypeId::kTypeInt, val);
+  field = Field(TypeId::kTypeInt, val);
   return GetTypeSize(type_id_);
 }
 
@@ -159,13 +160,13 @@ uint32_t TypeFloat::SerializeTo(const Field &field, char *buf) const {
   return 0;
 }
 
-uint32_t TypeFloat::DeserializeFrom(char *storage, Field **field, bool is_null) const {
+uint32_t TypeFloat::DeserializeFrom(char *storage, Field &field, bool is_null, Arena *) const {
   if (is_null) {
-    *field = new Field(TypeId::kTypeFloat);
+    field = Field(TypeId::kTypeFloat);
     return 0;
   }
   float_t val = MACH_READ_FROM(float_t, storage);
-  *field = new Field(TypeId::kTypeFloat, val);
+  field = Field(TypeId::kTypeFloat, val);
   return GetTypeSize(type_id_);
 }
 
@@ -228,20 +229,27 @@ CmpBool TypeFloat::CompareGreaterThanEquals(const Field &left, const Field &righ
 uint32_t TypeChar::SerializeTo(const Field &field, char *buf) const {
   if (!field.IsNull()) {
     uint32_t len = GetLength(field);
-    memcpy(buf, &len, sizeof(uint32_t));
-    memcpy(buf + sizeof(uint32_t), field.value_.chars_, len);
+    uint32_t len_word = field.IsOverflow() ? len | OVERFLOW_FLAG : len;
+    memcpy(buf, &len_word, sizeof(uint32_t));
+    memcpy(buf + sizeof(uint32_t), field.GetChars(), len);
     return len + sizeof(uint32_t);
   }
   return 0;
 }
 
-uint32_t TypeChar::DeserializeFrom(char *storage, Field **field, bool is_null) const {
+uint32_t TypeChar::DeserializeFrom(char *storage, Field &field, bool is_null, Arena *arena) const {
   if (is_null) {
-    *field = new Field(TypeId::kTypeChar);
+    field = Field(TypeId::kTypeChar);
     return 0;
   }
-  uint32_t len = MACH_READ_UINT32(storage);
-  *field = new Field(TypeId::kTypeChar, storage + sizeof(uint32_t), len, true);
+  uint32_t len_word = MACH_READ_UINT32(storage);
+  uint32_t len = len_word & ~OVERFLOW_FLAG;
+  if (arena == nullptr || len <= FIELD_INLINE_LEN) {
+    field = Field(TypeId::kTypeChar, storage + sizeof(uint32_t), len, true);
+  } else {
+    field = Field(TypeId::kTypeChar, arena->CopyBytes(storage + sizeof(uint32_t), len), len, false);
+  }
+  field.is_overflow_ = (len_word & OVERFLOW_FLAG) != 0;
   return len + sizeof(uint32_t);
 }
 
@@ -254,7 +262,7 @@ uint32_t TypeChar::GetSerializedSize(const Field &field, bool is_null) const {
 }
 
 const char *TypeChar::GetData(const Field &val) const {
-  return val.value_.chars_;
+  return val.GetChars();
 }
 
 uint32_t TypeChar::GetLength(const Field &val) const {
@@ -0,0 +1,153 @@
+#include "storage/dictionary.h"
+
+Dictionary::Dictionary(BufferPoolManager *buffer_pool_manager, const Schema *schema)
+    : buffer_pool_manager_(buffer_pool_manager), columns_(schema->GetColumnCount()) {
+  for (uint32_t i = 0; i < schema->GetColumnCount(); i++) {
+    columns_[i].is_encoded_ = schema->GetColumn(i)->IsDictionary();
+  }
+}
+
+bool Dictionary::HasEncodedColumns(const Schema *schema) {
+  for (auto column : schema->GetColumns()) {
+    if (column->IsDictionary()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool Dictionary::CanEncode(const Column *column) {
+  return column->GetType() == TypeId::kTypeChar && column->GetLength() <= OVERFLOW_THRESHOLD;
+}
+
+bool Dictionary::Create() {
+  auto page = buffer_pool_manager_->NewPage(first_page_id_);
+  if (page == nullptr) {
+    return false;
+  }
+  reinterpret_cast<DictionaryPage *>(page->GetData())->Init(first_page_id_);
+  buffer_pool_manager_->UnpinPage(first_page_id_, true);
+  last_page_id_ = first_page_id_;
+  return true;
+}
+
+void Dictionary::Load(page_id_t first_page_id) {
+  first_page_id_ = first_page_id;
+  for (page_id_t page_id = first_page_id; page_id != INVALID_PAGE_ID;) {
+    auto page = reinterpret_cast<DictionaryPage *>(buffer_pool_manager_->FetchPage(page_id)->GetData());
+    uint32_t column;
+    const char *data;
+    uint32_t len;
+    for (uint32_t offset = 0; offset < page->GetSize();) {
+      offset = page->GetEntry(offset, column, data, len);
+      AddValue(column, data, len);
+    }
+    last_page_id_ = page_id;
+    page_id_t next_page_id = page->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    page_id = next_page_id;
+  }
+}
+
+void Dictionary::Free() {
+  for (page_id_t page_id = first_page_id_; page_id != INVALID_PAGE_ID;) {
+    auto page = reinterpret_cast<DictionaryPage *>(buffer_pool_manager_->FetchPage(page_id)->GetData());
+    page_id_t next_page_id = page->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    buffer_pool_manager_->DeletePage(page_id);
+    page_id = next_page_id;
+  }
+  first_page_id_ = last_page_id_ = INVALID_PAGE_ID;
+  for (auto &column : columns_) {
+    column.codes_.clear();
+    column.values_.clear();
+  }
+}
+
+bool Dictionary::NeedsEncoding(const Row &row) const {
+  for (uint32_t i = 0; i < columns_.size(); i++) {
+    const Field *field = row.GetField(i);
+    if (columns_[i].is_encoded_ && field->GetTypeId() == TypeId::kTypeChar && !field->IsNull()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool Dictionary::Encode(const Row &row, Row *encoded) {
+  std::vector<Field> fields;
+  fields.reserve(columns_.size());
+  for (uint32_t i = 0; i < columns_.size(); i++) {
+    const Field *field = row.GetField(i);
+    if (!columns_[i].is_encoded_ || field->GetTypeId() != TypeId::kTypeChar || field->IsNull()) {
+      fields.emplace_back(*field);
+      continue;
+    }
+    uint32_t code = GetOrAssign(i, field->GetData(), field->GetLength());
+    if (code == NOT_FOUND) {
+      return false;
+    }
+    fields.emplace_back(TypeId::kTypeInt, static_cast<int32_t>(code));
+  }
+  *encoded = Row(fields);
+  encoded->SetRowId(row.GetRowId());
+  return true;
+}
+
+void Dictionary::Decode(Row *row) const {
+  for (uint32_t i = 0; i < columns_.size(); i++) {
+    if (!columns_[i].is_encoded_ || row->GetField(i)->GetTypeId() != TypeId::kTypeInt) {
+      continue;
+    }
+    if (row->GetField(i)->IsNull()) {
+      row->SetField(i, Field(TypeId::kTypeChar));
+    } else {
+      uint32_t code;
+      row->GetField(i)->SerializeTo(reinterpret_cast<char *>(&code));
+      const std::string &str = GetValue(i, code);
+      row->SetField(i, Field(TypeId::kTypeChar, const_cast<char *>(str.data()), str.size(), false));
+    }
+  }
+}
+
+uint32_t Dictionary::Lookup(uint32_t column, const char *data, uint32_t len) const {
+  const auto &codes = columns_[column].codes_;
+  auto it = codes.find(std::string_view(data, len));
+  return it == codes.end() ? NOT_FOUND : it->second;
+}
+
+uint32_t Dictionary::GetOrAssign(uint32_t column, const char *data, uint32_t len) {
+  uint32_t code = Lookup(column, data, len);
+  if (code != NOT_FOUND) {
+    return code;
+  }
+  auto page = reinterpret_cast<DictionaryPage *>(buffer_pool_manager_->FetchPage(last_page_id_)->GetData());
+  bool appended = page->Append(column, data, len);
+  if (!appended) {
+    // chain a new page
+    page_id_t new_page_id;
+    auto raw_page = buffer_pool_manager_->NewPage(new_page_id);
+    if (raw_page == nullptr) {
+      buffer_pool_manager_->UnpinPage(last_page_id_, false);
+      return NOT_FOUND;
+    }
+    auto new_page = reinterpret_cast<DictionaryPage *>(raw_page->GetData());
+    new_page->Init(new_page_id);
+    appended = new_page->Append(column, data, len);
+    ASSERT(appended, "A value must fit in an empty dictionary page.");
+    page->SetNextPageId(new_page_id);
+    buffer_pool_manager_->UnpinPage(new_page_id, true);
+    buffer_pool_manager_->UnpinPage(last_page_id_, true);
+    last_page_id_ = new_page_id;
+  } else {
+    buffer_pool_manager_->UnpinPage(last_page_id_, true);
+  }
+  AddValue(column, data, len);
+  return GetValueCount(column) - 1;
+}
+
+void Dictionary::AddValue(uint32_t column, const char *data, uint32_t len) {
+  auto &dictionary = columns_[column];
+  dictionary.values_.emplace_back(data, len);
+  dictionary.codes_.emplace(dictionary.values_.back(), static_cast<uint32_t>(dictionary.values_.size() - 1));
+}
@@ -0,0 +1,122 @@
+#include "storage/overflow_store.h"
+
+#include <algorithm>
+#include <memory>
+
+bool OverflowStore::MayOverflow(const Schema *schema) {
+  for (auto column : schema->GetColumns()) {
+    if (column->GetType() == TypeId::kTypeChar && column->GetLength() > OVERFLOW_THRESHOLD) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool OverflowStore::NeedsOverflow(Row &row) {
+  for (const auto &field : row.GetFields()) {
+    if (NeedsOverflow(field)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool OverflowStore::Store(Row &row, Row *stored) {
+  std::vector<Field> fields;
+  fields.reserve(row.GetFieldCount());
+  for (const auto &field : row.GetFields()) {
+    if (!NeedsOverflow(field)) {
+      fields.emplace_back(field);
+      continue;
+    }
+    char ref[SIZE_REF];
+    uint32_t len = field.GetLength();
+    page_id_t first_page_id = WriteChain(field.GetData(), len);
+    if (first_page_id == INVALID_PAGE_ID) {
+      Row partial(fields);
+      Free(partial);
+      return false;
+    }
+    MACH_WRITE_UINT32(ref, len);
+    MACH_WRITE_TO(page_id_t, ref + sizeof(uint32_t), first_page_id);
+    fields.emplace_back(TypeId::kTypeChar, ref, SIZE_REF, true);
+    fields.back().SetOverflow(true);
+  }
+  *stored = Row(fields);
+  stored->SetRowId(row.GetRowId());
+  return true;
+}
+
+void OverflowStore::Resolve(Row *row) const {
+  for (uint32_t i = 0; i < row->GetFieldCount(); i++) {
+    if (row->GetField(i)->IsOverflow()) {
+      row->SetField(i, Load(row->GetField(i)->GetData()));
+    }
+  }
+}
+
+Field OverflowStore::Load(const char *ref) const {
+  uint32_t len = MACH_READ_UINT32(ref);
+  page_id_t page_id = MACH_READ_FROM(page_id_t, ref + sizeof(uint32_t));
+  std::unique_ptr<char[]> value(new char[len]);
+  for (uint32_t offset = 0; offset < len && page_id != INVALID_PAGE_ID;) {
+    auto page = reinterpret_cast<OverflowPage *>(buffer_pool_manager_->FetchPage(page_id)->GetData());
+    memcpy(value.get() + offset, page->GetBytes(), page->GetSize());
+    offset += page->GetSize();
+    page_id_t next_page_id = page->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    page_id = next_page_id;
+  }
+  return Field(TypeId::kTypeChar, value.get(), len, true);
+}
+
+void OverflowStore::Free(Row &row) {
+  for (const auto &field : row.GetFields()) {
+    if (field.IsOverflow()) {
+      FreeChain(MACH_READ_FROM(page_id_t, field.GetData() + sizeof(uint32_t)));
+    }
+  }
+}
+
+page_id_t OverflowStore::WriteChain(const char *data, uint32_t len) {
+  page_id_t first_page_id = INVALID_PAGE_ID;
+  OverflowPage *prev_page = nullptr;
+  for (uint32_t offset = 0; offset < len;) {
+    page_id_t page_id;
+    auto page = buffer_pool_manager_->NewPage(page_id);
+    if (page == nullptr) {
+      if (prev_page != nullptr) {
+        buffer_pool_manager_->UnpinPage(prev_page->GetPageId(), true);
+      }
+      FreeChain(first_page_id);
+      return INVALID_PAGE_ID;
+    }
+    auto overflow_page = reinterpret_cast<OverflowPage *>(page->GetData());
+    overflow_page->Init(page_id);
+    uint32_t size = std::min(len - offset, OverflowPage::CAPACITY);
+    memcpy(overflow_page->GetBytes(), data + offset, size);
+    overflow_page->SetSize(size);
+    offset += size;
+    if (prev_page == nullptr) {
+      first_page_id = page_id;
+    } else {
+      prev_page->SetNextPageId(page_id);
+      buffer_pool_manager_->UnpinPage(prev_page->GetPageId(), true);
+    }
+    prev_page = overflow_page;
+  }
+  if (prev_page != nullptr) {
+    buffer_pool_manager_->UnpinPage(prev_page->GetPageId(), true);
+  }
+  return first_page_id;
+}
+
+void OverflowStore::FreeChain(page_id_t page_id) {
+  while (page_id != INVALID_PAGE_ID) {
+    auto page = reinterpret_cast<OverflowPage *>(buffer_pool_manager_->FetchPage(page_id)->GetData());
+    page_id_t next_page_id = page->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    buffer_pool_manager_->DeletePage(page_id);
+    page_id = next_page_id;
+  }
+}
@@ -1,44 +1,446 @@
 #include "storage/table_heap.h"
 
-/**
- * TODO: Student Implement
- */
+#include <algorithm>
+#include <memory>
+
+TableHeap::TableHeap(BufferPoolManager *buffer_pool_manager, Schema *schema, Txn *txn, LogManager *log_manager,
+                     LockManager *lock_manager, TableLayout layout)
+    : buffer_pool_manager_(buffer_pool_manager),
+      schema_(schema),
+      log_manager_(log_manager),
+      lock_manager_(lock_manager),
+      overflow_store_(buffer_pool_manager),
+      has_overflow_(OverflowStore::MayOverflow(schema)),
+      dictionary_(buffer_pool_manager, schema),
+      has_dictionary_(Dictionary::HasEncodedColumns(schema)),
+      zone_map_(buffer_pool_manager, schema),
+      pax_capacity_(layout == TableLayout::kPax ? TablePage::GetMaxPaxCapacity(schema) : 0) {
+  ASSERT(SupportsLayout(schema, layout), "Schema cannot be stored in the PAX layout.");
+  if (has_dictionary_) {
+    bool __attribute__((unused)) created = dictionary_.Create();
+    ASSERT(created, "Failed to allocate the dictionary.");
+  }
+  bool __attribute__((unused)) zoned = zone_map_.Create();
+  ASSERT(zoned, "Failed to allocate the zone map.");
+  // initialize to make sure there must have first page
+  auto first_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->NewPage(first_page_id_));
+  first_page->Init(first_page_id_, INVALID_PAGE_ID, log_manager, txn, pax_capacity_);
+  uint32_t free_space = first_page->GetMaxInsertSize();
+  buffer_pool_manager_->UnpinPage(first_page_id_, true);
+  last_page_id_ = first_page_id_;
+  number_of_pages = 1;
+  bool __attribute__((unused)) recorded = AppendPageEntry(first_page_id_, free_space, 0);
+  ASSERT(recorded, "Failed to allocate the free space map.");
+}
+
+TableHeap::TableHeap(BufferPoolManager *buffer_pool_manager, page_id_t first_page_id, page_id_t fsm_page_id,
+                     Schema *schema, LogManager *log_manager, LockManager *lock_manager, page_id_t dictionary_page_id,
+                     page_id_t zone_map_page_id)
+    : buffer_pool_manager_(buffer_pool_manager),
+      first_page_id_(first_page_id),
+      fsm_page_id_(fsm_page_id),
+      schema_(schema),
+      log_manager_(log_manager),
+      lock_manager_(lock_manager),
+      overflow_store_(buffer_pool_manager),
+      has_overflow_(OverflowStore::MayOverflow(schema)),
+      dictionary_(buffer_pool_manager, schema),
+      has_dictionary_(Dictionary::HasEncodedColumns(schema)),
+      zone_map_(buffer_pool_manager, schema) {
+  dictionary_.Load(dictionary_page_id);
+  auto first_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(first_page_id_));
+  pax_capacity_ = first_page->GetPaxCapacity();
+  buffer_pool_manager_->UnpinPage(first_page_id_, false);
+  bool __attribute__((unused)) loaded = LoadFreeSpaceMap();
+  ASSERT(loaded, "Failed to read the free space map.");
+  if (zone_map_page_id != INVALID_PAGE_ID) {
+    zone_map_.Load(zone_map_page_id);
+  } else if (zone_map_.IsEnabled() && zone_map_.Create()) {
+    RebuildZoneMap(nullptr);
+  }
+}
+
 bool TableHeap::InsertTuple(Row &row, Txn *txn) {
-  page_id_t current_page_id=first_page_id_;
-  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(current_page_id));
+  // no page takes a char longer than its column, a PAX page would still report room for it
+  uint32_t column_idx;
+  if (!row.FitsSchema(schema_, column_idx)) {
+    return false;
+  }
+  if (has_dictionary_ && dictionary_.NeedsEncoding(row)) {
+    Row encoded;
+    if (!dictionary_.Encode(row, &encoded)) {
+      return false;
+    }
+    bool inserted = InsertTuple(encoded, txn);
+    if (inserted) {
+      row.SetRowId(encoded.GetRowId());
+    }
+    return inserted;
+  }
+  if (has_overflow_ && OverflowStore::NeedsOverflow(row)) {
+    Row stored;
+    if (!overflow_store_.Store(row, &stored)) {
+      return false;
+    }
+    bool inserted = InsertTuple(stored, txn);
+    if (inserted) {
+      row.SetRowId(stored.GetRowId());
+    } else {
+      overflow_store_.Free(stored);
+    }
+    return inserted;
+  }
+  uint32_t tuple_size = schema_->GetRowFormat().GetSerializedSize(row);
+  if (tuple_size > TablePage::SIZE_MAX_ROW) {
+    return false;
+  }
+  // Fast path: append to the last page.
+  if (InsertIntoPage(last_page_id_, row, txn)) {
+    return true;
+  }
+  // Reuse space recorded in the free space map, a page refusing the tuple although its entry still reports room
+  // for it is not tried again.
+  page_id_t page_id;
+  page_id_t failed_page_id = INVALID_PAGE_ID;
+  while ((page_id = FindPageWithSpace(tuple_size)) != INVALID_PAGE_ID && page_id != failed_page_id) {
+    if (InsertIntoPage(page_id, row, txn)) {
+      return true;
+    }
+    failed_page_id = page_id;
+  }
+  // Grow the heap.
+  page_id = AppendNewPage(txn);
+  return page_id != INVALID_PAGE_ID && InsertIntoPage(page_id, row, txn);
+}
+
+bool TableHeap::InsertIntoPage(page_id_t page_id, Row &row, Txn *txn, bool relocated) {
+  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
   if (page == nullptr) {
     return false;
   }
-  if(page->InsertTuple(row,schema_,txn,lock_manager_,log_manager_)){
-    return  true;
-  }else{
-    page_id_t last_page_id=current_page_id;
-    while (1)
-    {
-      current_page_id=page->GetNextPageId();
-      if(current_page_id<=0){
-        auto new_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->NewPage(current_page_id));
-        new_page->Init(current_page_id,last_page_id,log_manager_,txn);
-        if(new_page->InsertTuple(row,schema_,txn,lock_manager_,log_manager_)){
-          return  true;
-        }else{
-          last_page_id=current_page_id;
-          continue;
-        }
-      }else{
-        auto new_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(current_page_id));
-        if(new_page==nullptr){
-          return false;
-        }
-        if(new_page->InsertTuple(row,schema_,txn,lock_manager_,log_manager_)){
-          return  true;
-        }else{
-          last_page_id=current_page_id;
-          continue;
-        }
+  page->WLatch();
+  bool inserted = relocated ? page->InsertRelocatedTuple(row, schema_)
+                            : page->InsertTuple(row, schema_, txn, lock_manager_, log_manager_);
+  uint32_t free_space = page->GetMaxInsertSize();
+  uint32_t tuple_count = page->GetLiveTupleCount();
+  page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(page_id, inserted);
+  // a failed insert still corrects a stale entry
+  UpdatePageEntry(page_id, free_space, tuple_count);
+  // a relocated tuple is scanned from the page of its stub, whose zone covers it
+  if (inserted && !relocated) {
+    WidenZone(page_id, row);
+  }
+  return inserted;
+}
+
+std::vector<RowId> TableHeap::InsertTuples(std::vector<Row> &rows, Txn *txn) {
+  if (!has_dictionary_) {
+    return InsertEncodedTuples(rows, txn);
+  }
+  // the caller keeps its rows, the batch is stored from encoded copies
+  std::vector<Row> encoded(rows.size());
+  size_t count = 0;
+  while (count < rows.size() && dictionary_.Encode(rows[count], &encoded[count])) {
+    count++;
+  }
+  encoded.resize(count);
+  std::vector<RowId> rids = InsertEncodedTuples(encoded, txn);
+  rids.resize(rows.size(), INVALID_ROWID);
+  for (size_t i = 0; i < count; i++) {
+    if (rids[i].GetPageId() != INVALID_PAGE_ID) {
+      rows[i].SetRowId(rids[i]);
+    }
+  }
+  return rids;
+}
+
+std::vector<RowId> TableHeap::InsertEncodedTuples(std::vector<Row> &rows, Txn *txn) {
+  std::vector<RowId> rids(rows.size(), INVALID_ROWID);
+  std::vector<uint32_t> sizes;
+  sizes.reserve(rows.size());
+  for (size_t i = 0; i < rows.size(); i++) {
+    // rows with values going out of line take the single-row path, a size of 0 marks them done
+    if (has_overflow_ && OverflowStore::NeedsOverflow(rows[i])) {
+      rids[i] = InsertTuple(rows[i], txn) ? rows[i].GetRowId() : INVALID_ROWID;
+      sizes.push_back(0);
+    } else {
+      sizes.push_back(schema_->GetRowFormat().GetSerializedSize(rows[i]));
+    }
+  }
+  page_id_t page_id = last_page_id_;
+  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+  if (page == nullptr) {
+    return rids;
+  }
+  page->WLatch();
+  bool is_dirty = false;
+  // the zone of the page is written back once the page is left
+  bool zone_changed = false;
+  size_t next = 0;
+  while (next < rows.size()) {
+    if (sizes[next] == 0 || sizes[next] > TablePage::SIZE_MAX_ROW) {
+      next++;
+      continue;
+    }
+    if (page->InsertTuple(rows[next], sizes[next], schema_, txn, lock_manager_, log_manager_)) {
+      rids[next] = rows[next].GetRowId();
+      is_dirty = true;
+      zone_changed |= zone_map_.Extend(fsm_entries_.at(page_id), rows[next]);
+      next++;
+      continue;
+    }
+    // the page is full, move on to a hole recorded in the free space map or grow the heap
+    UpdatePageEntry(page_id, page->GetMaxInsertSize(), page->GetLiveTupleCount());
+    if (zone_changed) {
+      zone_map_.Write(fsm_entries_.at(page_id));
+      zone_changed = false;
+    }
+    page_id_t hole_page_id = FindPageWithSpace(sizes[next]);
+    TablePage *next_page;
+    bool chained = false;
+    if (hole_page_id != INVALID_PAGE_ID) {
+      next_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(hole_page_id));
+    } else if (page_id == last_page_id_) {
+      // chain the fresh page while still holding the full one
+      next_page = AllocatePageAfter(page, txn);
+      chained = next_page != nullptr;
+    } else {
+      next_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(last_page_id_));
+    }
+    page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(page_id, is_dirty || chained);
+    if (next_page == nullptr) {
+      return rids;
+    }
+    page = next_page;
+    page_id = next_page->GetTablePageId();
+    page->WLatch();
+    is_dirty = chained;
+  }
+  uint32_t free_space = page->GetMaxInsertSize();
+  uint32_t tuple_count = page->GetLiveTupleCount();
+  page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(page_id, is_dirty);
+  UpdatePageEntry(page_id, free_space, tuple_count);
+  if (zone_changed) {
+    zone_map_.Write(fsm_entries_.at(page_id));
+  }
+  return rids;
+}
+
+page_id_t TableHeap::AppendNewPage(Txn *txn) {
+  page_id_t last_page_id = last_page_id_;
+  auto last_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(last_page_id));
+  if (last_page == nullptr) {
+    return INVALID_PAGE_ID;
+  }
+  last_page->WLatch();
+  auto new_page = AllocatePageAfter(last_page, txn);
+  last_page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(last_page_id, new_page != nullptr);
+  if (new_page == nullptr) {
+    return INVALID_PAGE_ID;
+  }
+  page_id_t new_page_id = new_page->GetTablePageId();
+  buffer_pool_manager_->UnpinPage(new_page_id, true);
+  return new_page_id;
+}
+
+TablePage *TableHeap::AllocatePageAfter(TablePage *last_page, Txn *txn) {
+  page_id_t new_page_id;
+  auto new_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->NewPage(new_page_id));
+  if (new_page == nullptr) {
+    return nullptr;
+  }
+  new_page->Init(new_page_id, last_page->GetTablePageId(), log_manager_, txn, pax_capacity_);
+  // a page missing from the map would be skipped by the scans, so it is only linked once recorded
+  if (!AppendPageEntry(new_page_id, new_page->GetMaxInsertSize(), 0)) {
+    buffer_pool_manager_->UnpinPage(new_page_id, false);
+    buffer_pool_manager_->DeletePage(new_page_id);
+    return nullptr;
+  }
+  last_page->SetNextPageId(new_page_id);
+  last_page_id_ = new_page_id;
+  number_of_pages++;
+  return new_page;
+}
+
+page_id_t TableHeap::FindPageWithSpace(uint32_t tuple_size) {
+  for (auto fsm_page_id : fsm_page_ids_) {
+    auto page = buffer_pool_manager_->FetchPage(fsm_page_id);
+    if (page == nullptr) {
+      continue;
+    }
+    auto fsm_page = reinterpret_cast<FreeSpaceMapPage *>(page->GetData());
+    int index = fsm_page->FindFreeEntry(tuple_size);
+    // the last page has been tried by the caller
+    if (index != -1 && fsm_page->GetHeapPageId(index) == last_page_id_) {
+      index = fsm_page->FindFreeEntry(tuple_size, index + 1);
+    }
+    page_id_t page_id = index == -1 ? INVALID_PAGE_ID : fsm_page->GetHeapPageId(index);
+    buffer_pool_manager_->UnpinPage(fsm_page_id, false);
+    if (page_id != INVALID_PAGE_ID) {
+      return page_id;
+    }
+  }
+  return INVALID_PAGE_ID;
+}
+
+bool TableHeap::LoadFreeSpaceMap() {
+  fsm_page_ids_.clear();
+  fsm_entries_.clear();
+  page_ids_.clear();
+  number_of_pages = 0;
+  page_id_t fsm_page_id = fsm_page_id_;
+  while (fsm_page_id != INVALID_PAGE_ID) {
+    auto page = buffer_pool_manager_->FetchPage(fsm_page_id);
+    if (page == nullptr) {
+      return false;
+    }
+    auto fsm_page = reinterpret_cast<FreeSpaceMapPage *>(page->GetData());
+    fsm_page_ids_.push_back(fsm_page_id);
+    for (uint32_t i = 0; i < fsm_page->GetEntryCount(); i++) {
+      last_page_id_ = fsm_page->GetHeapPageId(i);
+      fsm_entries_[last_page_id_] = number_of_pages++;
+      page_ids_.push_back(last_page_id_);
+    }
+    page_id_t next_page_id = fsm_page->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(fsm_page_id, false);
+    fsm_page_id = next_page_id;
+  }
+  return true;
+}
+
+bool TableHeap::AppendPageEntry(page_id_t page_id, uint32_t free_space, uint32_t tuple_count) {
+  uint32_t entry = fsm_entries_.size();
+  page_id_t fsm_page_id;
+  Page *page;
+  if (entry == fsm_page_ids_.size() * FreeSpaceMapPage::MAX_ENTRY_COUNT) {
+    // chain a new map page
+    page = buffer_pool_manager_->NewPage(fsm_page_id);
+    if (page == nullptr) {
+      return false;
+    }
+    reinterpret_cast<FreeSpaceMapPage *>(page->GetData())->Init(fsm_page_id);
+    if (fsm_page_ids_.empty()) {
+      fsm_page_id_ = fsm_page_id;
+    } else {
+      auto tail_page = buffer_pool_manager_->FetchPage(fsm_page_ids_.back());
+      if (tail_page == nullptr) {
+        buffer_pool_manager_->UnpinPage(fsm_page_id, false);
+        buffer_pool_manager_->DeletePage(fsm_page_id);
+        return false;
       }
+      reinterpret_cast<FreeSpaceMapPage *>(tail_page->GetData())->SetNextPageId(fsm_page_id);
+      buffer_pool_manager_->UnpinPage(fsm_page_ids_.back(), true);
+    }
+    fsm_page_ids_.push_back(fsm_page_id);
+  } else {
+    fsm_page_id = fsm_page_ids_.back();
+    page = buffer_pool_manager_->FetchPage(fsm_page_id);
+    if (page == nullptr) {
+      return false;
+    }
+  }
+  reinterpret_cast<FreeSpaceMapPage *>(page->GetData())->Append(page_id, free_space, tuple_count);
+  buffer_pool_manager_->UnpinPage(fsm_page_id, true);
+  fsm_entries_[page_id] = entry;
+  page_ids_.push_back(page_id);
+  zone_map_.Append();
+  return true;
+}
+
+void TableHeap::UpdatePageEntry(page_id_t page_id, uint32_t free_space, uint32_t tuple_count) {
+  auto it = fsm_entries_.find(page_id);
+  if (it == fsm_entries_.end()) {
+    return;
+  }
+  page_id_t fsm_page_id = fsm_page_ids_[it->second / FreeSpaceMapPage::MAX_ENTRY_COUNT];
+  auto page = buffer_pool_manager_->FetchPage(fsm_page_id);
+  // the entry stays stale, an insert into its page corrects it
+  if (page == nullptr) {
+    return;
+  }
+  auto fsm_page = reinterpret_cast<FreeSpaceMapPage *>(page->GetData());
+  bool is_dirty = fsm_page->Update(it->second % FreeSpaceMapPage::MAX_ENTRY_COUNT, free_space, tuple_count);
+  buffer_pool_manager_->UnpinPage(fsm_page_id, is_dirty);
+}
+
+void TableHeap::RebuildFreeSpaceMap() {
+  struct PageEntry {
+    page_id_t page_id;
+    uint32_t free_space;
+    uint32_t tuple_count;
+  };
+  std::vector<PageEntry> entries;
+  for (page_id_t page_id = first_page_id_; page_id != INVALID_PAGE_ID;) {
+    auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+    ASSERT(page != nullptr, "Failed to fetch a heap page for the free space map.");
+    entries.push_back({page_id, page->GetMaxInsertSize(), page->GetLiveTupleCount()});
+    page_id_t next_page_id = page->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    page_id = next_page_id;
+  }
+  // the heap only shrinks here, so the map never needs more pages than it has
+  size_t fsm_page_count = (entries.size() + FreeSpaceMapPage::MAX_ENTRY_COUNT - 1) / FreeSpaceMapPage::MAX_ENTRY_COUNT;
+  while (fsm_page_ids_.size() > std::max<size_t>(fsm_page_count, 1)) {
+    buffer_pool_manager_->DeletePage(fsm_page_ids_.back());
+    fsm_page_ids_.pop_back();
+  }
+  fsm_entries_.clear();
+  page_ids_.clear();
+  for (size_t i = 0; i < fsm_page_ids_.size(); i++) {
+    auto page = buffer_pool_manager_->FetchPage(fsm_page_ids_[i]);
+    ASSERT(page != nullptr, "Failed to fetch a free space map page.");
+    auto fsm_page = reinterpret_cast<FreeSpaceMapPage *>(page->GetData());
+    fsm_page->Init(fsm_page_ids_[i]);
+    if (i + 1 < fsm_page_ids_.size()) {
+      fsm_page->SetNextPageId(fsm_page_ids_[i + 1]);
+    }
+    size_t end = std::min(entries.size(), (i + 1) * FreeSpaceMapPage::MAX_ENTRY_COUNT);
+    for (size_t j = i * FreeSpaceMapPage::MAX_ENTRY_COUNT; j < end; j++) {
+      fsm_page->Append(entries[j].page_id, entries[j].free_space, entries[j].tuple_count);
+      fsm_entries_[entries[j].page_id] = j;
+      page_ids_.push_back(entries[j].page_id);
+    }
+    buffer_pool_manager_->UnpinPage(fsm_page_ids_[i], true);
+  }
+  number_of_pages = entries.size();
+  last_page_id_ = entries.back().page_id;
+}
+
+void TableHeap::FreeFreeSpaceMap() {
+  for (auto fsm_page_id : fsm_page_ids_) {
+    buffer_pool_manager_->DeletePage(fsm_page_id);
+  }
+  fsm_page_ids_.clear();
+  fsm_entries_.clear();
+  page_ids_.clear();
+  fsm_page_id_ = INVALID_PAGE_ID;
+}
+
+void TableHeap::WidenZone(page_id_t page_id, const Row &row) {
+  auto it = fsm_entries_.find(page_id);
+  if (it != fsm_entries_.end()) {
+    zone_map_.Widen(it->second, row);
+  }
+}
+
+void TableHeap::RebuildZoneMap(Txn *txn) {
+  if (!zone_map_.IsEnabled()) {
+    return;
+  }
+  zone_map_.Reset(number_of_pages);
+  RowBatch batch;
+  for (uint32_t i = 0; i < number_of_pages; i++) {
+    batch.Clear();
+    ScanPage(page_ids_[i], batch, txn);
+    for (size_t j = 0; j < batch.Size(); j++) {
+      zone_map_.Extend(i, batch[j]);
     }
   }
+  zone_map_.Flush();
 }
 
 bool TableHeap::MarkDelete(const RowId &rid, Txn *txn) {
@@ -50,41 +452,223 @@ bool TableHeap::MarkDelete(const RowId &rid, Txn *txn) {
   }
   // Otherwise, mark the tuple as deleted.
   page->WLatch();
-  page->MarkDelete(rid, txn, lock_manager_, log_manager_);
+  bool marked = page->MarkDelete(rid, txn, lock_manager_, log_manager_);
+  uint32_t free_space = page->GetMaxInsertSize();
+  uint32_t tuple_count = page->GetLiveTupleCount();
   page->WUnlatch();
   buffer_pool_manager_->UnpinPage(page->GetTablePageId(), true);
+  if (marked) {
+    dead_tuple_count_++;
+    UpdatePageEntry(rid.GetPageId(), free_space, tuple_count);
+  }
   return true;
 }
 
-/**
- * TODO: Student Implement
- */
 bool TableHeap::UpdateTuple(Row &row, const RowId &rid, Txn *txn) {
+  if (has_dictionary_ && dictionary_.NeedsEncoding(row)) {
+    Row encoded;
+    if (!dictionary_.Encode(row, &encoded)) {
+      return false;
+    }
+    bool updated = UpdateTuple(encoded, rid, txn);
+    if (updated) {
+      row.SetRowId(rid);
+    }
+    return updated;
+  }
+  if (has_overflow_ && OverflowStore::NeedsOverflow(row)) {
+    Row stored;
+    if (!overflow_store_.Store(row, &stored)) {
+      return false;
+    }
+    bool updated = UpdateTuple(stored, rid, txn);
+    if (updated) {
+      row.SetRowId(rid);
+    } else {
+      overflow_store_.Free(stored);
+    }
+    return updated;
+  }
   auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
   if (page == nullptr) {
     return false;
   }
-  Row *old_row;
-  old_row->SetRowId(rid);
-  if(!page->GetTuple(old_row,schema_,txn,lock_manager_)){
-    return  false;
+  page->WLatch();
+  bool visible = page->IsTupleVisible(rid.GetSlotNum());
+  RowId target = visible && page->IsForwarded(rid.GetSlotNum()) ? page->GetForwardRid(rid.GetSlotNum()) : INVALID_ROWID;
+  Row old_row(target.GetPageId() == INVALID_PAGE_ID ? rid : target);
+  bool updated = visible && target.GetPageId() == INVALID_PAGE_ID &&
+                 page->UpdateTuple(row, &old_row, schema_, txn, lock_manager_, log_manager_);
+  uint32_t free_space = page->GetMaxInsertSize();
+  uint32_t tuple_count = page->GetLiveTupleCount();
+  page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(rid.GetPageId(), updated);
+  if (!visible) {
+    return false;
   }
-  if(page->UpdateTuple(row,old_row,schema_,txn,lock_manager_,log_manager_)){
-    return  false;
+  if (updated) {
+    UpdatePageEntry(rid.GetPageId(), free_space, tuple_count);
+  } else if (target.GetPageId() != INVALID_PAGE_ID) {
+    // a relocated tuple is first updated where it is
+    auto tuple_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(target.GetPageId()));
+    if (tuple_page == nullptr) {
+      return false;
+    }
+    tuple_page->WLatch();
+    updated = tuple_page->UpdateTuple(row, &old_row, schema_, txn, lock_manager_, log_manager_);
+    free_space = tuple_page->GetMaxInsertSize();
+    tuple_count = tuple_page->GetLiveTupleCount();
+    tuple_page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(target.GetPageId(), updated);
+    if (updated) {
+      UpdatePageEntry(target.GetPageId(), free_space, tuple_count);
+    }
   }
-  return  true;
+  if (!updated) {
+    updated = RelocateTuple(row, rid, target, &old_row, txn);
+  }
+  if (updated) {
+    row.SetRowId(rid);
+    WidenZone(rid.GetPageId(), row);
+    if (has_overflow_) {
+      overflow_store_.Free(old_row);
+    }
+  }
+  return updated;
+}
+
+bool TableHeap::RelocateTuple(Row &row, const RowId &rid, const RowId &target, Row *old_row, Txn *txn) {
+  if (pax_capacity_ != 0 || schema_->GetRowFormat().GetSerializedSize(row) > TablePage::SIZE_MAX_ROW) {
+    return false;
+  }
+  bool forwarded = target.GetPageId() != INVALID_PAGE_ID;
+  if (forwarded) {
+    auto tuple_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(target.GetPageId()));
+    if (tuple_page == nullptr) {
+      return false;
+    }
+    tuple_page->RLatch();
+    tuple_page->GetTuple(old_row, schema_, txn, lock_manager_);
+    tuple_page->RUnlatch();
+    buffer_pool_manager_->UnpinPage(target.GetPageId(), false);
+  }
+  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
+  if (page == nullptr) {
+    return false;
+  }
+  // a relocated tuple fitting back into its own page replaces its stub
+  page->WLatch();
+  bool moved_back = forwarded && page->ClearForward(rid.GetSlotNum(), row, schema_);
+  uint32_t free_space = page->GetMaxInsertSize();
+  uint32_t tuple_count = page->GetLiveTupleCount();
+  page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(rid.GetPageId(), moved_back);
+  if (moved_back) {
+    UpdatePageEntry(rid.GetPageId(), free_space, tuple_count);
+    DeleteRelocatedTuple(target, false, txn);
+    return true;
+  }
+  // the stub is written once the new tuple is stored, and points at it directly
+  RowId new_target = InsertRelocatedTuple(row, txn);
+  if (new_target.GetPageId() == INVALID_PAGE_ID) {
+    return false;
+  }
+  page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
+  page->WLatch();
+  bool stubbed = page->SetForward(rid.GetSlotNum(), new_target, old_row, schema_);
+  free_space = page->GetMaxInsertSize();
+  tuple_count = page->GetLiveTupleCount();
+  page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(rid.GetPageId(), stubbed);
+  if (!stubbed) {
+    DeleteRelocatedTuple(new_target, false, txn);
+    return false;
+  }
+  UpdatePageEntry(rid.GetPageId(), free_space, tuple_count);
+  if (forwarded) {
+    DeleteRelocatedTuple(target, false, txn);
+  }
+  return true;
+}
+
+RowId TableHeap::InsertRelocatedTuple(Row &row, Txn *txn) {
+  uint32_t tuple_size = schema_->GetRowFormat().GetSerializedSize(row);
+  page_id_t page_id;
+  page_id_t failed_page_id = INVALID_PAGE_ID;
+  while ((page_id = FindPageWithSpace(tuple_size)) != INVALID_PAGE_ID && page_id != failed_page_id) {
+    if (InsertIntoPage(page_id, row, txn, true)) {
+      return row.GetRowId();
+    }
+    failed_page_id = page_id;
+  }
+  if (InsertIntoPage(last_page_id_, row, txn, true)) {
+    return row.GetRowId();
+  }
+  page_id = AppendNewPage(txn);
+  if (page_id != INVALID_PAGE_ID && InsertIntoPage(page_id, row, txn, true)) {
+    return row.GetRowId();
+  }
+  return INVALID_ROWID;
+}
+
+void TableHeap::DeleteRelocatedTuple(const RowId &rid, bool free_overflow, Txn *txn) {
+  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
+  assert(page != nullptr);
+  page->WLatch();
+  if (free_overflow && has_overflow_) {
+    FreeOverflowPages(page->GetTupleData(rid.GetSlotNum(), true));
+  }
+  page->ApplyDelete(rid, txn, log_manager_);
+  uint32_t free_space = page->GetMaxInsertSize();
+  uint32_t tuple_count = page->GetLiveTupleCount();
+  page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(rid.GetPageId(), true);
+  UpdatePageEntry(rid.GetPageId(), free_space, tuple_count);
+}
+
+bool TableHeap::ClearForwards(TablePage *page, Txn *txn) {
+  bool cleared = false;
+  for (uint32_t slot_num = 0; slot_num < page->GetSlotCount(); slot_num++) {
+    if (!page->IsTupleVisible(slot_num) || !page->IsForwarded(slot_num)) {
+      continue;
+    }
+    RowId target = page->GetForwardRid(slot_num);
+    ASSERT(target.GetPageId() != page->GetTablePageId(), "A tuple is never relocated into its own page.");
+    auto tuple_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(target.GetPageId()));
+    tuple_page->WLatch();
+    Row row(target);
+    tuple_page->GetTuple(&row, schema_, txn, lock_manager_);
+    bool moved_back = page->ClearForward(slot_num, row, schema_);
+    if (moved_back) {
+      tuple_page->ApplyDelete(target, txn, log_manager_);
+      cleared = true;
+    }
+    tuple_page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(target.GetPageId(), moved_back);
+  }
+  return cleared;
 }
 
-/**
- * TODO: Student Implement
- */
 void TableHeap::ApplyDelete(const RowId &rid, Txn *txn) {
   // Step1: Find the page which contains the tuple.
   // Step2: Delete the tuple from the page.
   auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
-  if (page == nullptr) {
+  assert(page != nullptr);
+  page->WLatch();
+  RowId target = page->IsForwarded(rid.GetSlotNum()) ? page->GetForwardRid(rid.GetSlotNum()) : INVALID_ROWID;
+  if (has_overflow_) {
+    FreeOverflowPages(page->GetTupleData(rid.GetSlotNum(), true));
+  }
+  page->ApplyDelete(rid, txn, log_manager_);
+  uint32_t free_space = page->GetMaxInsertSize();
+  uint32_t tuple_count = page->GetLiveTupleCount();
+  page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(rid.GetPageId(), true);
+  UpdatePageEntry(rid.GetPageId(), free_space, tuple_count);
+  // the relocated tuple goes along with its stub
+  if (target.GetPageId() != INVALID_PAGE_ID) {
+    DeleteRelocatedTuple(target, true, txn);
   }
-  page->ApplyDelete(rid,txn,log_manager_);
 }
 
 void TableHeap::RollbackDelete(const RowId &rid, Txn *txn) {
@@ -96,20 +680,226 @@ void TableHeap::RollbackDelete(const RowId &rid, Txn *txn) {
   // Rollback to delete.
   page->WLatch();
   page->RollbackDelete(rid, txn, log_manager_);
+  uint32_t free_space = page->GetMaxInsertSize();
+  uint32_t tuple_count = page->GetLiveTupleCount();
   page->WUnlatch();
+  if (dead_tuple_count_ > 0) {
+    dead_tuple_count_--;
+  }
   buffer_pool_manager_->UnpinPage(page->GetTablePageId(), true);
+  UpdatePageEntry(rid.GetPageId(), free_space, tuple_count);
+}
+
+uint32_t TableHeap::Vacuum(std::vector<std::pair<RowId, Row>> &moved_rows, Txn *txn) {
+  // Apply the pending deletes page by page, then move the relocated tuples back into the room it made.
+  for (page_id_t page_id = first_page_id_; page_id != INVALID_PAGE_ID;) {
+    auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+    page->WLatch();
+    if (has_overflow_) {
+      FreeOverflowPages(page, true);
+    }
+    std::vector<RowId> deleted_targets;
+    for (uint32_t slot_num = 0; slot_num < page->GetSlotCount(); slot_num++) {
+      if (page->IsForwarded(slot_num) && !page->IsTupleVisible(slot_num)) {
+        deleted_targets.push_back(page->GetForwardRid(slot_num));
+      }
+    }
+    dead_tuple_count_ -= std::min(dead_tuple_count_, page->Compact(txn, log_manager_));
+    page_id_t next_page_id = page->GetNextPageId();
+    page->WUnlatch();
+    // compaction may reorder the tuples even with nothing to apply
+    buffer_pool_manager_->UnpinPage(page_id, true);
+    for (const auto &target : deleted_targets) {
+      DeleteRelocatedTuple(target, true, txn);
+    }
+    page_id = next_page_id;
+  }
+  for (page_id_t page_id = first_page_id_; page_id != INVALID_PAGE_ID;) {
+    auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+    page->WLatch();
+    bool cleared = ClearForwards(page, txn);
+    page_id_t next_page_id = page->GetNextPageId();
+    page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(page_id, cleared);
+    page_id = next_page_id;
+  }
+  // Merge each page into its predecessor when all of its tuples fit.
+  uint32_t freed_pages = 0;
+  page_id_t page_id = first_page_id_;
+  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+  page->WLatch();
+  while (page->GetNextPageId() != INVALID_PAGE_ID) {
+    page_id_t next_page_id = page->GetNextPageId();
+    auto next_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(next_page_id));
+    next_page->WLatch();
+    if (next_page->HasForwarding() ||
+        !page->HasRoomFor(next_page->GetLiveTupleCount(), next_page->GetTupleDataSize())) {
+      page->WUnlatch();
+      buffer_pool_manager_->UnpinPage(page_id, true);
+      page = next_page;
+      page_id = next_page_id;
+      continue;
+    }
+    RowId rid;
+    for (bool found = next_page->GetFirstTupleRid(&rid); found;) {
+      Row row(rid);
+      next_page->GetTuple(&row, schema_, txn, lock_manager_);
+      bool __attribute__((unused)) inserted = page->InsertTuple(row, schema_, txn, lock_manager_, log_manager_);
+      ASSERT(inserted, "Merged tuples must fit into the previous page.");
+      if (has_overflow_) {
+        overflow_store_.Resolve(&row);
+      }
+      if (has_dictionary_) {
+        dictionary_.Decode(&row);
+      }
+      moved_rows.emplace_back(rid, row);
+      RowId next_rid;
+      found = next_page->GetNextTupleRid(rid, &next_rid);
+      rid = next_rid;
+    }
+    // Unlink the emptied page.
+    page_id_t after_page_id = next_page->GetNextPageId();
+    page->SetNextPageId(after_page_id);
+    if (after_page_id != INVALID_PAGE_ID) {
+      auto after_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(after_page_id));
+      after_page->WLatch();
+      after_page->SetPrevPageId(page_id);
+      after_page->WUnlatch();
+      buffer_pool_manager_->UnpinPage(after_page_id, true);
+    }
+    next_page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(next_page_id, false);
+    buffer_pool_manager_->DeletePage(next_page_id);
+    freed_pages++;
+  }
+  page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(page_id, true);
+  RebuildFreeSpaceMap();
+  RebuildZoneMap(txn);
+  return freed_pages;
 }
 
-/**
- * TODO: Student Implement
- */
 bool TableHeap::GetTuple(Row *row, Txn *txn) {
-  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(row->GetRowId().GetPageId()));
+  page_id_t page_id = row->GetRowId().GetPageId();
+  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
   if (page == nullptr) {
     return false;
   }
-  page->GetTuple(row,schema_,txn,lock_manager_);
-  return  true;
+  page->RLatch();
+  RowId rid = row->GetRowId();
+  uint32_t slot_num = rid.GetSlotNum();
+  TablePage *tuple_page = page->IsTupleVisible(slot_num) ? FetchTuplePage(page, slot_num) : page;
+  row->SetRowId(RowId(tuple_page->GetTablePageId(), slot_num));
+  bool found = tuple_page->GetTuple(row, schema_, txn, lock_manager_);
+  row->SetRowId(rid);
+  ReleaseTuplePage(page, tuple_page);
+  page->RUnlatch();
+  buffer_pool_manager_->UnpinPage(page_id, false);
+  if (found && has_overflow_) {
+    overflow_store_.Resolve(row);
+  }
+  if (found && has_dictionary_) {
+    dictionary_.Decode(row);
+  }
+  return found;
+}
+
+uint64_t TableHeap::GetTupleCount() {
+  uint64_t tuple_count = 0;
+  for (auto fsm_page_id : fsm_page_ids_) {
+    auto fsm_page = reinterpret_cast<FreeSpaceMapPage *>(buffer_pool_manager_->FetchPage(fsm_page_id)->GetData());
+    for (uint32_t i = 0; i < fsm_page->GetEntryCount(); i++) {
+      tuple_count += fsm_page->GetTupleCount(i);
+    }
+    buffer_pool_manager_->UnpinPage(fsm_page_id, false);
+  }
+  return tuple_count;
+}
+
+bool TableHeap::ScanBatch(page_id_t &cursor, RowBatch &batch, Txn *txn) {
+  batch.Clear();
+  while (batch.Empty() && cursor != INVALID_PAGE_ID) {
+    if (!ScanPage(cursor, batch, txn, &cursor)) {
+      return false;
+    }
+  }
+  return !batch.Empty();
+}
+
+bool TableHeap::ScanPage(page_id_t page_id, RowBatch &batch, Txn *, page_id_t *next_page_id) {
+  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+  if (page == nullptr) {
+    return false;
+  }
+  page->RLatch();
+  std::unique_ptr<PaxLayout> pax_layout;
+  if (pax_capacity_ != 0) {
+    pax_layout = std::make_unique<PaxLayout>(page->GetPaxLayout(schema_));
+  }
+  RowId rid;
+  for (bool found = page->GetFirstTupleRid(&rid); found; found = page->GetNextTupleRid(rid, &rid)) {
+    Row *row = batch.Append();
+    if (pax_layout != nullptr) {
+      page->ReadPaxTuple(*pax_layout, rid.GetSlotNum(), row, schema_);
+    } else {
+      uint32_t slot_num = rid.GetSlotNum();
+      TablePage *tuple_page = FetchTuplePage(page, slot_num);
+      schema_->GetRowFormat().DeserializeFrom(tuple_page->GetTupleData(slot_num), row);
+      ReleaseTuplePage(page, tuple_page);
+    }
+    row->SetRowId(rid);
+    if (has_overflow_) {
+      overflow_store_.Resolve(row);
+    }
+    if (has_dictionary_) {
+      dictionary_.Decode(row);
+    }
+  }
+  if (next_page_id != nullptr) {
+    *next_page_id = page->GetNextPageId();
+  }
+  page->RUnlatch();
+  buffer_pool_manager_->UnpinPage(page_id, false);
+  return true;
+}
+
+TablePage *TableHeap::FetchTuplePage(TablePage *page, uint32_t &slot_num) {
+  if (!page->IsForwarded(slot_num)) {
+    return page;
+  }
+  RowId target = page->GetForwardRid(slot_num);
+  auto tuple_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(target.GetPageId()));
+  assert(tuple_page != nullptr);
+  tuple_page->RLatch();
+  slot_num = target.GetSlotNum();
+  return tuple_page;
+}
+
+void TableHeap::ReleaseTuplePage(TablePage *page, TablePage *tuple_page) {
+  if (tuple_page != page) {
+    tuple_page->RUnlatch();
+    buffer_pool_manager_->UnpinPage(tuple_page->GetTablePageId(), false);
+  }
+}
+
+void TableHeap::FreeOverflowPages(TablePage *page, bool pending_only) {
+  if (!has_overflow_) {
+    return;
+  }
+  for (uint32_t slot_num = 0; slot_num < page->GetSlotCount(); slot_num++) {
+    if (!pending_only || page->GetTupleData(slot_num) == nullptr) {
+      FreeOverflowPages(page->GetTupleData(slot_num, true));
+    }
+  }
+}
+
+void TableHeap::FreeOverflowPages(char *tuple) {
+  if (tuple == nullptr) {
+    return;
+  }
+  Row row;
+  schema_->GetRowFormat().DeserializeFrom(tuple, &row);
+  overflow_store_.Free(row);
 }
 
 void TableHeap::DeleteTable(page_id_t page_id) {
@@ -117,10 +907,14 @@ void TableHeap::DeleteTable(page_id_t page_id) {
     auto temp_table_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));  // 删除table_heap
     if (temp_table_page->GetNextPageId() != INVALID_PAGE_ID)
       DeleteTable(temp_table_page->GetNextPageId());
+    FreeOverflowPages(temp_table_page, false);
     buffer_pool_manager_->UnpinPage(page_id, false);
     buffer_pool_manager_->DeletePage(page_id);
   } else {
     DeleteTable(first_page_id_);
+    FreeFreeSpaceMap();
+    dictionary_.Free();
+    zone_map_.Free();
   }
 }
 
@@ -128,41 +922,20 @@ void TableHeap::DeleteTable(page_id_t page_id) {
  * TODO: Student Implement
  */
 TableIterator TableHeap::Begin(Txn *txn) {
-  page_id_t first_page_id = first_page_id_;
-  if (first_page_id_ == INVALID_PAGE_ID) {
-    return End();
-  }
-  TablePage *first_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(first_page_id_));
-  RowId first_rd;
-  //in the first page
-  if (first_page->GetFirstTupleRid(&first_rd)) {
-    Row *row = new Row(first_rd);
-    buffer_pool_manager_->UnpinPage(first_page_id_, false);
-    GetTuple(row, txn);
-    return TableIterator(this, row, first_rd);
-  } else {
-    page_id_t page_id = first_page->GetNextPageId();
-    if (page_id == INVALID_PAGE_ID) {
-      buffer_pool_manager_->UnpinPage(first_page_id_, false);
-      return End();
-    }
-    while (1) {
-      TablePage *page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
-      if (page->GetFirstTupleRid(&first_rd)) {
-        Row *row = new Row(first_rd);
-        buffer_pool_manager_->UnpinPage(page_id, false);
-        GetTuple(row, txn);
-        return TableIterator(this, row, first_rd);
-      } else {
-        buffer_pool_manager_->UnpinPage(page_id, false);
-        page_id = page->GetNextPageId();
-        if (page_id == INVALID_PAGE_ID) {
-          buffer_pool_manager_->UnpinPage(first_page_id_, false);
-          return End();
-        }
-      }
+  RowId first_rid;
+  for (page_id_t page_id = first_page_id_; page_id != INVALID_PAGE_ID;) {
+    auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+    bool found = page->GetFirstTupleRid(&first_rid);
+    page_id_t next_page_id = page->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    if (found) {
+      auto row = new Row(first_rid);
+      GetTuple(row, txn);
+      return TableIterator(this, row, first_rid);
     }
+    page_id = next_page_id;
   }
+  return End();
 }
 
 /**
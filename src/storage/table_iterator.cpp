@@ -21,8 +21,14 @@ TableIterator::TableIterator(const TableIterator &other) {
   this->rowid.Set(other.rowid.GetPageId(), other.rowid.GetSlotNum());
 }
 
+TableIterator::TableIterator(TableIterator &&other) noexcept
+    : row(other.row), table_heap_(other.table_heap_), rowid(other.rowid) {
+  other.row = nullptr;
+  other.rowid.Set(INVALID_PAGE_ID, 0);
+}
+
 TableIterator::~TableIterator() {
-  if (row != nullptr) delete row;
+  delete row;
 }
 
 bool TableIterator::operator==(const TableIterator &itr) const {
@@ -48,6 +54,10 @@ Row *TableIterator::operator->() {
 }
 
 TableIterator &TableIterator::operator=(const TableIterator &itr) noexcept {
+  if (this == &itr) {
+    return *this;
+  }
+  delete row;
   if (itr.row == nullptr) {
     this->row = nullptr;
   } else {
@@ -58,64 +68,61 @@ TableIterator &TableIterator::operator=(const TableIterator &itr) noexcept {
   return *this;
 }
 
+TableIterator &TableIterator::operator=(TableIterator &&itr) noexcept {
+  if (this == &itr) {
+    return *this;
+  }
+  delete row;
+  row = itr.row;
+  table_heap_ = itr.table_heap_;
+  rowid = itr.rowid;
+  itr.row = nullptr;
+  itr.rowid.Set(INVALID_PAGE_ID, 0);
+  return *this;
+}
+
 // ++iter
 TableIterator &TableIterator::operator++() {
-  //find in the same page
-  TablePage *this_page = reinterpret_cast<TablePage *>(table_heap_->buffer_pool_manager_->FetchPage(rowid.GetPageId()));
+  auto bpm = table_heap_->buffer_pool_manager_;
+  auto page = reinterpret_cast<TablePage *>(bpm->FetchPage(rowid.GetPageId()));
   // page not existence
-  if (this_page == nullptr) {
-    table_heap_->buffer_pool_manager_->UnpinPage(rowid.GetPageId(), false);
+  if (page == nullptr) {
     *this = table_heap_->End();
     return *this;
   }
+  //find in this page, then in the first page holding a tuple after it
   RowId next_rid;
-  //find in this page
-  if (this_page->GetNextTupleRid(rowid, &next_rid)) {
-    Row *next_row = new Row(next_rid);
-    this->table_heap_->GetTuple(next_row, nullptr);
-    table_heap_->buffer_pool_manager_->UnpinPage(rowid.GetPageId(), false);
-    row = next_row;
-    rowid.Set(next_rid.GetPageId(), next_rid.GetSlotNum());
-    return *this;
-  }
-  //the last turple in this page
-  //find the next page
-  page_id_t next_page_id = this_page->GetNextPageId();
-  if (next_page_id == INVALID_PAGE_ID) {
-    table_heap_->buffer_pool_manager_->UnpinPage(rowid.GetPageId(), false);
-    rowid.Set(INVALID_PAGE_ID, 0);
-    row = nullptr;
-    return *this;
-  }
-  this_page = reinterpret_cast<TablePage *>(table_heap_->buffer_pool_manager_->FetchPage(next_page_id));
-  while (1) {
-    if (this_page->GetFirstTupleRid(&next_rid)) {
-      Row *next_row = new Row(next_rid);
-      next_row->GetFields().clear();
-      this->table_heap_->GetTuple(next_row, nullptr);
-      table_heap_->buffer_pool_manager_->UnpinPage(rowid.GetPageId(), false);
-      rowid.Set(next_rid.GetPageId(), next_rid.GetSlotNum());
-      row = next_row;
+  bool found = page->GetNextTupleRid(rowid, &next_rid);
+  while (!found) {
+    page_id_t next_page_id = page->GetNextPageId();
+    bpm->UnpinPage(page->GetTablePageId(), false);
+    if (next_page_id == INVALID_PAGE_ID) {
+      *this = table_heap_->End();
       return *this;
-    } else {
-      table_heap_->buffer_pool_manager_->UnpinPage(rowid.GetPageId(), false);
-      next_page_id = this_page->GetNextPageId();
-      this_page = reinterpret_cast<TablePage *>(table_heap_->buffer_pool_manager_->FetchPage(next_page_id));
-      if (next_page_id == INVALID_PAGE_ID) {
-        table_heap_->buffer_pool_manager_->UnpinPage(rowid.GetPageId(), false);
-        rowid.Set(INVALID_PAGE_ID, 0);
-        row = nullptr;
-        return *this;
-      }
     }
+    page = reinterpret_cast<TablePage *>(bpm->FetchPage(next_page_id));
+    found = page->GetFirstTupleRid(&next_rid);
   }
+  bpm->UnpinPage(page->GetTablePageId(), false);
+  LoadRow(next_rid);
+  return *this;
 }
 
 // iter++
 TableIterator TableIterator::operator++(int) {
-  Row *row_next = new Row(*(this->row));
-  TableHeap *this_heap_next = this->table_heap_;
-  RowId rid_next = this->rowid;
+  // hand the current row to the old iterator instead of copying it
+  TableIterator old(table_heap_, row, rowid);
+  row = nullptr;
   ++(*this);
-  return TableIterator(this_heap_next, row_next, rid_next);
+  return old;
+}
+
+void TableIterator::LoadRow(const RowId &rid) {
+  if (row == nullptr) {
+    row = new Row();
+  }
+  row->destroy();
+  row->SetRowId(rid);
+  table_heap_->GetTuple(row, nullptr);
+  rowid = rid;
 }
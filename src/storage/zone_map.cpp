@@ -0,0 +1,225 @@
+#include "storage/zone_map.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+template <typename T>
+inline T ReadWord(uint32_t word) {
+  T value;
+  memcpy(&value, &word, sizeof(T));
+  return value;
+}
+
+template <typename T>
+inline uint32_t ToWord(T value) {
+  uint32_t word;
+  memcpy(&word, &value, sizeof(T));
+  return word;
+}
+
+template <typename T>
+bool RangeMayMatch(T min, T max, const std::string &comp, T value) {
+  // an empty zone, no value of the column was recorded for the page
+  if (min > max) {
+    return false;
+  }
+  if (comp == "=") {
+    return min <= value && value <= max;
+  } else if (comp == "<") {
+    return min < value;
+  } else if (comp == "<=") {
+    return min <= value;
+  } else if (comp == ">") {
+    return max > value;
+  } else if (comp == ">=") {
+    return max >= value;
+  }
+  return true;
+}
+
+}  // namespace
+
+ZoneMap::ZoneMap(BufferPoolManager *buffer_pool_manager, const Schema *schema)
+    : buffer_pool_manager_(buffer_pool_manager), slots_(schema->GetColumnCount(), -1) {
+  for (uint32_t i = 0; i < schema->GetColumnCount(); i++) {
+    TypeId type = schema->GetColumn(i)->GetType();
+    if (type == TypeId::kTypeInt || type == TypeId::kTypeFloat) {
+      slots_[i] = types_.size();
+      types_.push_back(type);
+    }
+  }
+  zone_words_ = 2 * types_.size();
+  zones_per_page_ = zone_words_ == 0 ? 0 : ZoneMapPage::CAPACITY_WORDS / zone_words_;
+}
+
+bool ZoneMap::Create() {
+  if (!IsEnabled()) {
+    return true;
+  }
+  page_id_t page_id;
+  auto page = buffer_pool_manager_->NewPage(page_id);
+  if (page == nullptr) {
+    return false;
+  }
+  reinterpret_cast<ZoneMapPage *>(page->GetData())->Init(page_id);
+  buffer_pool_manager_->UnpinPage(page_id, true);
+  page_ids_.push_back(page_id);
+  return true;
+}
+
+void ZoneMap::Load(page_id_t first_page_id) {
+  page_ids_.clear();
+  words_.clear();
+  zone_count_ = 0;
+  for (page_id_t page_id = first_page_id; page_id != INVALID_PAGE_ID;) {
+    auto page = reinterpret_cast<ZoneMapPage *>(buffer_pool_manager_->FetchPage(page_id)->GetData());
+    page_ids_.push_back(page_id);
+    words_.insert(words_.end(), page->GetZone(0, zone_words_), page->GetZone(page->GetZoneCount(), zone_words_));
+    zone_count_ += page->GetZoneCount();
+    page_id_t next_page_id = page->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    page_id = next_page_id;
+  }
+}
+
+void ZoneMap::Free() {
+  for (auto page_id : page_ids_) {
+    buffer_pool_manager_->DeletePage(page_id);
+  }
+  page_ids_.clear();
+  words_.clear();
+  zone_count_ = 0;
+}
+
+void ZoneMap::Append() {
+  if (!IsEnabled()) {
+    return;
+  }
+  if (zone_count_ == page_ids_.size() * zones_per_page_) {
+    // chain a new page
+    page_id_t new_page_id;
+    auto new_page = reinterpret_cast<ZoneMapPage *>(buffer_pool_manager_->NewPage(new_page_id)->GetData());
+    new_page->Init(new_page_id);
+    buffer_pool_manager_->UnpinPage(new_page_id, true);
+    auto tail = reinterpret_cast<ZoneMapPage *>(buffer_pool_manager_->FetchPage(page_ids_.back())->GetData());
+    tail->SetNextPageId(new_page_id);
+    buffer_pool_manager_->UnpinPage(page_ids_.back(), true);
+    page_ids_.push_back(new_page_id);
+  }
+  words_.resize(words_.size() + zone_words_);
+  Clear(zone_count_++);
+  Write(zone_count_ - 1);
+}
+
+bool ZoneMap::Extend(uint32_t zone, const Row &row) {
+  if (!IsEnabled()) {
+    return false;
+  }
+  uint32_t *words = words_.data() + zone * zone_words_;
+  bool changed = false;
+  for (uint32_t i = 0; i < slots_.size(); i++) {
+    const Field *field = row.GetField(i);
+    if (slots_[i] < 0 || field->IsNull()) {
+      continue;
+    }
+    uint32_t word;
+    field->SerializeTo(reinterpret_cast<char *>(&word));
+    uint32_t *bounds = words + 2 * slots_[i];
+    if (types_[slots_[i]] == TypeId::kTypeInt) {
+      auto value = ReadWord<int32_t>(word);
+      if (value < ReadWord<int32_t>(bounds[0]) || value > ReadWord<int32_t>(bounds[1])) {
+        bounds[0] = ToWord(std::min(value, ReadWord<int32_t>(bounds[0])));
+        bounds[1] = ToWord(std::max(value, ReadWord<int32_t>(bounds[1])));
+        changed = true;
+      }
+    } else {
+      auto value = ReadWord<float>(word);
+      if (value < ReadWord<float>(bounds[0]) || value > ReadWord<float>(bounds[1])) {
+        bounds[0] = ToWord(std::min(value, ReadWord<float>(bounds[0])));
+        bounds[1] = ToWord(std::max(value, ReadWord<float>(bounds[1])));
+        changed = true;
+      }
+    }
+  }
+  return changed;
+}
+
+void ZoneMap::Write(uint32_t zone) {
+  page_id_t page_id = page_ids_[zone / zones_per_page_];
+  uint32_t index = zone % zones_per_page_;
+  auto page = reinterpret_cast<ZoneMapPage *>(buffer_pool_manager_->FetchPage(page_id)->GetData());
+  memcpy(page->GetZone(index, zone_words_), words_.data() + zone * zone_words_, zone_words_ * sizeof(uint32_t));
+  page->SetZoneCount(std::max(page->GetZoneCount(), index + 1));
+  buffer_pool_manager_->UnpinPage(page_id, true);
+}
+
+void ZoneMap::Reset(uint32_t zone_count) {
+  if (!IsEnabled()) {
+    return;
+  }
+  words_.resize(zone_count * zone_words_);
+  zone_count_ = zone_count;
+  for (uint32_t zone = 0; zone < zone_count; zone++) {
+    Clear(zone);
+  }
+}
+
+void ZoneMap::Clear(uint32_t zone) {
+  // bounds in reverse, so the first value recorded sets both
+  uint32_t *words = words_.data() + zone * zone_words_;
+  for (uint32_t i = 0; i < types_.size(); i++) {
+    if (types_[i] == TypeId::kTypeInt) {
+      words[2 * i] = ToWord(std::numeric_limits<int32_t>::max());
+      words[2 * i + 1] = ToWord(std::numeric_limits<int32_t>::min());
+    } else {
+      words[2 * i] = ToWord(std::numeric_limits<float>::infinity());
+      words[2 * i + 1] = ToWord(-std::numeric_limits<float>::infinity());
+    }
+  }
+}
+
+void ZoneMap::Flush() {
+  if (!IsEnabled()) {
+    return;
+  }
+  size_t page_count = std::max<size_t>((zone_count_ + zones_per_page_ - 1) / zones_per_page_, 1);
+  while (page_ids_.size() > page_count) {
+    buffer_pool_manager_->DeletePage(page_ids_.back());
+    page_ids_.pop_back();
+  }
+  while (page_ids_.size() < page_count) {
+    page_id_t page_id;
+    buffer_pool_manager_->NewPage(page_id);
+    buffer_pool_manager_->UnpinPage(page_id, true);
+    page_ids_.push_back(page_id);
+  }
+  for (size_t i = 0; i < page_ids_.size(); i++) {
+    auto page = reinterpret_cast<ZoneMapPage *>(buffer_pool_manager_->FetchPage(page_ids_[i])->GetData());
+    page->Init(page_ids_[i]);
+    if (i + 1 < page_ids_.size()) {
+      page->SetNextPageId(page_ids_[i + 1]);
+    }
+    uint32_t begin = i * zones_per_page_;
+    uint32_t count = std::min(zone_count_ - std::min(zone_count_, begin), zones_per_page_);
+    memcpy(page->GetZone(0, zone_words_), words_.data() + begin * zone_words_, count * zone_words_ * sizeof(uint32_t));
+    page->SetZoneCount(count);
+    buffer_pool_manager_->UnpinPage(page_ids_[i], true);
+  }
+}
+
+bool ZoneMap::MayMatch(uint32_t zone, uint32_t column, const std::string &comp, const Field &value) const {
+  if (!IsEnabled() || zone >= zone_count_ || slots_[column] < 0 || value.IsNull() ||
+      value.GetTypeId() != types_[slots_[column]]) {
+    return true;
+  }
+  const uint32_t *bounds = words_.data() + zone * zone_words_ + 2 * slots_[column];
+  uint32_t word;
+  value.SerializeTo(reinterpret_cast<char *>(&word));
+  if (types_[slots_[column]] == TypeId::kTypeInt) {
+    return RangeMayMatch(ReadWord<int32_t>(bounds[0]), ReadWord<int32_t>(bounds[1]), comp, ReadWord<int32_t>(word));
+  }
+  return RangeMayMatch(ReadWord<float>(bounds[0]), ReadWord<float>(bounds[1]), comp, ReadWord<float>(word));
+}
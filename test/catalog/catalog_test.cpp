@@ -126,4 +126,201 @@ TEST(CatalogTest, CatalogIndexTest) {
     ASSERT_EQ(rid.Get(), ret_02[i].Get());
   }
   delete db_02;
-}
\ No newline at end of file
+}
+
+TEST(CatalogTest, CatalogVacuumTest) {
+  auto db_01 = new DBStorageEngine(db_file_name, true);
+  auto &catalog_01 = db_01->catalog_mgr_;
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  Txn txn;
+  TableInfo *table_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog_01->CreateTable("table-1", schema.get(), &txn, table_info));
+  IndexInfo *index_info = nullptr;
+  std::vector<std::string> index_keys{"id"};
+  ASSERT_EQ(DB_SUCCESS, catalog_01->CreateIndex("table-1", "index-1", index_keys, &txn, index_info, "bptree"));
+  auto table_heap = table_info->GetTableHeap();
+  const int row_nums = 2000;
+  std::vector<RowId> rids;
+  for (int i = 0; i < row_nums; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i),
+                              Field(TypeId::kTypeChar, const_cast<char *>("minisql"), 7, true)};
+    Row row(fields);
+    ASSERT_TRUE(table_heap->InsertTuple(row, &txn));
+    Row key_row;
+    row.GetKeyFromRow(table_info->GetSchema(), index_info->GetIndexKeySchema(), key_row);
+    ASSERT_EQ(DB_SUCCESS, index_info->GetIndex()->InsertEntry(key_row, row.GetRowId(), &txn));
+    rids.push_back(row.GetRowId());
+  }
+  // keep every fourth row
+  for (int i = 0; i < row_nums; i++) {
+    if (i % 4 != 0) {
+      std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+      Row key_row(fields);
+      ASSERT_TRUE(table_heap->MarkDelete(rids[i], &txn));
+      ASSERT_EQ(DB_SUCCESS, index_info->GetIndex()->RemoveEntry(key_row, rids[i], &txn));
+    }
+  }
+  uint32_t page_count = table_heap->GetPageCount();
+  ASSERT_EQ(DB_TABLE_NOT_EXIST, catalog_01->VacuumTable("table-0", &txn));
+  // auto-vacuum is off by default, then runs on the background worker once enabled
+  ASSERT_FALSE(catalog_01->ScheduleAutoVacuum("table-1"));
+  catalog_01->SetAutoVacuumThreshold(1);
+  ASSERT_FALSE(catalog_01->ScheduleAutoVacuum("table-0"));
+  ASSERT_TRUE(catalog_01->ScheduleAutoVacuum("table-1"));
+  // looking the table up waits for its vacuum
+  ASSERT_EQ(DB_SUCCESS, catalog_01->GetTable("table-1", table_info));
+  ASSERT_LT(table_heap->GetPageCount(), page_count);
+  ASSERT_FALSE(catalog_01->ScheduleAutoVacuum("table-1"));
+  ASSERT_EQ(DB_SUCCESS, catalog_01->VacuumTable("table-1", &txn));
+  ASSERT_TRUE(db_01->bpm_->CheckAllUnpinned());
+  delete db_01;
+  // the moved rows are still reachable through the index after reloading
+  auto db_02 = new DBStorageEngine(db_file_name, false);
+  auto &catalog_02 = db_02->catalog_mgr_;
+  ASSERT_EQ(DB_SUCCESS, catalog_02->GetTable("table-1", table_info));
+  ASSERT_EQ(DB_SUCCESS, catalog_02->GetIndex("table-1", "index-1", index_info));
+  int count = 0;
+  for (auto it = table_info->GetTableHeap()->Begin(&txn); it != table_info->GetTableHeap()->End(); ++it) {
+    count++;
+  }
+  ASSERT_EQ(row_nums / 4, count);
+  for (int i = 0; i < row_nums; i += 4) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    Row key_row(fields);
+    std::vector<RowId> ret;
+    ASSERT_EQ(DB_SUCCESS, index_info->GetIndex()->ScanKey(key_row, ret, &txn));
+    ASSERT_EQ(1, ret.size());
+    Row row(ret[0]);
+    ASSERT_TRUE(table_info->GetTableHeap()->GetTuple(&row, &txn));
+    ASSERT_EQ(CmpBool::kTrue, row.GetField(0)->CompareEquals(Field(TypeId::kTypeInt, i)));
+  }
+  delete db_02;
+}
+
+TEST(CatalogTest, CatalogAnalyzeTest) {
+  auto db_01 = new DBStorageEngine(db_file_name, true);
+  auto &catalog_01 = db_01->catalog_mgr_;
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false),
+                                   new Column("account", TypeId::kTypeFloat, 2, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  Txn txn;
+  TableInfo *table_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog_01->CreateTable("table-1", schema.get(), &txn, table_info));
+  ASSERT_EQ(nullptr, table_info->GetStatistics());
+  // unique ids, ten names of which the two landing on every fifth row are always null, a constant account
+  const int row_nums = 20000;
+  for (int i = 0; i < row_nums; i++) {
+    std::string name = "name-" + std::to_string(i % 10);
+    char *data = i % 5 == 0 ? nullptr : const_cast<char *>(name.c_str());
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, data, name.size(), true),
+                              Field(TypeId::kTypeFloat, 1.5f)};
+    Row row(fields);
+    ASSERT_TRUE(table_info->GetTableHeap()->InsertTuple(row, &txn));
+  }
+  ASSERT_EQ(DB_TABLE_NOT_EXIST, catalog_01->AnalyzeTable("table-0", &txn));
+  ASSERT_EQ(DB_SUCCESS, catalog_01->AnalyzeTable("table-1", &txn));
+  ASSERT_EQ(DB_SUCCESS, catalog_01->AnalyzeTable("table-1", &txn));
+  ASSERT_TRUE(db_01->bpm_->CheckAllUnpinned());
+  auto statistics = table_info->GetStatistics();
+  ASSERT_NE(nullptr, statistics);
+  ASSERT_EQ(row_nums, statistics->GetRowCount());
+  ASSERT_EQ(table_info->GetTableHeap()->GetPageCount(), statistics->GetPageCount());
+  // the table is larger than the sample
+  ASSERT_LT(statistics->GetSampledRowCount(), row_nums);
+  ASSERT_GT(statistics->GetSampledRowCount(), 0);
+  auto &id = statistics->GetColumn(0);
+  EXPECT_EQ(0, id.GetNullFraction());
+  EXPECT_NEAR(row_nums, id.GetDistinctCount(), row_nums / 5);
+  ASSERT_EQ(HISTOGRAM_BUCKETS + 1, id.GetHistogramBounds().size());
+  for (size_t i = 1; i < id.GetHistogramBounds().size(); i++) {
+    EXPECT_EQ(CmpBool::kTrue, id.GetHistogramBounds()[i - 1].CompareLessThan(id.GetHistogramBounds()[i]));
+  }
+  EXPECT_EQ(CmpBool::kTrue, id.GetMin()->CompareGreaterThanEquals(Field(TypeId::kTypeInt, 0)));
+  EXPECT_EQ(CmpBool::kTrue, id.GetMax()->CompareLessThan(Field(TypeId::kTypeInt, row_nums)));
+  auto &name = statistics->GetColumn(1);
+  EXPECT_NEAR(0.2, name.GetNullFraction(), 0.02);
+  EXPECT_EQ(8, name.GetDistinctCount());
+  EXPECT_EQ("name-1", std::string(name.GetMin()->GetData(), name.GetMin()->GetLength()));
+  EXPECT_EQ("name-9", std::string(name.GetMax()->GetData(), name.GetMax()->GetLength()));
+  auto &account = statistics->GetColumn(2);
+  EXPECT_EQ(1, account.GetDistinctCount());
+  EXPECT_EQ(CmpBool::kTrue, account.GetMin()->CompareEquals(*account.GetMax()));
+  delete db_01;
+  // the statistics are loaded with the catalog
+  auto db_02 = new DBStorageEngine(db_file_name, false);
+  auto &catalog_02 = db_02->catalog_mgr_;
+  TableInfo *table_info_02 = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog_02->GetTable("table-1", table_info_02));
+  auto loaded = table_info_02->GetStatistics();
+  ASSERT_NE(nullptr, loaded);
+  ASSERT_EQ(row_nums, loaded->GetRowCount());
+  ASSERT_EQ(3, loaded->GetColumnCount());
+  EXPECT_NEAR(0.2, loaded->GetColumn(1).GetNullFraction(), 0.02);
+  EXPECT_EQ(8, loaded->GetColumn(1).GetDistinctCount());
+  ASSERT_EQ(HISTOGRAM_BUCKETS + 1, loaded->GetColumn(0).GetHistogramBounds().size());
+  delete db_02;
+}
+
+TEST(CatalogTest, CatalogTruncateTest) {
+  auto db_01 = new DBStorageEngine(db_file_name, true);
+  auto &catalog_01 = db_01->catalog_mgr_;
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  Txn txn;
+  TableInfo *table_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog_01->CreateTable("table-1", schema.get(), &txn, table_info));
+  IndexInfo *index_info = nullptr;
+  std::vector<std::string> index_keys{"id"};
+  ASSERT_EQ(DB_SUCCESS, catalog_01->CreateIndex("table-1", "index-1", index_keys, &txn, index_info, "bptree"));
+  const int row_nums = 2000;
+  auto insert_rows = [&](int begin, int end) {
+    for (int i = begin; i < end; i++) {
+      std::vector<Field> fields{Field(TypeId::kTypeInt, i),
+                                Field(TypeId::kTypeChar, const_cast<char *>("minisql"), 7, true)};
+      Row row(fields);
+      ASSERT_TRUE(table_info->GetTableHeap()->InsertTuple(row, &txn));
+      Row key_row;
+      row.GetKeyFromRow(table_info->GetSchema(), index_info->GetIndexKeySchema(), key_row);
+      ASSERT_EQ(DB_SUCCESS, index_info->GetIndex()->InsertEntry(key_row, row.GetRowId(), &txn));
+    }
+  };
+  insert_rows(0, row_nums);
+  ASSERT_EQ(DB_SUCCESS, catalog_01->AnalyzeTable("table-1", &txn));
+  page_id_t old_first_page_id = table_info->GetRootPageId();
+  ASSERT_EQ(DB_TABLE_NOT_EXIST, catalog_01->TruncateTable("table-0", &txn));
+  ASSERT_EQ(DB_SUCCESS, catalog_01->TruncateTable("table-1", &txn));
+  ASSERT_NE(old_first_page_id, table_info->GetRootPageId());
+  ASSERT_EQ(0, table_info->GetTableHeap()->GetTupleCount());
+  ASSERT_EQ(nullptr, table_info->GetStatistics());
+  std::vector<Field> fields{Field(TypeId::kTypeInt, 0)};
+  Row key_row(fields);
+  std::vector<RowId> ret;
+  ASSERT_EQ(DB_KEY_NOT_FOUND, index_info->GetIndex()->ScanKey(key_row, ret, &txn));
+  delete db_01;
+  // the truncated table is reloaded empty and the old pages were freed before closing
+  auto db_02 = new DBStorageEngine(db_file_name, false);
+  auto &catalog_02 = db_02->catalog_mgr_;
+  ASSERT_EQ(DB_SUCCESS, catalog_02->GetTable("table-1", table_info));
+  ASSERT_EQ(DB_SUCCESS, catalog_02->GetIndex("table-1", "index-1", index_info));
+  ASSERT_NE(old_first_page_id, table_info->GetRootPageId());
+  ASSERT_EQ(0, table_info->GetTableHeap()->GetTupleCount());
+  ASSERT_TRUE(db_02->bpm_->IsPageFree(old_first_page_id));
+  // the emptied table takes new rows, the old keys included
+  insert_rows(row_nums / 2, row_nums / 2 + 100);
+  for (int i = 0; i < row_nums; i++) {
+    std::vector<Field> key_fields{Field(TypeId::kTypeInt, i)};
+    Row key(key_fields);
+    ret.clear();
+    bool kept = i >= row_nums / 2 && i < row_nums / 2 + 100;
+    ASSERT_EQ(kept ? DB_SUCCESS : DB_KEY_NOT_FOUND, index_info->GetIndex()->ScanKey(key, ret, &txn));
+  }
+  // dropping right after a truncate waits for the frees still using the index
+  ASSERT_EQ(DB_SUCCESS, catalog_02->TruncateTable("table-1", &txn));
+  ASSERT_EQ(DB_SUCCESS, catalog_02->DropIndex("table-1", "index-1"));
+  ASSERT_EQ(DB_SUCCESS, catalog_02->DropTable("table-1"));
+  delete db_02;
+}
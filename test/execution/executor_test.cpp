@@ -155,3 +155,156 @@ TEST_F(ExecutorTest, SimpleUpdateTest) {
     ASSERT_TRUE(row.GetField(1)->CompareEquals(Field(kTypeChar, const_cast<char *>("minisql"), 7, false)));
   }
 }
+
+// UPDATE table-1 SET account = 9.5 where id = 500; with indexes on id and account
+TEST_F(ExecutorTest, IndexedUpdateTest) {
+  TableInfo *table_info;
+  GetExecutorContext()->GetCatalog()->GetTable("table-1", table_info);
+  const Schema *schema = table_info->GetSchema();
+  IndexInfo *id_index = nullptr;
+  IndexInfo *account_index = nullptr;
+  ASSERT_EQ(DB_SUCCESS, GetExecutorContext()->GetCatalog()->CreateIndex("table-1", "index-id", {"id"}, GetTxn(),
+                                                                         id_index, "bptree"));
+  ASSERT_EQ(DB_SUCCESS, GetExecutorContext()->GetCatalog()->CreateIndex("table-1", "index-account", {"account"},
+                                                                         GetTxn(), account_index, "bptree"));
+  auto col_a = MakeColumnValueExpression(*schema, 0, "id");
+  auto const500 = MakeConstantValueExpression(Field(kTypeInt, 500));
+  auto predicate = MakeComparisonExpression(col_a, const500, "=");
+  auto scan_plan = make_shared<SeqScanPlanNode>(schema, table_info->GetTableName(), predicate);
+  std::vector<Row> result_set{};
+  GetExecutionEngine()->ExecutePlan(scan_plan, &result_set, GetTxn(), GetExecutorContext());
+  ASSERT_EQ(result_set.size(), 1);
+  RowId rid = result_set[0].GetRowId();
+  result_set.clear();
+
+  std::unordered_map<uint32_t, AbstractExpressionRef> update_attrs{};
+  update_attrs.emplace(static_cast<uint32_t>(2), MakeConstantValueExpression(Field(kTypeFloat, 9.5f)));
+  auto update_plan = std::make_shared<UpdatePlanNode>(schema, scan_plan, "table-1", update_attrs);
+  GetExecutionEngine()->ExecutePlan(update_plan, &result_set, GetTxn(), GetExecutorContext());
+
+  // the tuple stays at its rid: the id index is left as it was and the account index follows the new value
+  Fields id_key{Field(kTypeInt, 500)};
+  Fields account_key{Field(kTypeFloat, 9.5f)};
+  std::vector<RowId> rids{};
+  ASSERT_EQ(DB_SUCCESS, id_index->GetIndex()->ScanKey(Row(id_key), rids, GetTxn()));
+  ASSERT_EQ(1, rids.size());
+  ASSERT_TRUE(rids[0] == rid);
+  rids.clear();
+  ASSERT_EQ(DB_SUCCESS, account_index->GetIndex()->ScanKey(Row(account_key), rids, GetTxn()));
+  ASSERT_EQ(1, rids.size());
+  ASSERT_TRUE(rids[0] == rid);
+  Row row(rid);
+  ASSERT_TRUE(table_info->GetTableHeap()->GetTuple(&row, GetTxn()));
+  ASSERT_TRUE(row.GetField(2)->CompareEquals(Field(kTypeFloat, 9.5f)));
+}
+
+// INSERT and UPDATE of a name longer than char(64), with an index on name
+TEST_F(ExecutorTest, OverlongCharTest) {
+  TableInfo *table_info;
+  GetExecutorContext()->GetCatalog()->GetTable("table-1", table_info);
+  const Schema *schema = table_info->GetSchema();
+  IndexInfo *name_index = nullptr;
+  ASSERT_EQ(DB_SUCCESS, GetExecutorContext()->GetCatalog()->CreateIndex("table-1", "index-name", {"name"}, GetTxn(),
+                                                                         name_index, "bptree"));
+  std::string name(65, 'a');
+  Field long_name(kTypeChar, const_cast<char *>(name.c_str()), name.size(), false);
+
+  // the row is rejected before it reaches the heap or the index
+  std::vector<std::vector<AbstractExpressionRef>> raw_values{
+      {MakeConstantValueExpression(Field(kTypeInt, 1001)), MakeConstantValueExpression(long_name),
+       MakeConstantValueExpression(Field(kTypeFloat, 2.33f))}};
+  auto value_plan = std::make_shared<ValuesPlanNode>(nullptr, raw_values);
+  auto insert_plan = std::make_shared<InsertPlanNode>(nullptr, value_plan, "table-1");
+  std::vector<Row> result_set{};
+  GetExecutionEngine()->ExecutePlan(insert_plan, &result_set, GetTxn(), GetExecutorContext());
+  ASSERT_TRUE(result_set.empty());
+  ASSERT_EQ(1000, table_info->GetTableHeap()->GetTupleCount());
+
+  // the update leaves the row as it was
+  auto col_a = MakeColumnValueExpression(*schema, 0, "id");
+  auto const500 = MakeConstantValueExpression(Field(kTypeInt, 500));
+  auto predicate = MakeComparisonExpression(col_a, const500, "=");
+  auto scan_plan = make_shared<SeqScanPlanNode>(schema, table_info->GetTableName(), predicate);
+  std::unordered_map<uint32_t, AbstractExpressionRef> update_attrs{};
+  update_attrs.emplace(static_cast<uint32_t>(1), MakeConstantValueExpression(long_name));
+  auto update_plan = std::make_shared<UpdatePlanNode>(schema, scan_plan, "table-1", update_attrs);
+  GetExecutionEngine()->ExecutePlan(update_plan, &result_set, GetTxn(), GetExecutorContext());
+  ASSERT_TRUE(result_set.empty());
+  GetExecutionEngine()->ExecutePlan(scan_plan, &result_set, GetTxn(), GetExecutorContext());
+  ASSERT_EQ(1, result_set.size());
+  ASSERT_LE(result_set[0].GetField(1)->GetLength(), 64);
+}
+
+TEST_F(ExecutorTest, NotNullableColumnTest) {
+  TableInfo *table_info;
+  GetExecutorContext()->GetCatalog()->GetTable("table-1", table_info);
+  const Schema *schema = table_info->GetSchema();
+  std::string name = "null id";
+  Field null_id(kTypeInt);
+
+  // id is not nullable, the row is rejected before it reaches the heap
+  std::vector<std::vector<AbstractExpressionRef>> raw_values{
+      {MakeConstantValueExpression(null_id),
+       MakeConstantValueExpression(Field(kTypeChar, const_cast<char *>(name.c_str()), name.size(), false)),
+       MakeConstantValueExpression(Field(kTypeFloat, 2.33f))}};
+  auto value_plan = std::make_shared<ValuesPlanNode>(nullptr, raw_values);
+  auto insert_plan = std::make_shared<InsertPlanNode>(nullptr, value_plan, "table-1");
+  std::vector<Row> result_set{};
+  GetExecutionEngine()->ExecutePlan(insert_plan, &result_set, GetTxn(), GetExecutorContext());
+  ASSERT_TRUE(result_set.empty());
+  ASSERT_EQ(1000, table_info->GetTableHeap()->GetTupleCount());
+
+  // the update leaves the row as it was
+  auto col_a = MakeColumnValueExpression(*schema, 0, "id");
+  auto const500 = MakeConstantValueExpression(Field(kTypeInt, 500));
+  auto predicate = MakeComparisonExpression(col_a, const500, "=");
+  auto scan_plan = make_shared<SeqScanPlanNode>(schema, table_info->GetTableName(), predicate);
+  std::unordered_map<uint32_t, AbstractExpressionRef> update_attrs{};
+  update_attrs.emplace(static_cast<uint32_t>(0), MakeConstantValueExpression(null_id));
+  auto update_plan = std::make_shared<UpdatePlanNode>(schema, scan_plan, "table-1", update_attrs);
+  GetExecutionEngine()->ExecutePlan(update_plan, &result_set, GetTxn(), GetExecutorContext());
+  ASSERT_TRUE(result_set.empty());
+  GetExecutionEngine()->ExecutePlan(scan_plan, &result_set, GetTxn(), GetExecutorContext());
+  ASSERT_EQ(1, result_set.size());
+}
+
+// SELECT id, name FROM table-1 WHERE id >= 100, scanned by several threads
+TEST_F(ExecutorTest, ParallelSeqScanTest) {
+  TableInfo *table_info;
+  GetExecutorContext()->GetCatalog()->GetTable("table-1", table_info);
+  // grow the table to a few morsels
+  char characters[64];
+  memset(characters, 'a', sizeof(characters));
+  const int row_nums = 10000;
+  for (int i = 1000; i < row_nums; i++) {
+    Fields fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, characters, 64, true),
+                  Field(TypeId::kTypeFloat, 0.f)};
+    Row row(fields);
+    ASSERT_TRUE(table_info->GetTableHeap()->InsertTuple(row, nullptr));
+  }
+  ASSERT_GT(table_info->GetTableHeap()->GetPageCount(), 2 * SCAN_MORSEL_PAGES);
+  const Schema *schema = table_info->GetSchema();
+  auto col_a = MakeColumnValueExpression(*schema, 0, "id");
+  auto col_b = MakeColumnValueExpression(*schema, 0, "name");
+  auto const100 = MakeConstantValueExpression(Field(kTypeInt, 100));
+  auto predicate = MakeComparisonExpression(col_a, const100, ">=");
+  auto out_schema = MakeOutputSchema({{"id", col_a}, {"name", col_b}});
+  auto plan = make_shared<SeqScanPlanNode>(out_schema, table_info->GetTableName(), predicate);
+  plan->parallelism_ = 4;
+  std::vector<Row> result_set{};
+  GetExecutionEngine()->ExecutePlan(plan, &result_set, GetTxn(), GetExecutorContext());
+  // every row comes out exactly once, in any order
+  ASSERT_EQ(row_nums - 100, result_set.size());
+  std::vector<bool> seen(row_nums, false);
+  for (const auto &row : result_set) {
+    int32_t id;
+    row.GetField(0)->SerializeTo(reinterpret_cast<char *>(&id));
+    ASSERT_GE(id, 100);
+    ASSERT_FALSE(seen[id]);
+    seen[id] = true;
+    Row stored(row.GetRowId());
+    ASSERT_TRUE(table_info->GetTableHeap()->GetTuple(&stored, nullptr));
+    ASSERT_EQ(CmpBool::kTrue, stored.GetField(1)->CompareEquals(*row.GetField(1)));
+  }
+  ASSERT_TRUE(GetExecutorContext()->GetBufferPoolManager()->CheckAllUnpinned());
+}
@@ -1,5 +1,7 @@
 #include "index/b_plus_tree_index.h"
 
+#include <algorithm>
+#include <random>
 #include <string>
 
 #include "common/instance.h"
@@ -27,6 +29,58 @@ TEST(BPlusTreeTests, BPlusTreeIndexGenericKeyTest) {
   ASSERT_EQ(0, KP.CompareKeys(k1, k2));
 }
 
+TEST(BPlusTreeTests, BPlusTreeIndexKeyOrderTest) {
+  // the memcmp of encoded keys orders them as their fields, a null first, and decoding gives the fields back
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, true, false),
+                                   new Column("account", TypeId::kTypeFloat, 1, true, false),
+                                   new Column("name", TypeId::kTypeChar, 8, 2, true, false)};
+  TableSchema key_schema(columns);
+  KeyManager KP(&key_schema, 64);
+  std::vector<std::vector<Field>> values = {
+      {Field(TypeId::kTypeInt), Field(TypeId::kTypeInt, INT32_MIN), Field(TypeId::kTypeInt, -1),
+       Field(TypeId::kTypeInt, 0), Field(TypeId::kTypeInt, 7), Field(TypeId::kTypeInt, INT32_MAX)},
+      {Field(TypeId::kTypeFloat), Field(TypeId::kTypeFloat, -1e30f), Field(TypeId::kTypeFloat, -2.5f),
+       Field(TypeId::kTypeFloat, -0.0f), Field(TypeId::kTypeFloat, 0.0f), Field(TypeId::kTypeFloat, 1.5f)},
+      {Field(TypeId::kTypeChar), Field(TypeId::kTypeChar, const_cast<char *>(""), 0, true),
+       Field(TypeId::kTypeChar, const_cast<char *>("ab"), 2, true),
+       Field(TypeId::kTypeChar, const_cast<char *>("ab\0"), 3, true),
+       Field(TypeId::kTypeChar, const_cast<char *>("abc"), 3, true),
+       Field(TypeId::kTypeChar, const_cast<char *>("zzzzzzzz"), 8, true)},
+  };
+  auto encode = [&](uint32_t column, const Field &field) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, 0), Field(TypeId::kTypeFloat, 0.0f),
+                              Field(TypeId::kTypeChar, const_cast<char *>(""), 0, true)};
+    fields[column] = Field(field);
+    GenericKey *key = KP.InitKey();
+    KP.SerializeFromKey(key, Row(fields), &key_schema);
+    return key;
+  };
+  for (uint32_t column = 0; column < values.size(); column++) {
+    for (auto &lhs : values[column]) {
+      GenericKey *lhs_key = encode(column, lhs);
+      Row decoded;
+      KP.DeserializeToKey(lhs_key, decoded, &key_schema);
+      ASSERT_EQ(lhs.IsNull(), decoded.GetField(column)->IsNull());
+      if (!lhs.IsNull()) {
+        ASSERT_EQ(CmpBool::kTrue, decoded.GetField(column)->CompareEquals(lhs));
+      }
+      for (auto &rhs : values[column]) {
+        GenericKey *rhs_key = encode(column, rhs);
+        int expected;
+        if (lhs.IsNull() || rhs.IsNull()) {
+          expected = rhs.IsNull() - lhs.IsNull();
+        } else {
+          expected = lhs.CompareLessThan(rhs) == CmpBool::kTrue ? -1 : lhs.CompareGreaterThan(rhs) == CmpBool::kTrue;
+        }
+        int cmp = KP.CompareKeys(lhs_key, rhs_key);
+        ASSERT_EQ(expected, (cmp > 0) - (cmp < 0));
+        free(rhs_key);
+      }
+      free(lhs_key);
+    }
+  }
+}
+
 TEST(BPlusTreeTests, BPlusTreeIndexSimpleTest) {
   auto disk_mgr_ = new DiskManager(db_name);
   auto bpm_ = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
@@ -79,4 +133,138 @@ TEST(BPlusTreeTests, BPlusTreeIndexSimpleTest) {
   delete index;
   delete bpm_;
   delete disk_mgr_;
-}
\ No newline at end of file
+}
+TEST(BPlusTreeTests, BPlusTreeIndexKeyFilterTest) {
+  auto disk_mgr_ = new DiskManager(db_name);
+  auto bpm_ = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+  page_id_t id;
+  if (bpm_->IsPageFree(CATALOG_META_PAGE_ID)) {
+    ASSERT_TRUE(bpm_->NewPage(id) != nullptr && id == CATALOG_META_PAGE_ID);
+  }
+  if (bpm_->IsPageFree(INDEX_ROOTS_PAGE_ID)) {
+    ASSERT_TRUE(bpm_->NewPage(id) != nullptr && id == INDEX_ROOTS_PAGE_ID);
+  }
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false)};
+  std::vector<uint32_t> index_key_map{0, 1};
+  const TableSchema table_schema(columns);
+  auto *index_schema = Schema::ShallowCopySchema(&table_schema, index_key_map);
+  auto make_key = [](int i) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i),
+                              Field(TypeId::kTypeChar, const_cast<char *>("minisql"), 7, true)};
+    return Row(fields);
+  };
+  // more keys than the filter is first sized for, so it is rebuilt while growing
+  const int n = 3 * INDEX_FILTER_MIN_KEYS;
+  auto *index = new BPlusTreeIndex(1, index_schema, 256, bpm_);
+  for (int i = 0; i < n; i++) {
+    ASSERT_EQ(DB_SUCCESS, index->InsertEntry(make_key(2 * i), RowId(1000, i), nullptr));
+  }
+  int false_positives = 0;
+  for (int i = 0; i < n; i++) {
+    ASSERT_TRUE(index->MayContain(make_key(2 * i)));
+    false_positives += index->MayContain(make_key(2 * i + 1));
+  }
+  ASSERT_LT(false_positives, n / 20);
+  // a key with a null field is never ruled out
+  std::vector<Field> null_fields{Field(TypeId::kTypeInt, 1), Field(TypeId::kTypeChar, nullptr, 0, true)};
+  ASSERT_TRUE(index->MayContain(Row(null_fields)));
+  // removed keys leave the filter
+  int removed_hits = 0;
+  for (int i = 0; i < n; i += 2) {
+    ASSERT_EQ(DB_SUCCESS, index->RemoveEntry(make_key(2 * i), RowId(1000, i), nullptr));
+  }
+  for (int i = 0; i < n; i++) {
+    if (i % 2 == 1) {
+      ASSERT_TRUE(index->MayContain(make_key(2 * i)));
+    } else {
+      removed_hits += index->MayContain(make_key(2 * i));
+    }
+  }
+  ASSERT_LT(removed_hits, n / 20);
+  // the filter of an index opened again is rebuilt from its tree
+  auto *reopened = new BPlusTreeIndex(1, index_schema, 256, bpm_);
+  for (int i = 1; i < n; i += 2) {
+    ASSERT_TRUE(reopened->MayContain(make_key(2 * i)));
+  }
+  delete reopened;
+  index->Destroy();
+  delete index;
+  delete bpm_;
+  delete disk_mgr_;
+}
+
+TEST(BPlusTreeTests, BPlusTreeIndexIntegerKeyTest) {
+  auto disk_mgr_ = new DiskManager(db_name);
+  auto bpm_ = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+  page_id_t id;
+  if (bpm_->IsPageFree(CATALOG_META_PAGE_ID)) {
+    ASSERT_TRUE(bpm_->NewPage(id) != nullptr && id == CATALOG_META_PAGE_ID);
+  }
+  if (bpm_->IsPageFree(INDEX_ROOTS_PAGE_ID)) {
+    ASSERT_TRUE(bpm_->NewPage(id) != nullptr && id == INDEX_ROOTS_PAGE_ID);
+  }
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("score", TypeId::kTypeInt, 1, true, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 2, true, false)};
+  const TableSchema table_schema(columns);
+  // a single int column is keyed by an integer of 4 bytes, or 8 with room for a null
+  auto *id_schema = Schema::ShallowCopySchema(&table_schema, {0});
+  auto *score_schema = Schema::ShallowCopySchema(&table_schema, {1});
+  auto *pair_schema = Schema::ShallowCopySchema(&table_schema, {0, 1});
+  ASSERT_EQ(KeyManager::KeyKind::kInt32, KeyManager::GetKeyKind(id_schema));
+  ASSERT_EQ(4, KeyManager::GetEncodedSize(id_schema));
+  ASSERT_EQ(KeyManager::KeyKind::kInt64, KeyManager::GetKeyKind(score_schema));
+  ASSERT_EQ(8, KeyManager::GetEncodedSize(score_schema));
+  ASSERT_EQ(KeyManager::KeyKind::kBytes, KeyManager::GetKeyKind(pair_schema));
+
+  // enough keys in a random order for a tree of several levels
+  const int n = 5000;
+  std::vector<int> keys(n);
+  for (int i = 0; i < n; i++) {
+    keys[i] = 2 * i - n;
+  }
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(17));
+  auto make_key = [](int i) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    return Row(fields);
+  };
+  auto *index = new BPlusTreeIndex(2, score_schema, KeyManager::GetEncodedSize(score_schema), bpm_);
+  for (int key : keys) {
+    ASSERT_EQ(DB_SUCCESS, index->InsertEntry(make_key(key), RowId(1000, key + n), nullptr));
+  }
+  std::vector<Field> null_fields{Field(TypeId::kTypeInt)};
+  ASSERT_EQ(DB_SUCCESS, index->InsertEntry(Row(null_fields), RowId(999, 0), nullptr));
+  std::vector<RowId> ret;
+  for (int key : keys) {
+    ret.clear();
+    ASSERT_EQ(DB_SUCCESS, index->ScanKey(make_key(key), ret, nullptr));
+    ASSERT_EQ(1, ret.size());
+    ASSERT_EQ(key + n, ret[0].GetSlotNum());
+    ret.clear();
+    ASSERT_EQ(DB_KEY_NOT_FOUND, index->ScanKey(make_key(key + 1), ret, nullptr));
+  }
+  // range scans end at the last leaf, past the greatest key as well
+  ret.clear();
+  ASSERT_EQ(DB_SUCCESS, index->ScanKey(make_key(n - 11), ret, nullptr, ">="));
+  ASSERT_EQ(5, ret.size());
+  ret.clear();
+  ASSERT_EQ(DB_KEY_NOT_FOUND, index->ScanKey(make_key(n), ret, nullptr, ">"));
+  ret.clear();
+  ASSERT_EQ(DB_SUCCESS, index->ScanKey(make_key(-n + 4), ret, nullptr, "<"));
+  ASSERT_EQ(2, ret.size());
+  // the iterator goes through the null first, then the keys in order
+  IndexIterator iter = index->GetBeginIterator();
+  ASSERT_EQ(999, (*iter).second.GetPageId());
+  ++iter;
+  int count = 0;
+  for (; iter != index->GetEndIterator(); ++iter) {
+    ASSERT_EQ(2 * count, (*iter).second.GetSlotNum());
+    count++;
+  }
+  ASSERT_EQ(n, count);
+  index->Destroy();
+  delete index;
+  delete bpm_;
+  delete disk_mgr_;
+}
@@ -4,7 +4,9 @@
 #include "gtest/gtest.h"
 #include "page/table_page.h"
 #include "record/field.h"
+#include "record/field_kernels.h"
 #include "record/row.h"
+#include "record/row_view.h"
 #include "record/schema.h"
 
 char *chars[] = {const_cast<char *>(""), const_cast<char *>("hello"), const_cast<char *>("world!"),
@@ -93,11 +95,328 @@ TEST(TupleTest, RowTest) {
   ASSERT_EQ(row.GetRowId(), first_tuple_rid);
   Row row2(row.GetRowId());
   ASSERT_TRUE(table_page.GetTuple(&row2, schema.get(), nullptr, nullptr));
-  std::vector<Field *> &row2_fields = row2.GetFields();
+  auto &row2_fields = row2.GetFields();
   ASSERT_EQ(3, row2_fields.size());
   for (size_t i = 0; i < row2_fields.size(); i++) {
-    ASSERT_EQ(CmpBool::kTrue, row2_fields[i]->CompareEquals(fields[i]));
+    ASSERT_EQ(CmpBool::kTrue, row2_fields[i].CompareEquals(fields[i]));
   }
   ASSERT_TRUE(table_page.MarkDelete(row.GetRowId(), nullptr, nullptr, nullptr));
   table_page.ApplyDelete(row.GetRowId(), nullptr, nullptr);
-}
\ No newline at end of file
+}
+TEST(TupleTest, InlineFieldTest) {
+  // short chars are held inside the field, long ones on the heap
+  std::string long_name(2 * FIELD_INLINE_LEN, 'x');
+  Field short_field(TypeId::kTypeChar, const_cast<char *>("minisql"), strlen("minisql"), true);
+  Field long_field(TypeId::kTypeChar, const_cast<char *>(long_name.data()), long_name.size(), true);
+  ASSERT_GE(short_field.GetData(), reinterpret_cast<const char *>(&short_field));
+  ASSERT_LT(short_field.GetData(), reinterpret_cast<const char *>(&short_field + 1));
+  Field short_copy(short_field);
+  ASSERT_NE(short_field.GetData(), short_copy.GetData());
+  ASSERT_EQ(CmpBool::kTrue, short_copy.CompareEquals(short_field));
+  // a move hands the heap chars over
+  const char *long_data = long_field.GetData();
+  Field long_moved(std::move(long_field));
+  ASSERT_EQ(long_data, long_moved.GetData());
+  ASSERT_TRUE(long_field.IsNull());
+  ASSERT_EQ(long_name, long_moved.toString());
+
+  std::vector<Field> fields;
+  for (int32_t i = 0; i < static_cast<int32_t>(2 * ROW_INLINE_FIELDS); i++) {
+    fields.emplace_back(TypeId::kTypeInt, i);
+  }
+  fields.emplace_back(TypeId::kTypeChar, const_cast<char *>(long_name.data()), long_name.size(), false);
+  Row row(fields);
+  ASSERT_EQ(fields.size(), row.GetFieldCount());
+  ASSERT_FALSE(row.GetFields().IsInline());
+  // the moved row takes the fields of a row grown past its inline capacity without copying them
+  const Field *first = row.GetField(0);
+  Row moved(std::move(row));
+  ASSERT_EQ(0, row.GetFieldCount());
+  ASSERT_EQ(first, moved.GetField(0));
+  Row assigned;
+  assigned = std::move(moved);
+  ASSERT_EQ(first, assigned.GetField(0));
+  for (uint32_t i = 0; i < fields.size(); i++) {
+    ASSERT_EQ(CmpBool::kTrue, assigned.GetField(i)->CompareEquals(fields[i]));
+  }
+  // a copy owns its chars even when the source only points to them
+  Row copy(assigned);
+  ASSERT_NE(long_name.data(), copy.GetField(fields.size() - 1)->GetData());
+  ASSERT_EQ(long_name, copy.GetField(fields.size() - 1)->toString());
+  // a row of a few fields keeps them inline
+  std::vector<Field> few = {Field(TypeId::kTypeInt, 1), Field(TypeId::kTypeFloat, 2.0f)};
+  Row small(few);
+  ASSERT_TRUE(small.GetFields().IsInline());
+  Row small_moved(std::move(small));
+  ASSERT_EQ(2, small_moved.GetFieldCount());
+  ASSERT_EQ(CmpBool::kTrue, small_moved.GetField(1)->CompareEquals(few[1]));
+}
+
+TEST(TupleTest, CompareKernelTest) {
+  // the kernels selected per type agree with the comparisons through Type, nulls and prefixes included
+  std::string prefix(2 * FIELD_INLINE_LEN, 'x');
+  std::string longer = prefix + "y";
+  std::vector<std::vector<Field>> typed = {
+      {int_fields, int_fields + 5},
+      {float_fields, float_fields + 4},
+      {char_fields, char_fields + 4},
+  };
+  typed[0].push_back(null_fields[0]);
+  typed[1].push_back(null_fields[1]);
+  typed[2].push_back(null_fields[2]);
+  typed[2].emplace_back(TypeId::kTypeChar, const_cast<char *>("hell"), 4, true);
+  typed[2].emplace_back(TypeId::kTypeChar, const_cast<char *>(prefix.data()), prefix.size(), true);
+  typed[2].emplace_back(TypeId::kTypeChar, const_cast<char *>(longer.data()), longer.size(), true);
+  CmpOp ops[] = {CmpOp::kEqual,          CmpOp::kNotEqual,    CmpOp::kLessThan,
+                 CmpOp::kLessThanEquals, CmpOp::kGreaterThan, CmpOp::kGreaterThanEquals};
+  for (auto &fields : typed) {
+    for (auto op : ops) {
+      FieldCompareFn kernel = GetCompareKernel(fields[0].GetTypeId(), op);
+      ASSERT_NE(nullptr, kernel);
+      for (auto &lhs : fields) {
+        for (auto &rhs : fields) {
+          ASSERT_EQ(CompareFields(lhs, rhs, op), kernel(lhs, rhs));
+        }
+      }
+    }
+  }
+  ASSERT_EQ(nullptr, GetCompareKernel(TypeId::kTypeInt, CmpOp::kIsNull));
+  ASSERT_EQ(nullptr, GetCompareKernel(TypeId::kTypeInvalid, CmpOp::kEqual));
+  ASSERT_EQ(CmpOp::kGreaterThanEquals, ParseCmpOp(">="));
+  ASSERT_THROW(ParseCmpOp("like"), std::logic_error);
+}
+
+TEST(TupleTest, SlotReuseTest) {
+  TablePage table_page;
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  table_page.Init(0, INVALID_PAGE_ID, nullptr, nullptr);
+  // fill the page, every row must land in a fresh slot
+  std::vector<RowId> rids;
+  for (int i = 0;; i++) {
+    std::vector<Field> fields = {Field(TypeId::kTypeInt, i)};
+    Row row(fields);
+    if (!table_page.InsertTuple(row, schema.get(), nullptr, nullptr, nullptr)) {
+      break;
+    }
+    ASSERT_EQ(rids.size(), row.GetRowId().GetSlotNum());
+    rids.push_back(row.GetRowId());
+  }
+  ASSERT_LE(rids.size(), TablePage::MAX_SLOT_COUNT);
+  // free every other slot, except the ones at 64 and 65 which are only marked
+  for (size_t i = 0; i < rids.size(); i += 2) {
+    ASSERT_TRUE(table_page.MarkDelete(rids[i], nullptr, nullptr, nullptr));
+    if (i != 64) {
+      table_page.ApplyDelete(rids[i], nullptr, nullptr);
+    }
+  }
+  ASSERT_TRUE(table_page.MarkDelete(rids[65], nullptr, nullptr, nullptr));
+  // iteration skips deleted slots
+  RowId rid;
+  ASSERT_TRUE(table_page.GetFirstTupleRid(&rid));
+  ASSERT_EQ(1, rid.GetSlotNum());
+  ASSERT_TRUE(table_page.GetNextTupleRid(rid, &rid));
+  ASSERT_EQ(3, rid.GetSlotNum());
+  RowId next;
+  ASSERT_TRUE(table_page.GetNextTupleRid(RowId(0, 63), &next));
+  ASSERT_EQ(67, next.GetSlotNum());
+  table_page.RollbackDelete(rids[65], nullptr, nullptr);
+  ASSERT_TRUE(table_page.GetNextTupleRid(RowId(0, 63), &next));
+  ASSERT_EQ(65, next.GetSlotNum());
+  // freed slots are reused lowest first, the marked one is not
+  for (size_t i = 0; i < rids.size(); i += 2) {
+    if (i == 64) {
+      continue;
+    }
+    std::vector<Field> fields = {Field(TypeId::kTypeInt, static_cast<int32_t>(i))};
+    Row row(fields);
+    ASSERT_TRUE(table_page.InsertTuple(row, schema.get(), nullptr, nullptr, nullptr));
+    ASSERT_EQ(i, row.GetRowId().GetSlotNum());
+  }
+}
+
+TEST(TupleTest, RowViewTest) {
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, true, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false),
+                                   new Column("account", TypeId::kTypeFloat, 2, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  std::vector<Field> fields = {Field(TypeId::kTypeInt),
+                               Field(TypeId::kTypeChar, const_cast<char *>("minisql"), strlen("minisql"), false),
+                               Field(TypeId::kTypeFloat, 19.99f)};
+  Row row(fields);
+  row.SetRowId(RowId(3, 7));
+  char buffer[PAGE_SIZE];
+  schema->GetRowFormat().SerializeTo(row, buffer);
+  RowView view(schema.get());
+  view.Reset(buffer, row.GetRowId());
+  ASSERT_EQ(RowId(3, 7), view.GetRowId());
+  ASSERT_EQ(3, view.GetFieldCount());
+  ASSERT_TRUE(view.IsNull(0));
+  ASSERT_FALSE(view.IsNull(1));
+  ASSERT_EQ(strlen("minisql"), view.GetCharLength(1));
+  ASSERT_EQ(0, strncmp("minisql", view.GetChars(1), view.GetCharLength(1)));
+  ASSERT_FLOAT_EQ(19.99f, view.GetFloat(2));
+  ASSERT_TRUE(view.GetField(0).IsNull());
+  ASSERT_EQ(CmpBool::kTrue, view.GetField(1).CompareEquals(fields[1]));
+  ASSERT_EQ(CmpBool::kTrue, view.GetField(2).CompareEquals(fields[2]));
+  Row row2;
+  view.Materialize(&row2);
+  ASSERT_EQ(RowId(3, 7), row2.GetRowId());
+  ASSERT_EQ(3, row2.GetFieldCount());
+  ASSERT_TRUE(row2.GetField(0)->IsNull());
+  ASSERT_EQ(CmpBool::kTrue, row2.GetField(1)->CompareEquals(fields[1]));
+  ASSERT_EQ(CmpBool::kTrue, row2.GetField(2)->CompareEquals(fields[2]));
+}
+
+TEST(TupleTest, RowFormatTest) {
+  std::vector<Column *> columns = {new Column("name", TypeId::kTypeChar, 64, 0, true, false),
+                                   new Column("id", TypeId::kTypeInt, 1, false, false),
+                                   new Column("note", TypeId::kTypeChar, 16, 2, true, false),
+                                   new Column("account", TypeId::kTypeFloat, 3, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  const RowFormat &format = schema->GetRowFormat();
+  std::vector<Field> fields = {Field(TypeId::kTypeChar, const_cast<char *>("minisql"), strlen("minisql"), false),
+                               Field(TypeId::kTypeInt, 42), Field(TypeId::kTypeChar),
+                               Field(TypeId::kTypeFloat, 19.99f)};
+  Row row(fields);
+  row.SetRowId(RowId(3, 7));
+  // version, one bitmap byte, two fixed fields, two end offsets and the chars, without the row id and field count
+  uint32_t size = format.GetSerializedSize(row);
+  ASSERT_EQ(1 + 1 + 2 * 4 + 2 * sizeof(uint16_t) + strlen("minisql"), size);
+  ASSERT_LT(size, row.GetSerializedSize(schema.get()));
+  char buffer[PAGE_SIZE];
+  ASSERT_EQ(size, format.SerializeTo(row, buffer));
+  // every field is reached without decoding the ones before it
+  ASSERT_TRUE(format.IsNull(buffer, 2));
+  ASSERT_EQ(0, format.GetVarLength(buffer, 2));
+  ASSERT_EQ(42, MACH_READ_FROM(int32_t, format.GetData(buffer, 1)));
+  ASSERT_FLOAT_EQ(19.99f, MACH_READ_FROM(float, format.GetData(buffer, 3)));
+  ASSERT_EQ(strlen("minisql"), format.GetVarLength(buffer, 0));
+  ASSERT_EQ(0, strncmp("minisql", format.GetData(buffer, 0), strlen("minisql")));
+  ASSERT_FALSE(format.IsOverflow(buffer, 0));
+  Row row2(RowId(3, 7));
+  ASSERT_EQ(size, format.DeserializeFrom(buffer, &row2));
+  ASSERT_EQ(RowId(3, 7), row2.GetRowId());
+  ASSERT_EQ(4, row2.GetFieldCount());
+  for (uint32_t i = 0; i < fields.size(); i++) {
+    if (fields[i].IsNull()) {
+      ASSERT_TRUE(row2.GetField(i)->IsNull());
+    } else {
+      ASSERT_EQ(CmpBool::kTrue, row2.GetField(i)->CompareEquals(fields[i]));
+    }
+  }
+}
+
+TEST(TupleTest, ArenaTest) {
+  Arena arena(1024);
+  auto word = static_cast<char *>(arena.Allocate(1, 1));
+  auto number = static_cast<char *>(arena.Allocate(sizeof(double), alignof(double)));
+  ASSERT_EQ(0, reinterpret_cast<uintptr_t>(number) % alignof(double));
+  // a large request takes a block of its own and leaves the current block to the small ones
+  char *large = static_cast<char *>(arena.Allocate(4096, 1));
+  memset(large, 'x', 4096);
+  ASSERT_EQ(number + sizeof(double), arena.Allocate(1, 1));
+  arena.Reset();
+  ASSERT_EQ(0, arena.GetAllocatedBytes());
+  ASSERT_EQ(word, arena.Allocate(1, 1));
+  arena.Reset();
+
+  std::vector<Column *> columns = {new Column("name", TypeId::kTypeChar, 64, 0, true, false),
+                                   new Column("id", TypeId::kTypeInt, 1, false, false),
+                                   new Column("note", TypeId::kTypeChar, 16, 2, true, false),
+                                   new Column("account", TypeId::kTypeFloat, 3, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  // chars short enough to be held inline never reach the arena
+  std::string name(FIELD_INLINE_LEN + 1, 'm');
+  std::vector<Field> fields = {Field(TypeId::kTypeChar, const_cast<char *>(name.data()), name.size(), false),
+                               Field(TypeId::kTypeInt, 42), Field(TypeId::kTypeChar),
+                               Field(TypeId::kTypeFloat, 19.99f)};
+  Row row(fields);
+  char buffer[PAGE_SIZE];
+  schema->GetRowFormat().SerializeTo(row, buffer);
+  row.SerializeTo(buffer + PAGE_SIZE / 2, schema.get());
+  {
+    // rows of either format are read into the arena, their copies follow them there
+    Row row2;
+    row2.SetArena(&arena);
+    schema->GetRowFormat().DeserializeFrom(buffer, &row2);
+    Row row3;
+    row3.SetArena(&arena);
+    row3.DeserializeFrom(buffer + PAGE_SIZE / 2, schema.get());
+    Row row4(row2);
+    ASSERT_EQ(&arena, row4.GetArena());
+    size_t allocated = arena.GetAllocatedBytes();
+    ASSERT_GT(allocated, 0);
+    // a heap copy owns its chars, the arena may then be reset
+    Row heap_row;
+    heap_row = row3;
+    ASSERT_EQ(allocated, arena.GetAllocatedBytes());
+    for (const Row *copy : {&row2, &row3, &row4, &heap_row}) {
+      ASSERT_EQ(4, copy->GetFieldCount());
+      for (uint32_t i = 0; i < fields.size(); i++) {
+        if (fields[i].IsNull()) {
+          ASSERT_TRUE(copy->GetField(i)->IsNull());
+        } else {
+          ASSERT_EQ(CmpBool::kTrue, copy->GetField(i)->CompareEquals(fields[i]));
+        }
+      }
+    }
+    std::string note(FIELD_INLINE_LEN + 1, 'a');
+    row2.SetField(0, Field(TypeId::kTypeChar, const_cast<char *>(note.data()), note.size(), false));
+    ASSERT_EQ(note, row2.GetField(0)->toString());
+    ASSERT_GT(arena.GetAllocatedBytes(), allocated);
+    row2.SetField(0, Field(TypeId::kTypeChar, const_cast<char *>("minisql"), strlen("minisql"), false));
+    ASSERT_EQ("minisql", row2.GetField(0)->toString());
+  }
+  arena.Reset();
+}
+
+TEST(TupleTest, UpdateTupleTest) {
+  TablePage table_page;
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 16, 1, true, false),
+                                   new Column("balance", TypeId::kTypeFloat, 2, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  table_page.Init(0, INVALID_PAGE_ID, nullptr, nullptr);
+  const std::vector<std::string> names = {"alice", "bob", "carol"};
+  std::vector<RowId> rids;
+  for (int i = 0; i < 3; i++) {
+    std::vector<Field> fields = {Field(TypeId::kTypeInt, i),
+                                 Field(TypeId::kTypeChar, const_cast<char *>(names[i].data()), names[i].size(), false),
+                                 Field(TypeId::kTypeFloat, 1.f)};
+    Row row(fields);
+    ASSERT_TRUE(table_page.InsertTuple(row, schema.get(), nullptr, nullptr, nullptr));
+    rids.push_back(row.GetRowId());
+  }
+  auto update = [&](int i, const std::string &name, float balance) {
+    std::vector<Field> fields = {Field(TypeId::kTypeInt, i),
+                                 Field(TypeId::kTypeChar, const_cast<char *>(name.data()), name.size(), false),
+                                 Field(TypeId::kTypeFloat, balance)};
+    Row row(fields);
+    Row old_row(rids[i]);
+    return table_page.UpdateTuple(row, &old_row, schema.get(), nullptr, nullptr, nullptr);
+  };
+  auto check = [&](int i, const std::string &name, float balance) {
+    Row row(rids[i]);
+    ASSERT_TRUE(table_page.GetTuple(&row, schema.get(), nullptr, nullptr));
+    ASSERT_EQ(name, std::string(row.GetField(1)->GetData(), row.GetField(1)->GetLength()));
+    ASSERT_EQ(CmpBool::kTrue, row.GetField(2)->CompareEquals(Field(TypeId::kTypeFloat, balance)));
+  };
+  // a tuple of the same size is overwritten where it is
+  uint32_t data_size = table_page.GetTupleDataSize();
+  const char *tuple = table_page.GetTupleData(rids[1].GetSlotNum());
+  ASSERT_TRUE(update(1, "BOB", 42.f));
+  ASSERT_EQ(tuple, table_page.GetTupleData(rids[1].GetSlotNum()));
+  ASSERT_EQ(data_size, table_page.GetTupleDataSize());
+  // growing and shrinking the middle tuple shifts the one stored below it
+  ASSERT_TRUE(update(1, "robert-the-third", 7.f));
+  ASSERT_EQ(data_size + strlen("robert-the-third") - strlen("bob"), table_page.GetTupleDataSize());
+  check(0, names[0], 1.f);
+  check(1, "robert-the-third", 7.f);
+  check(2, names[2], 1.f);
+  ASSERT_TRUE(update(1, "b", 8.f));
+  ASSERT_EQ(data_size - strlen("bob") + 1, table_page.GetTupleDataSize());
+  check(0, names[0], 1.f);
+  check(1, "b", 8.f);
+  check(2, names[2], 1.f);
+}
@@ -6,6 +6,7 @@
 #include "common/instance.h"
 #include "gtest/gtest.h"
 #include "record/field.h"
+#include "record/row_view.h"
 #include "record/schema.h"
 #include "utils/utils.h"
 
@@ -61,3 +62,727 @@ TEST(TableHeapTest, TableHeapSampleTest) {
   }
   ASSERT_EQ(size, 0);
 }
+
+TEST(TableHeapTest, FreeSpaceMapTest) {
+  remove(db_file_name.c_str());
+  auto disk_mgr_ = new DiskManager(db_file_name);
+  auto bpm_ = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableHeap *table_heap = TableHeap::Create(bpm_, schema.get(), nullptr, nullptr, nullptr);
+  char characters[64];
+  memset(characters, 'a', sizeof(characters));
+  std::vector<RowId> rids;
+  for (int i = 0; i < 1000; i++) {
+    Fields fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, characters, 64, true)};
+    Row row(fields);
+    ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+    rids.push_back(row.GetRowId());
+  }
+  uint32_t page_count = table_heap->GetPageCount();
+  ASSERT_GT(page_count, 1);
+  // empty the first page, once the last page is full the inserts should go back to it instead of growing the heap
+  uint32_t freed = 0;
+  for (auto rid : rids) {
+    if (rid.GetPageId() == table_heap->GetFirstPageId()) {
+      table_heap->ApplyDelete(rid, nullptr);
+      freed++;
+    }
+  }
+  bool reused = false;
+  Fields fields{Field(TypeId::kTypeInt, 1000), Field(TypeId::kTypeChar, characters, 64, true)};
+  for (uint32_t i = 0; i < freed; i++) {
+    Row row(fields);
+    ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+    reused = reused || row.GetRowId().GetPageId() == table_heap->GetFirstPageId();
+  }
+  ASSERT_TRUE(reused);
+  ASSERT_EQ(page_count, table_heap->GetPageCount());
+  ASSERT_TRUE(bpm_->CheckAllUnpinned());
+  // reopen the heap from its persisted free space map
+  TableHeap *reopened =
+      TableHeap::Create(bpm_, table_heap->GetFirstPageId(), table_heap->GetFsmPageId(), schema.get(), nullptr, nullptr);
+  ASSERT_EQ(page_count, reopened->GetPageCount());
+  Row last_row(fields);
+  ASSERT_TRUE(reopened->InsertTuple(last_row, nullptr));
+  ASSERT_EQ(table_heap->GetFirstPageId(), last_row.GetRowId().GetPageId());
+  ASSERT_EQ(page_count, reopened->GetPageCount());
+  delete reopened;
+  delete table_heap;
+  delete bpm_;
+  delete disk_mgr_;
+}
+
+TEST(TableHeapTest, BatchInsertTest) {
+  remove(db_file_name.c_str());
+  auto disk_mgr_ = new DiskManager(db_file_name);
+  auto bpm_ = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+  const int row_nums = 5000;
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableHeap *table_heap = TableHeap::Create(bpm_, schema.get(), nullptr, nullptr, nullptr);
+  std::vector<Row> rows;
+  std::vector<std::string> names;
+  for (int i = 0; i < row_nums; i++) {
+    int32_t len = RandomUtils::RandomInt(1, 64);
+    std::string name(len, 0);
+    RandomUtils::RandomString(&name[0], len);
+    Fields fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, &name[0], len, true)};
+    rows.emplace_back(fields);
+    names.push_back(name);
+  }
+  auto rids = table_heap->InsertTuples(rows, nullptr);
+  ASSERT_EQ(row_nums, rids.size());
+  ASSERT_TRUE(bpm_->CheckAllUnpinned());
+  for (int i = 0; i < row_nums; i++) {
+    ASSERT_EQ(rows[i].GetRowId(), rids[i]);
+    Row row(rids[i]);
+    ASSERT_TRUE(table_heap->GetTuple(&row, nullptr));
+    ASSERT_EQ(CmpBool::kTrue, row.GetField(0)->CompareEquals(Field(TypeId::kTypeInt, i)));
+    ASSERT_EQ(CmpBool::kTrue, row.GetField(1)->CompareEquals(
+                                  Field(TypeId::kTypeChar, &names[i][0], names[i].size(), false)));
+  }
+  // the batch continues on the page where single-row inserts left off
+  Fields fields{Field(TypeId::kTypeInt, row_nums), Field(TypeId::kTypeChar, &names[0][0], names[0].size(), true)};
+  Row single(fields);
+  ASSERT_TRUE(table_heap->InsertTuple(single, nullptr));
+  std::vector<Row> tail{single};
+  auto tail_rids = table_heap->InsertTuples(tail, nullptr);
+  ASSERT_EQ(single.GetRowId().GetPageId(), tail_rids[0].GetPageId());
+  delete table_heap;
+  delete bpm_;
+  delete disk_mgr_;
+}
+
+TEST(TableHeapTest, IteratorTest) {
+  remove(db_file_name.c_str());
+  auto disk_mgr_ = new DiskManager(db_file_name);
+  auto bpm_ = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+  const int row_nums = 2000;
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableHeap *table_heap = TableHeap::Create(bpm_, schema.get(), nullptr, nullptr, nullptr);
+  std::string name(48, 'n');
+  std::vector<Row> rows;
+  for (int i = 0; i < row_nums; i++) {
+    Fields fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, &name[0], name.size(), true)};
+    rows.emplace_back(fields);
+  }
+  auto rids = table_heap->InsertTuples(rows, nullptr);
+  // empty the first pages entirely and leave holes in the others
+  for (int i = 0; i < row_nums; i++) {
+    if (i < row_nums / 4 || i % 3 == 0) {
+      ASSERT_TRUE(table_heap->MarkDelete(rids[i], nullptr));
+      table_heap->ApplyDelete(rids[i], nullptr);
+    }
+  }
+  std::vector<int32_t> ids;
+  for (auto it = table_heap->Begin(nullptr); it != table_heap->End(); ++it) {
+    int32_t id;
+    it->GetField(0)->SerializeTo(reinterpret_cast<char *>(&id));
+    ASSERT_EQ(rids[id], it->GetRowId());
+    ids.push_back(id);
+  }
+  std::vector<int32_t> expected;
+  for (int i = row_nums / 4; i < row_nums; i++) {
+    if (i % 3 != 0) {
+      expected.push_back(i);
+    }
+  }
+  ASSERT_EQ(expected, ids);
+  // the old iterator of a postfix increment keeps the row it was on
+  auto it = table_heap->Begin(nullptr);
+  auto old = it++;
+  ASSERT_EQ(CmpBool::kTrue, old->GetField(0)->CompareEquals(Field(TypeId::kTypeInt, expected[0])));
+  ASSERT_EQ(CmpBool::kTrue, (*it).GetField(0)->CompareEquals(Field(TypeId::kTypeInt, expected[1])));
+  auto moved = std::move(it);
+  ASSERT_EQ(rids[expected[1]], moved->GetRowId());
+  ASSERT_TRUE(bpm_->CheckAllUnpinned());
+  delete table_heap;
+  delete bpm_;
+  delete disk_mgr_;
+}
+
+TEST(TableHeapTest, ScanBatchTest) {
+  remove(db_file_name.c_str());
+  auto disk_mgr_ = new DiskManager(db_file_name);
+  auto bpm_ = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+  const int row_nums = 3000;
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableHeap *table_heap = TableHeap::Create(bpm_, schema.get(), nullptr, nullptr, nullptr);
+  char characters[64];
+  memset(characters, 'a', sizeof(characters));
+  std::vector<RowId> rids;
+  for (int i = 0; i < row_nums; i++) {
+    Fields fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, characters, i % 63 + 1, true)};
+    Row row(fields);
+    ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+    rids.push_back(row.GetRowId());
+  }
+  // delete every row of the second page, the scan has to step over it
+  page_id_t second_page_id = INVALID_PAGE_ID;
+  int deleted = 0;
+  for (auto rid : rids) {
+    if (rid.GetPageId() != table_heap->GetFirstPageId()) {
+      second_page_id = rid.GetPageId();
+      break;
+    }
+  }
+  for (auto rid : rids) {
+    if (rid.GetPageId() == second_page_id) {
+      ASSERT_TRUE(table_heap->MarkDelete(rid, nullptr));
+      deleted++;
+    }
+  }
+  ASSERT_GT(deleted, 0);
+  page_id_t cursor = table_heap->GetFirstPageId();
+  RowBatch batch;
+  std::vector<bool> seen(row_nums, false);
+  int scanned = 0;
+  uint32_t batches = 0;
+  while (table_heap->ScanBatch(cursor, batch, nullptr)) {
+    batches++;
+    for (size_t i = 0; i < batch.Size(); i++) {
+      int32_t id;
+      batch[i].GetField(0)->SerializeTo(reinterpret_cast<char *>(&id));
+      ASSERT_FALSE(seen[id]);
+      seen[id] = true;
+      ASSERT_EQ(rids[id], batch[i].GetRowId());
+      ASSERT_EQ(id % 63 + 1, batch[i].GetField(1)->GetLength());
+      scanned++;
+    }
+  }
+  ASSERT_TRUE(batch.Empty());
+  ASSERT_EQ(INVALID_PAGE_ID, cursor);
+  ASSERT_EQ(row_nums - deleted, scanned);
+  ASSERT_EQ(table_heap->GetPageCount() - 1, batches);
+  ASSERT_TRUE(bpm_->CheckAllUnpinned());
+  delete table_heap;
+  delete bpm_;
+  delete disk_mgr_;
+}
+
+TEST(TableHeapTest, PageDirectoryTest) {
+  remove(db_file_name.c_str());
+  auto disk_mgr_ = new DiskManager(db_file_name);
+  auto bpm_ = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+  const int row_nums = 4000;
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableHeap *table_heap = TableHeap::Create(bpm_, schema.get(), nullptr, nullptr, nullptr);
+  char characters[64];
+  memset(characters, 'a', sizeof(characters));
+  std::vector<RowId> rids;
+  for (int i = 0; i < row_nums; i++) {
+    Fields fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, characters, 32, true)};
+    Row row(fields);
+    ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+    rids.push_back(row.GetRowId());
+  }
+  ASSERT_EQ(row_nums, table_heap->GetTupleCount());
+  for (int i = 0; i < row_nums; i += 3) {
+    ASSERT_TRUE(table_heap->MarkDelete(rids[i], nullptr));
+  }
+  int deleted = (row_nums + 2) / 3;
+  ASSERT_EQ(row_nums - deleted, table_heap->GetTupleCount());
+  table_heap->RollbackDelete(rids[0], nullptr);
+  ASSERT_EQ(row_nums - deleted + 1, table_heap->GetTupleCount());
+  // the directory lists the pages in chain order
+  page_id_t page_id = table_heap->GetFirstPageId();
+  for (uint32_t i = 0; i < table_heap->GetPageCount(); i++) {
+    ASSERT_EQ(page_id, table_heap->GetPageId(i));
+    auto page = reinterpret_cast<TablePage *>(bpm_->FetchPage(page_id));
+    page_id_t next_page_id = page->GetNextPageId();
+    bpm_->UnpinPage(page_id, false);
+    page_id = next_page_id;
+  }
+  ASSERT_EQ(INVALID_PAGE_ID, page_id);
+  // the ranges cover every page exactly once
+  const uint32_t parts = 3;
+  uint32_t covered = 0;
+  for (uint32_t part = 0; part < parts; part++) {
+    uint32_t begin, end;
+    table_heap->GetPageRange(part, parts, begin, end);
+    ASSERT_EQ(covered, begin);
+    ASSERT_LE(begin, end);
+    covered = end;
+  }
+  ASSERT_EQ(table_heap->GetPageCount(), covered);
+  ASSERT_TRUE(bpm_->CheckAllUnpinned());
+  // reopen the heap from the persisted directory
+  TableHeap *reopened =
+      TableHeap::Create(bpm_, table_heap->GetFirstPageId(), table_heap->GetFsmPageId(), schema.get(), nullptr, nullptr);
+  ASSERT_EQ(table_heap->GetPageCount(), reopened->GetPageCount());
+  ASSERT_EQ(table_heap->GetTupleCount(), reopened->GetTupleCount());
+  for (uint32_t i = 0; i < reopened->GetPageCount(); i++) {
+    ASSERT_EQ(table_heap->GetPageId(i), reopened->GetPageId(i));
+  }
+  delete reopened;
+  delete table_heap;
+  delete bpm_;
+  delete disk_mgr_;
+}
+
+TEST(TableHeapTest, OverflowTest) {
+  remove(db_file_name.c_str());
+  auto disk_mgr_ = new DiskManager(db_file_name);
+  auto bpm_ = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+  const int row_nums = 20;
+  const uint32_t long_len = 3 * PAGE_SIZE + 100;
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("body", TypeId::kTypeChar, 4 * PAGE_SIZE, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableHeap *table_heap = TableHeap::Create(bpm_, schema.get(), nullptr, nullptr, nullptr);
+  ASSERT_NE(nullptr, table_heap->GetOverflowStore());
+  std::vector<std::string> bodies;
+  std::vector<RowId> rids;
+  for (int i = 0; i < row_nums; i++) {
+    // every other row is long enough to be moved out of line
+    std::string body(i % 2 == 0 ? long_len : 16, static_cast<char>('a' + i));
+    body[0] = static_cast<char>('A' + i);
+    Fields fields{Field(TypeId::kTypeInt, i),
+                  Field(TypeId::kTypeChar, const_cast<char *>(body.data()), body.size(), true)};
+    Row row(fields);
+    ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+    bodies.push_back(body);
+    rids.push_back(row.GetRowId());
+  }
+  // the long values do not take room in the table pages
+  ASSERT_EQ(1, table_heap->GetPageCount());
+  for (int i = 0; i < row_nums; i++) {
+    Row row(rids[i]);
+    ASSERT_TRUE(table_heap->GetTuple(&row, nullptr));
+    ASSERT_FALSE(row.GetField(1)->IsOverflow());
+    ASSERT_EQ(bodies[i], std::string(row.GetField(1)->GetData(), row.GetField(1)->GetLength()));
+  }
+  page_id_t cursor = table_heap->GetFirstPageId();
+  RowBatch batch;
+  ASSERT_TRUE(table_heap->ScanBatch(cursor, batch, nullptr));
+  ASSERT_EQ(row_nums, batch.Size());
+  for (size_t i = 0; i < batch.Size(); i++) {
+    int32_t id;
+    batch[i].GetField(0)->SerializeTo(reinterpret_cast<char *>(&id));
+    ASSERT_EQ(bodies[id], std::string(batch[i].GetField(1)->GetData(), batch[i].GetField(1)->GetLength()));
+  }
+  // replacing a long value releases the pages of the old one
+  auto chain_page = [&](const RowId &rid) {
+    auto page = reinterpret_cast<TablePage *>(bpm_->FetchPage(rid.GetPageId()));
+    const char *ref = schema->GetRowFormat().GetData(page->GetTupleData(rid.GetSlotNum(), true), 1);
+    page_id_t page_id = MACH_READ_FROM(page_id_t, ref + sizeof(uint32_t));
+    bpm_->UnpinPage(rid.GetPageId(), false);
+    return page_id;
+  };
+  page_id_t old_chain = chain_page(rids[0]);
+  std::string body(2 * PAGE_SIZE, 'z');
+  Fields fields{Field(TypeId::kTypeInt, 0),
+                Field(TypeId::kTypeChar, const_cast<char *>(body.data()), body.size(), true)};
+  Row new_row(fields);
+  ASSERT_TRUE(table_heap->UpdateTuple(new_row, rids[0], nullptr));
+  ASSERT_TRUE(bpm_->IsPageFree(old_chain));
+  Row updated(rids[0]);
+  ASSERT_TRUE(table_heap->GetTuple(&updated, nullptr));
+  ASSERT_EQ(body, std::string(updated.GetField(1)->GetData(), updated.GetField(1)->GetLength()));
+  // deleting a row releases its pages once the delete is applied
+  page_id_t deleted_chain = chain_page(rids[2]);
+  ASSERT_TRUE(table_heap->MarkDelete(rids[2], nullptr));
+  ASSERT_FALSE(bpm_->IsPageFree(deleted_chain));
+  table_heap->ApplyDelete(rids[2], nullptr);
+  ASSERT_TRUE(bpm_->IsPageFree(deleted_chain));
+  ASSERT_TRUE(bpm_->CheckAllUnpinned());
+  page_id_t kept_chain = chain_page(rids[4]);
+  table_heap->FreeTableHeap();
+  ASSERT_TRUE(bpm_->IsPageFree(kept_chain));
+  delete table_heap;
+  delete bpm_;
+  delete disk_mgr_;
+}
+
+TEST(TableHeapTest, PaxLayoutTest) {
+  remove(db_file_name.c_str());
+  auto disk_mgr_ = new DiskManager(db_file_name);
+  auto bpm_ = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+  const int row_nums = 2000;
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 32, 1, true, false),
+                                   new Column("account", TypeId::kTypeFloat, 2, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  ASSERT_LT(0, TablePage::GetMaxPaxCapacity(schema.get()));
+  TableHeap *table_heap = TableHeap::Create(bpm_, schema.get(), nullptr, nullptr, nullptr, TableLayout::kPax);
+  ASSERT_EQ(TableLayout::kPax, table_heap->GetLayout());
+  std::vector<RowId> rids;
+  std::vector<std::string> names;
+  for (int i = 0; i < row_nums; i++) {
+    std::string name(i % 32, static_cast<char>('a' + i % 26));
+    // every tenth name is null
+    Fields fields{Field(TypeId::kTypeInt, i),
+                  i % 10 == 0 ? Field(TypeId::kTypeChar)
+                              : Field(TypeId::kTypeChar, const_cast<char *>(name.data()), name.size(), true),
+                  Field(TypeId::kTypeFloat, static_cast<float>(i))};
+    Row row(fields);
+    ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+    rids.push_back(row.GetRowId());
+    names.push_back(name);
+  }
+  // a value longer than its column does not fit into the minipage
+  std::string too_long(33, 'x');
+  Fields long_fields{Field(TypeId::kTypeInt, -1),
+                     Field(TypeId::kTypeChar, const_cast<char *>(too_long.data()), too_long.size(), true),
+                     Field(TypeId::kTypeFloat, 0.f)};
+  Row long_row(long_fields);
+  ASSERT_FALSE(table_heap->InsertTuple(long_row, nullptr));
+  ASSERT_EQ(row_nums, table_heap->GetTupleCount());
+  auto check_row = [&](Row &row, int i) {
+    int32_t id;
+    row.GetField(0)->SerializeTo(reinterpret_cast<char *>(&id));
+    ASSERT_EQ(i, id);
+    if (i % 10 == 0) {
+      ASSERT_TRUE(row.GetField(1)->IsNull());
+    } else {
+      ASSERT_EQ(names[i], std::string(row.GetField(1)->GetData(), row.GetField(1)->GetLength()));
+    }
+  };
+  for (int i = 0; i < row_nums; i += 7) {
+    Row row(rids[i]);
+    ASSERT_TRUE(table_heap->GetTuple(&row, nullptr));
+    check_row(row, i);
+  }
+  // a view reads the minipages in place
+  RowView view(schema.get());
+  auto page = reinterpret_cast<TablePage *>(bpm_->FetchPage(rids[11].GetPageId()));
+  ASSERT_TRUE(page->IsPax());
+  ASSERT_EQ(nullptr, page->GetTupleData(rids[11].GetSlotNum()));
+  view.Reset(page, rids[11].GetSlotNum());
+  ASSERT_EQ(rids[11].Get(), view.GetRowId().Get());
+  ASSERT_EQ(11, view.GetInt(0));
+  ASSERT_EQ(names[11], std::string(view.GetChars(1), view.GetCharLength(1)));
+  ASSERT_FLOAT_EQ(11.f, view.GetFloat(2));
+  view.Reset(page, rids[10].GetSlotNum());
+  ASSERT_TRUE(view.IsNull(1));
+  bpm_->UnpinPage(rids[11].GetPageId(), false);
+  // updates happen in place, deletes free the slot once applied
+  std::string new_name = "updated";
+  Fields new_fields{Field(TypeId::kTypeInt, 3),
+                    Field(TypeId::kTypeChar, const_cast<char *>(new_name.data()), new_name.size(), true),
+                    Field(TypeId::kTypeFloat, 3.f)};
+  Row new_row(new_fields);
+  ASSERT_TRUE(table_heap->UpdateTuple(new_row, rids[3], nullptr));
+  Row updated(rids[3]);
+  ASSERT_TRUE(table_heap->GetTuple(&updated, nullptr));
+  ASSERT_EQ(new_name, std::string(updated.GetField(1)->GetData(), updated.GetField(1)->GetLength()));
+  names[3] = new_name;
+  for (int i = 0; i < row_nums; i += 2) {
+    ASSERT_TRUE(table_heap->MarkDelete(rids[i], nullptr));
+  }
+  table_heap->RollbackDelete(rids[0], nullptr);
+  table_heap->ApplyDelete(rids[2], nullptr);
+  // the freed slot of the first page does not take a value longer than its column either
+  ASSERT_FALSE(table_heap->InsertTuple(long_row, nullptr));
+  Row deleted(rids[4]);
+  ASSERT_FALSE(table_heap->GetTuple(&deleted, nullptr));
+  uint32_t page_count = table_heap->GetPageCount();
+  std::vector<std::pair<RowId, Row>> moved_rows;
+  ASSERT_LT(0, table_heap->Vacuum(moved_rows, nullptr));
+  ASSERT_GT(page_count, table_heap->GetPageCount());
+  ASSERT_EQ(row_nums / 2 + 1, table_heap->GetTupleCount());
+  // the layout is read back from the first page when the heap is reopened
+  TableHeap *reopened =
+      TableHeap::Create(bpm_, table_heap->GetFirstPageId(), table_heap->GetFsmPageId(), schema.get(), nullptr, nullptr);
+  ASSERT_EQ(TableLayout::kPax, reopened->GetLayout());
+  page_id_t cursor = reopened->GetFirstPageId();
+  RowBatch batch;
+  uint32_t scanned = 0;
+  while (reopened->ScanBatch(cursor, batch, nullptr)) {
+    for (size_t i = 0; i < batch.Size(); i++) {
+      int32_t id;
+      batch[i].GetField(0)->SerializeTo(reinterpret_cast<char *>(&id));
+      ASSERT_TRUE(id == 0 || id % 2 == 1);
+      check_row(batch[i], id);
+    }
+    scanned += batch.Size();
+  }
+  ASSERT_EQ(row_nums / 2 + 1, scanned);
+  ASSERT_TRUE(bpm_->CheckAllUnpinned());
+  delete reopened;
+  delete table_heap;
+  delete bpm_;
+  delete disk_mgr_;
+}
+
+TEST(TableHeapTest, DictionaryTest) {
+  remove(db_file_name.c_str());
+  auto disk_mgr_ = new DiskManager(db_file_name);
+  auto bpm_ = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+  const int row_nums = 3000;
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 32, 1, true, false)};
+  columns[1]->SetDictionary(true);
+  auto schema = std::make_shared<Schema>(columns);
+  auto plain_schema = std::make_shared<Schema>(std::vector<Column *>{
+      new Column("id", TypeId::kTypeInt, 0, false, false), new Column("name", TypeId::kTypeChar, 32, 1, true, false)});
+  ASSERT_FALSE(TableHeap::SupportsLayout(schema.get(), TableLayout::kPax));
+  TableHeap *table_heap = TableHeap::Create(bpm_, schema.get(), nullptr, nullptr, nullptr);
+  TableHeap *plain_heap = TableHeap::Create(bpm_, plain_schema.get(), nullptr, nullptr, nullptr);
+  ASSERT_NE(nullptr, table_heap->GetDictionary());
+  ASSERT_EQ(nullptr, plain_heap->GetDictionary());
+  // a handful of names repeat over the rows, every seventh is null
+  const std::vector<std::string> names = {"alice", "bob", "carol-the-accountant", "dave", "eve-from-marketing"};
+  auto make_fields = [&](int i) {
+    return Fields{Field(TypeId::kTypeInt, i),
+                  i % 7 == 0 ? Field(TypeId::kTypeChar)
+                             : Field(TypeId::kTypeChar, const_cast<char *>(names[i % names.size()].data()),
+                                     names[i % names.size()].size(), true)};
+  };
+  std::vector<Row> rows;
+  for (int i = 0; i < row_nums; i++) {
+    Fields fields = make_fields(i);
+    rows.emplace_back(fields);
+    Row plain_row(fields);
+    ASSERT_TRUE(plain_heap->InsertTuple(plain_row, nullptr));
+  }
+  std::vector<RowId> rids = table_heap->InsertTuples(rows, nullptr);
+  const Dictionary *dictionary = table_heap->GetDictionary();
+  ASSERT_EQ(names.size(), dictionary->GetValueCount(1));
+  // codes take less room than the values
+  ASSERT_LT(table_heap->GetPageCount(), plain_heap->GetPageCount());
+  // the caller keeps its values
+  ASSERT_EQ(names[1], std::string(rows[1].GetField(1)->GetData(), rows[1].GetField(1)->GetLength()));
+  auto check_row = [&](const Row &row, int i) {
+    int32_t id;
+    row.GetField(0)->SerializeTo(reinterpret_cast<char *>(&id));
+    ASSERT_EQ(i, id);
+    if (i % 7 == 0) {
+      ASSERT_TRUE(row.GetField(1)->IsNull());
+    } else {
+      ASSERT_EQ(names[i % names.size()], std::string(row.GetField(1)->GetData(), row.GetField(1)->GetLength()));
+    }
+  };
+  for (int i = 0; i < row_nums; i += 11) {
+    ASSERT_EQ(rids[i].Get(), rows[i].GetRowId().Get());
+    Row row(rids[i]);
+    ASSERT_TRUE(table_heap->GetTuple(&row, nullptr));
+    check_row(row, i);
+  }
+  // a view compares the encoded field with a value on codes
+  RowView view(schema.get(), nullptr, dictionary);
+  Field bob(TypeId::kTypeChar, const_cast<char *>("bob"), 3, false);
+  Field nobody(TypeId::kTypeChar, const_cast<char *>("nobody"), 6, false);
+  auto page = reinterpret_cast<TablePage *>(bpm_->FetchPage(rids[1].GetPageId()));
+  view.Reset(page, rids[1].GetSlotNum());
+  ASSERT_TRUE(view.IsEncoded(1));
+  ASSERT_EQ(dictionary->Lookup(1, "bob", 3), view.GetCode(1));
+  ASSERT_EQ(CmpBool::kTrue, view.CompareEncoded(1, bob));
+  ASSERT_EQ(CmpBool::kFalse, view.CompareEncoded(1, nobody));
+  ASSERT_EQ("bob", std::string(view.GetChars(1), view.GetCharLength(1)));
+  ASSERT_EQ(CmpBool::kTrue, view.GetField(1).CompareEquals(bob));
+  view.Reset(page, rids[2].GetSlotNum());
+  ASSERT_EQ(CmpBool::kFalse, view.CompareEncoded(1, bob));
+  bpm_->UnpinPage(rids[1].GetPageId(), false);
+  // a value seen for the first time on update gets the next code, and a value looked up before is found now
+  Fields new_fields{Field(TypeId::kTypeInt, 2), Field(TypeId::kTypeChar, const_cast<char *>("nobody"), 6, true)};
+  Row new_row(new_fields);
+  ASSERT_TRUE(table_heap->UpdateTuple(new_row, rids[2], nullptr));
+  ASSERT_EQ(names.size(), dictionary->Lookup(1, "nobody", 6));
+  page = reinterpret_cast<TablePage *>(bpm_->FetchPage(rids[2].GetPageId()));
+  view.Reset(page, rids[2].GetSlotNum());
+  ASSERT_EQ(CmpBool::kTrue, view.CompareEncoded(1, nobody));
+  bpm_->UnpinPage(rids[2].GetPageId(), false);
+  // the dictionary is read back when the heap is reopened
+  TableHeap *reopened = TableHeap::Create(bpm_, table_heap->GetFirstPageId(), table_heap->GetFsmPageId(),
+                                          schema.get(), nullptr, nullptr, table_heap->GetDictionaryPageId());
+  ASSERT_EQ(names.size() + 1, reopened->GetDictionary()->GetValueCount(1));
+  page_id_t cursor = reopened->GetFirstPageId();
+  RowBatch batch;
+  uint32_t scanned = 0;
+  while (reopened->ScanBatch(cursor, batch, nullptr)) {
+    for (size_t i = 0; i < batch.Size(); i++) {
+      int32_t id;
+      batch[i].GetField(0)->SerializeTo(reinterpret_cast<char *>(&id));
+      if (id == 2) {
+        ASSERT_EQ("nobody", std::string(batch[i].GetField(1)->GetData(), batch[i].GetField(1)->GetLength()));
+      } else {
+        check_row(batch[i], id);
+      }
+    }
+    scanned += batch.Size();
+  }
+  ASSERT_EQ(row_nums, scanned);
+  ASSERT_TRUE(bpm_->CheckAllUnpinned());
+  page_id_t dictionary_page_id = table_heap->GetDictionaryPageId();
+  table_heap->FreeTableHeap();
+  ASSERT_TRUE(bpm_->IsPageFree(dictionary_page_id));
+  delete reopened;
+  delete table_heap;
+  delete plain_heap;
+  delete bpm_;
+  delete disk_mgr_;
+}
+
+TEST(TableHeapTest, ForwardingTest) {
+  remove(db_file_name.c_str());
+  auto disk_mgr_ = new DiskManager(db_file_name);
+  auto bpm_ = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+  const int row_nums = 200;
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, OVERFLOW_THRESHOLD, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableHeap *table_heap = TableHeap::Create(bpm_, schema.get(), nullptr, nullptr, nullptr);
+  char characters[OVERFLOW_THRESHOLD];
+  memset(characters, 'a', sizeof(characters));
+  std::vector<RowId> rids;
+  for (int i = 0; i < row_nums; i++) {
+    Fields fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, characters, 100, true)};
+    Row row(fields);
+    ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+    rids.push_back(row.GetRowId());
+  }
+  ASSERT_GT(table_heap->GetPageCount(), 2);
+  auto name_length = [&](const RowId &rid) {
+    Row row(rid);
+    EXPECT_TRUE(table_heap->GetTuple(&row, nullptr));
+    EXPECT_EQ(rid.Get(), row.GetRowId().Get());
+    return row.GetField(1)->GetLength();
+  };
+  auto forward_rid = [&](const RowId &rid) {
+    auto page = reinterpret_cast<TablePage *>(bpm_->FetchPage(rid.GetPageId()));
+    RowId target = page->IsForwarded(rid.GetSlotNum()) ? page->GetForwardRid(rid.GetSlotNum()) : INVALID_ROWID;
+    bpm_->UnpinPage(rid.GetPageId(), false);
+    return target;
+  };
+  auto update = [&](int i, uint32_t length) {
+    Fields fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, characters, length, true)};
+    Row row(fields);
+    EXPECT_TRUE(table_heap->UpdateTuple(row, rids[i], nullptr));
+    EXPECT_EQ(rids[i].Get(), row.GetRowId().Get());
+  };
+  // a tuple outgrowing its full page is relocated and keeps its rid
+  const int moved = 5;
+  update(moved, OVERFLOW_THRESHOLD);
+  RowId target = forward_rid(rids[moved]);
+  ASSERT_NE(INVALID_PAGE_ID, target.GetPageId());
+  ASSERT_NE(rids[moved].GetPageId(), target.GetPageId());
+  ASSERT_EQ(OVERFLOW_THRESHOLD, name_length(rids[moved]));
+  ASSERT_EQ(row_nums, table_heap->GetTupleCount());
+  // scans see the tuple once, at its stub
+  page_id_t cursor = table_heap->GetFirstPageId();
+  RowBatch batch;
+  uint32_t scanned = 0;
+  while (table_heap->ScanBatch(cursor, batch, nullptr)) {
+    for (size_t i = 0; i < batch.Size(); i++) {
+      int32_t id;
+      batch[i].GetField(0)->SerializeTo(reinterpret_cast<char *>(&id));
+      ASSERT_EQ(rids[id].Get(), batch[i].GetRowId().Get());
+      ASSERT_EQ(id == moved ? OVERFLOW_THRESHOLD : 100, batch[i].GetField(1)->GetLength());
+    }
+    scanned += batch.Size();
+  }
+  ASSERT_EQ(row_nums, scanned);
+  // the relocated tuple is updated where it is, the stub still points at it
+  update(moved, OVERFLOW_THRESHOLD - 10);
+  ASSERT_EQ(target.Get(), forward_rid(rids[moved]).Get());
+  ASSERT_EQ(OVERFLOW_THRESHOLD - 10, name_length(rids[moved]));
+  // deleting a relocated tuple removes it along with its stub
+  const int deleted = 40;
+  ASSERT_NE(rids[moved].GetPageId(), rids[deleted].GetPageId());
+  update(deleted, OVERFLOW_THRESHOLD);
+  RowId deleted_target = forward_rid(rids[deleted]);
+  ASSERT_NE(INVALID_PAGE_ID, deleted_target.GetPageId());
+  ASSERT_TRUE(table_heap->MarkDelete(rids[deleted], nullptr));
+  table_heap->ApplyDelete(rids[deleted], nullptr);
+  auto page = reinterpret_cast<TablePage *>(bpm_->FetchPage(deleted_target.GetPageId()));
+  ASSERT_EQ(nullptr, page->GetTupleData(deleted_target.GetSlotNum(), true));
+  bpm_->UnpinPage(deleted_target.GetPageId(), false);
+  ASSERT_EQ(row_nums - 1, table_heap->GetTupleCount());
+  // a vacuum moves the tuple back once deletes made room in its page
+  for (int i = 0; i < row_nums; i++) {
+    if (i != moved && rids[i].GetPageId() == rids[moved].GetPageId()) {
+      ASSERT_TRUE(table_heap->MarkDelete(rids[i], nullptr));
+    }
+  }
+  std::vector<std::pair<RowId, Row>> moved_rows;
+  table_heap->Vacuum(moved_rows, nullptr);
+  ASSERT_EQ(INVALID_PAGE_ID, forward_rid(rids[moved]).GetPageId());
+  ASSERT_EQ(OVERFLOW_THRESHOLD - 10, name_length(rids[moved]));
+  ASSERT_TRUE(bpm_->CheckAllUnpinned());
+  delete table_heap;
+  delete bpm_;
+  delete disk_mgr_;
+}
+
+TEST(TableHeapTest, ZoneMapTest) {
+  remove(db_file_name.c_str());
+  auto disk_mgr_ = new DiskManager(db_file_name);
+  auto bpm_ = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 32, 1, true, false),
+                                   new Column("account", TypeId::kTypeFloat, 2, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableHeap *table_heap = TableHeap::Create(bpm_, schema.get(), nullptr, nullptr, nullptr);
+  const int row_nums = 5000;
+  char name[] = "minisql";
+  std::vector<RowId> rids;
+  for (int i = 0; i < row_nums; i++) {
+    Fields fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, name, 7, true),
+                  i % 2 == 0 ? Field(TypeId::kTypeFloat) : Field(TypeId::kTypeFloat, 1.5f)};
+    Row row(fields);
+    ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+    rids.push_back(row.GetRowId());
+  }
+  const ZoneMap &zone_map = table_heap->GetZoneMap();
+  uint32_t page_count = table_heap->GetPageCount();
+  ASSERT_GT(page_count, 2);
+  ASSERT_EQ(page_count, zone_map.GetZoneCount());
+  // ids were appended in order, so each id lands in the zone of its page only
+  auto matching_zones = [&](const std::string &comp, int32_t id) {
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < page_count; i++) {
+      count += zone_map.MayMatch(i, 0, comp, Field(TypeId::kTypeInt, id));
+    }
+    return count;
+  };
+  ASSERT_EQ(1, matching_zones("=", row_nums / 2));
+  ASSERT_EQ(0, matching_zones("=", row_nums));
+  ASSERT_EQ(0, matching_zones(">", row_nums - 1));
+  ASSERT_EQ(1, matching_zones(">=", row_nums - 1));
+  ASSERT_EQ(page_count, matching_zones("<>", 0));
+  ASSERT_EQ(0, matching_zones("<", 0));
+  // nulls are left out of the zones, a column which is not zoned always matches
+  ASSERT_FALSE(zone_map.MayMatch(0, 2, "=", Field(TypeId::kTypeFloat, 2.5f)));
+  ASSERT_TRUE(zone_map.MayMatch(0, 2, "=", Field(TypeId::kTypeFloat, 1.5f)));
+  ASSERT_TRUE(zone_map.MayMatch(0, 1, "=", Field(TypeId::kTypeChar, name, 3, false)));
+  // an update widens the zone of the page holding the tuple
+  Fields fields{Field(TypeId::kTypeInt, -1), Field(TypeId::kTypeChar, name, 7, true), Field(TypeId::kTypeFloat, 1.5f)};
+  Row row(fields);
+  ASSERT_TRUE(table_heap->UpdateTuple(row, rids[row_nums - 1], nullptr));
+  ASSERT_EQ(1, matching_zones("<", 0));
+  ASSERT_TRUE(zone_map.MayMatch(page_count - 1, 0, "=", Field(TypeId::kTypeInt, -1)));
+  // the zones are loaded back with the heap
+  TableHeap *reopened = TableHeap::Create(bpm_, table_heap->GetFirstPageId(), table_heap->GetFsmPageId(),
+                                          schema.get(), nullptr, nullptr, INVALID_PAGE_ID,
+                                          table_heap->GetZoneMapPageId());
+  ASSERT_EQ(page_count, reopened->GetZoneMap().GetZoneCount());
+  ASSERT_TRUE(reopened->GetZoneMap().MayMatch(page_count - 1, 0, "=", Field(TypeId::kTypeInt, -1)));
+  ASSERT_FALSE(reopened->GetZoneMap().MayMatch(0, 0, "=", Field(TypeId::kTypeInt, -1)));
+  delete reopened;
+  // a vacuum recomputes the zones, the updated tuple is gone with the rest of the last page
+  for (int i = 0; i < row_nums; i++) {
+    if (rids[i].GetPageId() == rids[row_nums - 1].GetPageId()) {
+      ASSERT_TRUE(table_heap->MarkDelete(rids[i], nullptr));
+    }
+  }
+  std::vector<std::pair<RowId, Row>> moved_rows;
+  table_heap->Vacuum(moved_rows, nullptr);
+  page_count = table_heap->GetPageCount();
+  ASSERT_EQ(page_count, zone_map.GetZoneCount());
+  ASSERT_EQ(0, matching_zones("<", 0));
+  ASSERT_EQ(1, matching_zones("=", 0));
+  ASSERT_TRUE(bpm_->CheckAllUnpinned());
+  delete table_heap;
+  delete bpm_;
+  delete disk_mgr_;
+}